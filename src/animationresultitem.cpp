@@ -10,20 +10,30 @@
 #include "lib/animationresult.h"
 
 #include <QFileDialog>
+#include <QImageReader>
 #include <QMovie>
 
 #include <KLocalizedString>
 
+// all decoded frames of an animation are cached up to this size, larger animations are decoded on the fly
+static const qint64 MaxMovieCacheSize = 32 * 1024 * 1024;
+
 AnimationResultItem::AnimationResultItem(QGraphicsObject* parent, Cantor::Result* result)
     : WorksheetImageItem(parent), ResultItem(result)
 {
     update();
 }
 
+AnimationResultItem::~AnimationResultItem()
+{
+    releaseCache();
+}
+
 double AnimationResultItem::setGeometry(double x, double y, double w)
 {
     Q_UNUSED(w);
     setPos(x,y);
+    updatePlayback();
 
     return m_height;
 }
@@ -39,7 +49,7 @@ void AnimationResultItem::populateMenu(QMenu* menu, QPointF)
                             this, SLOT(pauseMovie()));
         else
             menu->addAction(QIcon::fromTheme(QLatin1String("media-playback-start")), i18n("Start"),
-                            m_movie, SLOT(start()));
+                            this, SLOT(startMovie()));
         if (m_movie->state() == QMovie::Running ||
             m_movie->state() == QMovie::Paused)
             menu->addAction(QIcon::fromTheme(QLatin1String("media-playback-stop")), i18n("Stop"),
@@ -79,17 +89,90 @@ double AnimationResultItem::height() const
 
 void AnimationResultItem::setMovie(QMovie* movie)
 {
-    if (m_movie) {
-        m_movie->disconnect(this, SLOT(updateFrame()));
-        m_movie->disconnect(this, SLOT(updateSize()));
-    }
+    if (m_movie)
+        disconnect(m_movie, nullptr, this, nullptr);
+    releaseCache();
+
     m_movie = movie;
     m_height = 0;
     if (m_movie) {
         connect(m_movie, &QMovie::frameChanged, this, &AnimationResultItem::updateFrame);
         connect(m_movie, &QMovie::resized, this, &AnimationResultItem::updateSize);
+        setCacheMode();
+
+        auto* view = worksheet() ? worksheet()->worksheetView() : nullptr;
+        if (view)
+            connect(view, &WorksheetView::viewRectChanged, this, &AnimationResultItem::updatePlayback, Qt::UniqueConnection);
+
+        // the movie is only played while the item is visible
+        m_suspended = true;
+        updatePlayback();
+        if (m_movie->state() == QMovie::NotRunning)
+            m_movie->jumpToFrame(0);
+    }
+}
+
+void AnimationResultItem::setCacheMode()
+{
+    // the cache mode can only be changed before the movie was started
+    if (m_movie->state() != QMovie::NotRunning || !worksheet())
+        return;
+
+    const int frameCount = m_movie->frameCount();
+    const QSize& size = QImageReader(m_movie->fileName()).size();
+    const qint64 bytes = static_cast<qint64>(frameCount) * size.width() * size.height() * 4;
+    if (frameCount > 0 && size.isValid() && bytes <= MaxMovieCacheSize && worksheet()->reserveAnimationCache(bytes))
+    {
+        m_cacheSize = bytes;
+        m_movie->setCacheMode(QMovie::CacheAll);
+    }
+    else
+        m_movie->setCacheMode(QMovie::CacheNone);
+}
+
+void AnimationResultItem::releaseCache()
+{
+    if (m_cacheSize && worksheet())
+        worksheet()->releaseAnimationCache(m_cacheSize);
+    m_cacheSize = 0;
+}
+
+/*!
+ * pauses the movie when the item was moved out of the visible area of the worksheet
+ * and resumes it when the item gets visible again. Movies paused or stopped by the user are not touched.
+ */
+void AnimationResultItem::updatePlayback()
+{
+    if (!m_movie || m_userPaused)
+        return;
+
+    bool visible = isVisible();
+    auto* view = worksheet() ? worksheet()->worksheetView() : nullptr;
+    if (visible && view)
+    {
+        const QRectF rect(scenePos(), QSizeF(qMax(1., width()), qMax(1., height())));
+        visible = rect.intersects(view->viewRect());
+    }
+
+    if (visible && m_suspended)
+    {
+        m_suspended = false;
         m_movie->start();
     }
+    else if (!visible && !m_suspended)
+    {
+        m_suspended = true;
+        if (m_movie->state() == QMovie::Running)
+            m_movie->setPaused(true);
+    }
+}
+
+QVariant AnimationResultItem::itemChange(GraphicsItemChange change, const QVariant& value)
+{
+    if (change == QGraphicsItem::ItemVisibleHasChanged)
+        updatePlayback();
+
+    return WorksheetImageItem::itemChange(change, value);
 }
 
 void AnimationResultItem::updateFrame()
@@ -112,9 +195,19 @@ void AnimationResultItem::saveResult()
     result()->save(filename);
 }
 
+void AnimationResultItem::startMovie()
+{
+    if (m_movie) {
+        m_userPaused = false;
+        m_suspended = false;
+        m_movie->start();
+    }
+}
+
 void AnimationResultItem::stopMovie()
 {
     if (m_movie) {
+        m_userPaused = true;
         m_movie->stop();
         m_movie->jumpToFrame(0);
         worksheet()->update(mapRectToScene(boundingRect()));
@@ -123,8 +216,10 @@ void AnimationResultItem::stopMovie()
 
 void AnimationResultItem::pauseMovie()
 {
-    if (m_movie)
+    if (m_movie) {
+        m_userPaused = true;
         m_movie->setPaused(true);
+    }
 }
 
 void AnimationResultItem::deleteLater()
@@ -20,7 +20,7 @@ class AnimationResultItem : public WorksheetImageItem, public ResultItem
 
   public:
     explicit AnimationResultItem(QGraphicsObject*, Cantor::Result*);
-    ~AnimationResultItem() override = default;
+    ~AnimationResultItem() override;
 
     using WorksheetImageItem::setGeometry;
     double setGeometry(double x, double y, double w) override;
@@ -36,19 +36,29 @@ class AnimationResultItem : public WorksheetImageItem, public ResultItem
 
   protected Q_SLOTS:
     void saveResult();
+    void startMovie();
     void stopMovie();
     void pauseMovie();
 
+  protected:
+    QVariant itemChange(GraphicsItemChange, const QVariant&) override;
+
   private:
     void setMovie(QMovie*);
+    void setCacheMode();
+    void releaseCache();
 
   private Q_SLOTS:
     void updateFrame();
     void updateSize(QSize);
+    void updatePlayback();
 
   private:
     double m_height{0.};
     QMovie* m_movie{nullptr};
+    bool m_suspended{false}; // paused because the item is not visible
+    bool m_userPaused{false}; // paused or stopped in the context menu
+    qint64 m_cacheSize{0}; // bytes reserved in the worksheet for the cached frames
 };
 
 #endif //ANIMATIONRESULTITEM_H
@@ -6,6 +6,7 @@
 
 #include "backendchoosedialog.h"
 #include "lib/backend.h"
+#include "lib/backendrequirements.h"
 #include "settings.h"
 
 #include <KIconLoader>
@@ -39,21 +40,17 @@ BackendChooseDialog::BackendChooseDialog(QWidget* parent) : QDialog(parent)
     m_ui.buttonBox->button(QDialogButtonBox::Ok)->setIcon(QApplication::style()->standardIcon(QStyle::SP_DialogOkButton));
     m_ui.buttonBox->button(QDialogButtonBox::Cancel)->setIcon(QApplication::style()->standardIcon(QStyle::SP_DialogCancelButton));
 
-    for (auto* backend : Cantor::Backend::availableBackends())
+    // the plugins are loaded only for showing the details of the selected backend
+    for (const auto& plugin : Cantor::Backend::availableBackendsMetaData())
     {
-        qDebug() << backend->name() << backend->isEnabled() << backend->requirementsFullfilled();
-        if(!backend->isEnabled())
-            if (backend->requirementsFullfilled())
-                continue;
-
         QListWidgetItem* item = new QListWidgetItem(m_ui.backendList);
-        item->setText(backend->name());
-        item->setIcon(QIcon::fromTheme(backend->icon()));
+        item->setText(plugin.name());
+        item->setIcon(QIcon::fromTheme(plugin.iconName()));
         m_ui.backendList->addItem(item);
         if(m_ui.backendList->currentItem() == nullptr)
             m_ui.backendList->setCurrentItem(item);
 
-        if(backend->name()==Settings::self()->defaultBackend())
+        if(plugin.name()==Settings::self()->defaultBackend())
             m_ui.backendList->setCurrentItem(item);
     }
 
@@ -114,7 +111,7 @@ void BackendChooseDialog::updateContent()
                             "<div>See <a href=\"%2\">%2</a> for more information.</div>",
                             current->description(), current->url());
 
-        if (current->requirementsFullfilled(&reason))
+        if (Cantor::BackendRequirements::instance()->isFulfilled(current, &reason))
         {
             desc = header + info;
             m_ui.buttonBox->button(QDialogButtonBox::Ok)->setEnabled(true);
@@ -57,12 +57,21 @@ Cantor::Backend::Capabilities RBackend::capabilities() const
 
 bool RBackend::requirementsFullfilled(QString* const reason) const
 {
+    QString name;
+    QString path;
+    requiredExecutable(&name, &path);
+    return name.isEmpty() || Cantor::Backend::checkExecutable(name, path, reason);
+}
+
+bool RBackend::requiredExecutable(QString* name, QString* path) const
+{
+    *name = QLatin1String("Cantor RServer");
 #ifdef Q_OS_WIN
-    const QString& path = QStandardPaths::findExecutable(QLatin1String("cantor_rserver.exe"));
+    *path = QStandardPaths::findExecutable(QLatin1String("cantor_rserver.exe"));
 #else
-    const QString& path = QStandardPaths::findExecutable(QLatin1String("cantor_rserver"));
+    *path = QStandardPaths::findExecutable(QLatin1String("cantor_rserver"));
 #endif
-    return Cantor::Backend::checkExecutable(QLatin1String("Cantor RServer"), path, reason);
+    return true;
 }
 
 QWidget* RBackend::settingsWidget(QWidget* parent) const
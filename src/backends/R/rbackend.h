@@ -20,6 +20,7 @@ class RBackend : public Cantor::Backend
     Cantor::Session* createSession() override;
     Cantor::Backend::Capabilities capabilities() const override;
     bool requirementsFullfilled(QString* const reason = nullptr) const override;
+    bool requiredExecutable(QString* name, QString* path) const override;
 
     QWidget* settingsWidget(QWidget* parent) const override;
     KConfigSkeleton* config() const override;
@@ -39,17 +39,27 @@ void RSession::login()
         return;
     emit loginStarted();
 
+    // the server is started asynchronously, the expressions are held back until it's ready
+    holdExpressions();
+
     m_process = new QProcess(this);
     m_process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    connect(m_process, &QProcess::readyReadStandardOutput, this, &RSession::serverStarted);
 #ifdef Q_OS_WIN
     m_process->start(QStandardPaths::findExecutable(QLatin1String("cantor_rserver.exe")));
 #else
     m_process->start(QStandardPaths::findExecutable(QLatin1String("cantor_rserver")));
 #endif
+}
 
-    m_process->waitForStarted();
-    m_process->waitForReadyRead();
+/*!
+ * called when the server wrote its first output, i.e. it registered at D-Bus
+ */
+void RSession::serverStarted()
+{
+    disconnect(m_process, &QProcess::readyReadStandardOutput, this, &RSession::serverStarted);
     qDebug()<<m_process->readAllStandardOutput();
+    releaseExpressions();
 
     m_rServer = new org::kde::Cantor::R(QString::fromLatin1("org.kde.Cantor.R-%1").arg(m_process->processId()),  QLatin1String("/"), QDBusConnection::sessionBus(), this);
 
@@ -42,6 +42,7 @@ class RSession : public Cantor::Session
     void serverChangedStatus(int status);
     void expressionFinished(int returnCode, const QString& text, const QStringList& files);
     void inputRequested(QString info);
+    void serverStarted();
 
   private:
     QProcess* m_process;
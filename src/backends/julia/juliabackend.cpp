@@ -71,12 +71,21 @@ QUrl JuliaBackend::helpUrl() const
 
 bool JuliaBackend::requirementsFullfilled(QString* const reason) const
 {
+    QString name;
+    QString path;
+    requiredExecutable(&name, &path);
+    return name.isEmpty() || Cantor::Backend::checkExecutable(name, path, reason);
+}
+
+bool JuliaBackend::requiredExecutable(QString* name, QString* path) const
+{
+    *name = QLatin1String("Cantor Julia Server");
 #ifdef Q_OS_WIN
-    const QString& path = QStandardPaths::findExecutable(QLatin1String("cantor_juliaserver.exe"));
+    *path = QStandardPaths::findExecutable(QLatin1String("cantor_juliaserver.exe"));
 #else
-    const QString& path = QStandardPaths::findExecutable(QLatin1String("cantor_juliaserver"));
+    *path = QStandardPaths::findExecutable(QLatin1String("cantor_juliaserver"));
 #endif
-    return Cantor::Backend::checkExecutable(QLatin1String("Cantor Julia Server"), path, reason);
+    return true;
 }
 
 QWidget* JuliaBackend::settingsWidget(QWidget *parent) const
@@ -64,6 +64,11 @@ public:
      */
     bool requirementsFullfilled(QString* const reason = nullptr) const override;
 
+    /**
+     * @see Cantor::Backend::requiredExecutable
+     */
+    bool requiredExecutable(QString* name, QString* path) const override;
+
     /**
      * @see Cantor::Backend::settingsWidget
      */
@@ -70,13 +70,19 @@ void JuliaExpression::finalize(const QString& output, const QString& error, bool
             setResult(new Cantor::TextResult(output));
         setStatus(Cantor::Expression::Error);
     } else {
+        // the plots of cantor_plot() are announced in the output
+        QString text = output;
+        const auto& plotFiles = takePlotFiles(text);
+
         if (!m_plot_filename.isEmpty() && QFileInfo(m_plot_filename).exists()) {
             // If we have plot in result, show it
             setResult(new Cantor::ImageResult(QUrl::fromLocalFile(m_plot_filename)));
         } else {
-            if (!output.isEmpty())
-                setResult(new Cantor::TextResult(output));
+            if (!text.isEmpty())
+                setResult(new Cantor::TextResult(text));
         }
+        for (const auto& file : plotFiles)
+            addPlotResult(file);
         setStatus(Cantor::Expression::Done);
     }
 }
@@ -251,6 +251,12 @@ QString JuliaPlotExtension::plotFunction3d(
 }
 
 
+QString JuliaPlotExtension::plotData2d(const QString &x, const QString &y)
+{
+    // cantor_plot() is defined at the login of the session
+    return QString::fromLatin1("cantor_plot(%1, %2)").arg(x, y);
+}
+
 JULIA_EXT_CDTOR(Script)
 
 QString JuliaScriptExtension::runExternalScript(const QString &path)
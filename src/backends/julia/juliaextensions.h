@@ -112,6 +112,11 @@ public:
         const QString &function,
         const VariableParameter& var1,
         const VariableParameter& var2) override;
+
+    /**
+     * @see Cantor::PlotExtension::plotData2d
+     */
+    QString plotData2d(const QString &x, const QString &y) override;
 };
 
 /**
@@ -11,9 +11,13 @@
 #include <KLocalizedString>
 #include <QDBusConnection>
 #include <QDBusInterface>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
 #include <QDBusReply>
 #include <QStandardPaths>
+#include <QDateTime>
 #include <QDir>
+#include <QFileInfo>
 
 #include "defaultvariablemodel.h"
 
@@ -25,6 +29,7 @@
 #include "juliaextensions.h"
 #include "juliabackend.h"
 #include "juliacompletionobject.h"
+#include "juliascriptloading.h"
 
 using namespace Cantor;
 
@@ -49,6 +54,10 @@ void JuliaSession::login()
         return;
     emit loginStarted();
 
+    // the server is started asynchronously, the expressions are held back until it's ready
+    holdExpressions();
+    m_startOutput.clear();
+
     m_process = new KProcess(this);
     m_process->setOutputChannelMode(KProcess::OnlyStdoutChannel);
 
@@ -61,23 +70,27 @@ void JuliaSession::login()
 #endif
 
     connect(m_process, &QProcess::errorOccurred, this, &JuliaSession::reportServerProcessError);
+    connect(m_process, &QProcess::readyReadStandardOutput, this, &JuliaSession::readServerStart);
 
     m_process->start();
-    m_process->waitForStarted();
-    m_process->waitForReadyRead();
-    QTextStream stream(m_process->readAllStandardOutput());
-
-    QString readyStatus = QLatin1String("ready");
-    while (m_process->state() == QProcess::Running) {
-        const QString &rl = stream.readLine();
-        if (rl == readyStatus) {
-            break;
-        }
-    }
+}
+
+/*!
+ * reads the output of the starting server and logs in to it via D-Bus once it's ready
+ */
+void JuliaSession::readServerStart()
+{
+    m_startOutput += m_process->readAllStandardOutput();
+    if (!m_startOutput.contains("ready"))
+        return;
+
+    m_startOutput.clear();
+    disconnect(m_process, &QProcess::readyReadStandardOutput, this, &JuliaSession::readServerStart);
 
     if (!QDBusConnection::sessionBus().isConnected()) {
         qWarning() << "Can't connect to the D-Bus session bus.\n"
                       "To start it, run: eval `dbus-launch --auto-syntax`";
+        releaseExpressions();
         return;
     }
 
@@ -93,10 +106,25 @@ void JuliaSession::login()
 
     if (!m_interface->isValid()) {
         qWarning() << QDBusConnection::sessionBus().lastError().message();
+        releaseExpressions();
         return;
     }
 
-    const QDBusReply<int> &reply = m_interface->call(QLatin1String("login"));
+    // the initialization of Julia takes a while, the reply is not waited for
+    auto* watcher = new QDBusPendingCallWatcher(m_interface->asyncCall(QLatin1String("login")), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, &JuliaSession::loginReplied);
+}
+
+void JuliaSession::loginReplied(QDBusPendingCallWatcher* watcher)
+{
+    watcher->deleteLater();
+    // the session was logged out meanwhile
+    if (!m_process)
+        return;
+
+    releaseExpressions();
+
+    const QDBusPendingReply<int> reply = *watcher;
     if (reply.isValid())
     {
         int errorCode = reply.value();
@@ -120,6 +148,9 @@ void JuliaSession::login()
 
     static_cast<JuliaVariableModel*>(variableModel())->setJuliaServer(m_interface);
 
+    // helper for the plots rendered by Cantor, see Cantor::PlotResult
+    runJuliaCommand(loadScript(QLatin1String("cantor_plot")));
+
     std::random_device rd;
     std::mt19937 mt(rd());
     std::uniform_int_distribution<int> rand_dist(0, 999999999);
@@ -325,3 +356,22 @@ QString JuliaSession::graphicPackageErrorMessage(QString packageId) const
 }
 
 
+
+QString JuliaSession::graphicPackageProbeLabelCommand(const QString& label) const
+{
+    return QString::fromLatin1("println(\"%1\")").arg(label);
+}
+
+QString JuliaSession::interpreterId() const
+{
+    // the server embeds the interpreter, it is rebuilt or replaced for a new version of Julia
+#ifdef Q_OS_WIN
+    const QString& serverExecutablePath = QStandardPaths::findExecutable(QLatin1String("cantor_juliaserver.exe"));
+#else
+    const QString& serverExecutablePath = QStandardPaths::findExecutable(QLatin1String("cantor_juliaserver"));
+#endif
+    if (serverExecutablePath.isEmpty())
+        return QString();
+
+    return serverExecutablePath + QLatin1Char(':') + QFileInfo(serverExecutablePath).lastModified().toString(Qt::ISODate);
+}
@@ -15,6 +15,7 @@ class JuliaCompletionObject;
 class JuliaVariableModel;
 class KProcess;
 class QDBusInterface;
+class QDBusPendingCallWatcher;
 namespace Cantor {
     class DefaultVariableModel;
 }
@@ -79,12 +80,19 @@ private Q_SLOTS:
      */
     void onResultReady();
 
+    /**
+     * Called while the server starts, until it is ready for the login
+     */
+    void readServerStart();
+    void loginReplied(QDBusPendingCallWatcher* watcher);
+
     // Handler for cantor_juliaserver crashes
     void reportServerProcessError(QProcess::ProcessError serverError);
 
 private:
     KProcess* m_process{nullptr}; //< process to run JuliaServer inside
     QDBusInterface* m_interface{nullptr}; //< interface to JuliaServer
+    QByteArray m_startOutput; //< output of the starting server
 
     /// Cache to speedup modules whos calls
     QMap<QString, QString> m_whos_cache;
@@ -137,4 +145,6 @@ private:
     void updateGraphicPackagesFromSettings();
 
     QString graphicPackageErrorMessage(QString packageId) const override;
+    QString graphicPackageProbeLabelCommand(const QString& label) const override;
+    QString interpreterId() const override;
 };
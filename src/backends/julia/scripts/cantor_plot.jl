@@ -0,0 +1,38 @@
+# Announces the plot file to Cantor, must be called after the file was written and closed
+function cantor_plot_written(path, mime)
+    if isfile(path) && filesize(path) > 0
+        println("__cantor_plot__:", path, '\t', mime, '\t', filesize(path))
+    end
+    nothing
+end
+
+# Shows the numeric data as a plot rendered by Cantor,
+# e.g. cantor_plot(x, y1, y2; names = ["a", "b"])
+function cantor_plot(x, ys...; names = String[])
+    if isempty(ys)
+        ys = (x,)
+        x = 1:length(x)
+    end
+    # the data is written into the temporary file itself, which is renamed to get the extension,
+    # the file is removed by Cantor together with the plot result
+    tmp, file = mktemp()
+    try
+        write(file, b"CANTPLT1", htol(UInt32(length(ys))), UInt32(0))
+        for (i, y) in enumerate(ys)
+            length(y) == length(x) || throw(ArgumentError("x and y must have the same length"))
+            name = collect(codeunits(i <= length(names) ? string(names[i]) : ""))
+            write(file, htol(UInt32(length(name))), UInt32(0), htol(UInt64(length(x))))
+            write(file, name, zeros(UInt8, mod(-length(name), 8)))
+            write(file, htol.(Float64.(collect(x))), htol.(Float64.(collect(y))))
+        end
+        close(file)
+    catch
+        close(file)
+        rm(tmp; force = true)
+        rethrow()
+    end
+    path = tmp * ".cantorplot"
+    mv(tmp, path; force = true)
+    cantor_plot_written(path, "application/x-cantor-plot")
+    nothing
+end
@@ -64,5 +64,13 @@ bool KAlgebraBackend::requirementsFullfilled(QString* const reason) const
     return true;
 }
 
+bool KAlgebraBackend::requiredExecutable(QString* name, QString* path) const
+{
+    // analitza is linked, no executable is needed
+    Q_UNUSED(name);
+    Q_UNUSED(path);
+    return true;
+}
+
 K_PLUGIN_FACTORY_WITH_JSON(kalgebrabackend, "kalgebrabackend.json", registerPlugin<KAlgebraBackend>();)
 #include "kalgebrabackend.moc"
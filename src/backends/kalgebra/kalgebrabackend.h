@@ -25,6 +25,7 @@ class KAlgebraBackend : public Cantor::Backend
         QUrl helpUrl() const override;
         QString version() const override;
         bool requirementsFullfilled(QString* const reason) const override;
+        bool requiredExecutable(QString* name, QString* path) const override;
 };
 
 #endif /* _NULLBACKEND_H */
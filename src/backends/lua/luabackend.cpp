@@ -43,8 +43,21 @@ Cantor::Backend::Capabilities LuaBackend::capabilities() const
 
 bool LuaBackend::requirementsFullfilled(QString* const reason) const
 {
-    const QString& path = LuaSettings::self()->path().toLocalFile();
-    return Cantor::Backend::checkExecutable(QLatin1String("Lua"), path, reason);
+    QString name;
+    QString path;
+    requiredExecutable(&name, &path);
+    return name.isEmpty() || Cantor::Backend::checkExecutable(name, path, reason);
+}
+
+bool LuaBackend::requiredExecutable(QString* name, QString* path) const
+{
+    // the interpreter is linked into the backend
+    if (LuaSettings::self()->inProcess())
+        return true;
+
+    *name = QLatin1String("Lua");
+    *path = LuaSettings::self()->path().toLocalFile();
+    return true;
 }
 
 QUrl LuaBackend::helpUrl() const
@@ -22,6 +22,7 @@ public:
     Cantor::Backend::Capabilities capabilities() const override;
 
     bool requirementsFullfilled(QString* const reason = nullptr) const override;
+    bool requiredExecutable(QString* name, QString* path) const override;
     QUrl helpUrl() const override;
     QString description() const override;
 
@@ -8,6 +8,7 @@
 #include <QStringList>
 
 #include "luasession.h"
+#include "luaengine.h"
 #include "luahelper.h"
 #include "luakeywords.h"
 
@@ -43,7 +44,12 @@ void LuaCompletionObject::fetchCompletions()
         if(idx >= 0)
             name = name.mid(idx+1).trimmed();
 
-        setCompletions( luahelper_completion(m_L, name) );
+        // the in-process interpreter knows the globals of the user
+        auto* engine = static_cast<LuaSession*>(session())->engine();
+        if (engine)
+            setCompletions(engine->completions(name));
+        else
+            setCompletions( luahelper_completion(m_L, name) );
         emit fetchingDone();
     }
 }
@@ -0,0 +1,194 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#include "luaengine.h"
+#include "luahelper.h"
+
+#include <QDebug>
+#include <QMutexLocker>
+
+#include <lua.hpp>
+
+// the interpreter shares the process with Cantor: os.exit() would quit Cantor
+// and reading from stdin would block it
+static const char* sandbox =
+    "local stdin = io.stdin\n"
+    "local input = io.input\n"
+    "local lines = io.lines\n"
+    "local read = io.read\n"
+    "local function unavailable(name)\n"
+    "    error(name .. ' is not available when Lua runs inside of Cantor', 3)\n"
+    "end\n"
+    "os.exit = function() unavailable('os.exit()') end\n"
+    "io.read = function(...)\n"
+    "    if input() == stdin then unavailable('Reading from stdin') end\n"
+    "    return read(...)\n"
+    "end\n"
+    "debug.debug = function() unavailable('debug.debug()') end\n"
+    "io.input = function(file)\n"
+    "    if file == stdin or (file == nil and input() == stdin) then unavailable('Reading from stdin') end\n"
+    "    return input(file)\n"
+    "end\n"
+    "io.lines = function(filename, ...)\n"
+    "    if filename == nil and input() == stdin then unavailable('Reading from stdin') end\n"
+    "    return lines(filename, ...)\n"
+    "end\n"
+    "io.stdin = nil\n";
+
+// same approach as in lua.c: the hook is installed asynchronously and raises an error
+// at the next instruction count of the running code
+static void luaengine_stop(lua_State* L, lua_Debug*)
+{
+    lua_sethook(L, nullptr, 0, 0);
+    luaL_error(L, "interrupted!");
+}
+
+// converts the value at the absolute stack index @p idx with Lua's tostring(),
+// the call is protected since the value can have a failing __tostring metamethod
+static void luaengine_tostring(lua_State* L, int idx, QString& out)
+{
+    lua_getglobal(L, "tostring");
+    lua_pushvalue(L, idx);
+    lua_pcall(L, 1, 1, 0);
+    out += QString::fromUtf8(lua_tostring(L, -1));
+    lua_pop(L, 1);
+}
+
+LuaEngine::LuaEngine()
+{
+    m_L = luaL_newstate();
+    luaL_openlibs(m_L);
+
+    // replace print() and io.write(), the engine is the upvalue of the functions
+    lua_pushlightuserdata(m_L, this);
+    lua_pushcclosure(m_L, &LuaEngine::print, 1);
+    lua_setglobal(m_L, "print");
+
+    lua_getglobal(m_L, "io");
+    lua_pushlightuserdata(m_L, this);
+    lua_pushcclosure(m_L, &LuaEngine::write, 1);
+    lua_setfield(m_L, -2, "write");
+    lua_pop(m_L, 1);
+
+    if (luaL_dostring(m_L, sandbox))
+    {
+        qWarning() << "failed to restrict the Lua interpreter:" << lua_tostring(m_L, -1);
+        lua_pop(m_L, 1);
+    }
+}
+
+LuaEngine::~LuaEngine()
+{
+    lua_close(m_L);
+}
+
+void LuaEngine::interrupt()
+{
+    lua_sethook(m_L, luaengine_stop, LUA_MASKCALL | LUA_MASKRET | LUA_MASKCOUNT, 1);
+}
+
+QStringList LuaEngine::completions(const QString& name)
+{
+    if (!m_mutex.tryLock())
+        return QStringList();
+
+    const QStringList& result = luahelper_completion(m_L, name);
+    m_mutex.unlock();
+    return result;
+}
+
+void LuaEngine::evaluate(int id, const QString& command)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_results.clear();
+    m_pending.clear();
+
+    // drop an interruption requested after the previous command was already finished
+    lua_sethook(m_L, nullptr, 0, 0);
+
+    // like the interactive interpreter, show the values of the expressions
+    const int top = lua_gettop(m_L);
+    const QByteArray& expression = QByteArray("return ") + command.toUtf8();
+    const QByteArray& statement = command.toUtf8();
+    int error = luaL_loadbuffer(m_L, expression.constData(), expression.size(), "=stdin");
+    if (error)
+    {
+        lua_pop(m_L, 1);
+        error = luaL_loadbuffer(m_L, statement.constData(), statement.size(), "=stdin");
+    }
+
+    if (!error)
+        error = lua_pcall(m_L, 0, LUA_MULTRET, 0);
+
+    // the interruption hook could be still installed if the command finished in the meantime
+    lua_sethook(m_L, nullptr, 0, 0);
+
+    flush();
+
+    if (error)
+    {
+        const QString& errorMessage = QString::fromUtf8(lua_tostring(m_L, -1));
+        lua_settop(m_L, top);
+        emit finished(id, m_results, errorMessage);
+        return;
+    }
+
+    const int count = lua_gettop(m_L) - top;
+    if (count > 0)
+    {
+        QString values;
+        for (int i = top + 1; i <= top + count; ++i)
+        {
+            if (i > top + 1)
+                values += QLatin1Char('\t');
+            luaengine_tostring(m_L, i, values);
+        }
+        m_results << values;
+    }
+
+    lua_settop(m_L, top);
+    emit finished(id, m_results, QString());
+}
+
+void LuaEngine::flush()
+{
+    if (m_pending.isEmpty())
+        return;
+
+    if (m_pending.endsWith(QLatin1Char('\n')))
+        m_pending.chop(1);
+    m_results << m_pending;
+    m_pending.clear();
+}
+
+int LuaEngine::print(lua_State* L)
+{
+    auto* engine = static_cast<LuaEngine*>(lua_touserdata(L, lua_upvalueindex(1)));
+    const int count = lua_gettop(L);
+
+    // Lua errors unwind the C stack, append directly to the member instead of using a local string
+    for (int i = 1; i <= count; ++i)
+    {
+        if (i > 1)
+            engine->m_pending += QLatin1Char('\t');
+        luaengine_tostring(L, i, engine->m_pending);
+    }
+
+    engine->m_results << engine->m_pending;
+    engine->m_pending.clear();
+    return 0;
+}
+
+int LuaEngine::write(lua_State* L)
+{
+    auto* engine = static_cast<LuaEngine*>(lua_touserdata(L, lua_upvalueindex(1)));
+    const int count = lua_gettop(L);
+
+    for (int i = 1; i <= count; ++i)
+        engine->m_pending += QString::fromUtf8(luaL_checkstring(L, i));
+
+    return 0;
+}
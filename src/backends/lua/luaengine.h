@@ -0,0 +1,59 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#ifndef _LUAENGINE_H
+#define _LUAENGINE_H
+
+#include <QMutex>
+#include <QObject>
+#include <QStringList>
+
+struct lua_State;
+
+/**
+ * Lua interpreter running inside of Cantor's process.
+ *
+ * The engine lives in a worker thread, all the Lua code is executed there.
+ * The output of print() and io.write() is captured instead of being written to stdout,
+ * every call of print() produces a separate result. os.exit() and the functions reading
+ * from stdin are replaced by functions raising an error, they would exit or block Cantor.
+ */
+class LuaEngine : public QObject
+{
+  Q_OBJECT
+
+public:
+    LuaEngine();
+    ~LuaEngine() override;
+
+    /**
+     * Stops the running command, can be called from any thread.
+     */
+    void interrupt();
+
+    /**
+     * Returns the completions of @p name in the state of the interpreter, an empty list
+     * while a command is running. Can be called from any thread.
+     */
+    QStringList completions(const QString& name);
+
+public Q_SLOTS:
+    void evaluate(int id, const QString& command);
+
+Q_SIGNALS:
+    void finished(int id, const QStringList& results, const QString& error);
+
+private:
+    static int print(lua_State*);
+    static int write(lua_State*);
+    void flush();
+
+    lua_State* m_L{nullptr};
+    QMutex m_mutex; // guards m_L, held during the evaluation
+    QStringList m_results;
+    QString m_pending;
+};
+
+#endif /* _LUAENGINE_H */
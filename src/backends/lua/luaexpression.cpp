@@ -80,3 +80,14 @@ void LuaExpression::parseOutput(const QString& output)
 
     setStatus(Cantor::Expression::Done);
 }
+
+void LuaExpression::parseResults(const QStringList& results, const QString& error)
+{
+    for (const auto& result : results)
+        addResult(new Cantor::TextResult(result));
+
+    if (error.isEmpty())
+        setStatus(Cantor::Expression::Done);
+    else
+        parseError(error);
+}
@@ -21,6 +21,11 @@ public:
     void evaluate() override;
     void parseOutput(const QString&) override;
     void parseError(const QString&) override;
+
+    /**
+     * Sets the output of the in-process interpreter, one result per entry of @p results
+     */
+    void parseResults(const QStringList& results, const QString& error);
 };
 
 #endif /* _LUAEXPRESSION_H */
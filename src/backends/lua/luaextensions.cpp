@@ -29,3 +29,8 @@ QString LuaScriptExtension::commandSeparator()
 {
     return QLatin1String("");
 }
+
+QString LuaScriptExtension::commentStartingSequence()
+{
+    return QLatin1String("--");
+}
@@ -19,6 +19,7 @@ class LuaScriptExtension : public Cantor::ScriptExtension
     QString highlightingMode() override;
     QString runExternalScript(const QString& path) override;
     QString commandSeparator() override;
+    QString commentStartingSequence() override;
 };
 
 #endif // LUAEXTENSIONS_H
@@ -5,6 +5,7 @@
 */
 
 #include "luasession.h"
+#include "luaengine.h"
 #include "luaexpression.h"
 #include "luacompletionobject.h"
 #include "luahighlighter.h"
@@ -16,7 +17,9 @@
 #include <signal.h>
 #endif
 
+#include <QDebug>
 #include <QProcess>
+#include <QThread>
 
 const QString LuaSession::LUA_PROMPT = QLatin1String("> ");
 const QString LuaSession::LUA_SUBPROMPT = QLatin1String(">> ");
@@ -26,6 +29,8 @@ LuaSession::LuaSession(Cantor::Backend* backend) : Session(backend) {
 
 LuaSession::~LuaSession()
 {
+    stopEngine();
+
     if (m_process)
     {
         m_process->kill();
@@ -38,6 +43,21 @@ void LuaSession::login()
 {
     emit loginStarted();
 
+    if (LuaSettings::self()->inProcess())
+    {
+        // run the interpreter in Cantor's process, no process start-up and no prompt parsing
+        m_engineThread = new QThread(this);
+        m_engine = new LuaEngine();
+        m_engine->moveToThread(m_engineThread);
+        connect(m_engineThread, &QThread::finished, m_engine, &QObject::deleteLater);
+        connect(m_engine, &LuaEngine::finished, this, &LuaSession::engineFinished);
+        m_engineThread->start();
+
+        changeStatus(Cantor::Session::Done);
+        emit loginDone();
+        return;
+    }
+
     m_process = new QProcess(this);
 
     const auto& path = LuaSettings::self()->path().toLocalFile();
@@ -212,6 +232,16 @@ void LuaSession::processStarted()
 
 void LuaSession::logout()
 {
+    if (m_engineThread)
+    {
+        if(status() == Cantor::Session::Running)
+            interrupt();
+
+        stopEngine();
+        Session::logout();
+        return;
+    }
+
     if (!m_process)
         return;
 
@@ -225,12 +255,40 @@ void LuaSession::logout()
     Session::logout();
 }
 
+/*!
+ * stops the thread of the in-process interpreter. A blocking C call can't be stopped by the
+ * interruption hook, the thread is left behind after a timeout instead of freezing Cantor.
+ */
+void LuaSession::stopEngine()
+{
+    if (!m_engineThread)
+        return;
+
+    disconnect(m_engine, nullptr, this, nullptr);
+    m_engine->interrupt();
+    m_engineThread->quit();
+
+    if (m_engineThread->wait(3000))
+        delete m_engineThread;
+    else
+    {
+        qWarning() << "the Lua interpreter doesn't respond, leaving its thread behind";
+        m_engineThread->setParent(nullptr);
+        connect(m_engineThread, &QThread::finished, m_engineThread, &QObject::deleteLater);
+    }
+
+    m_engineThread = nullptr;
+    m_engine = nullptr; // deleted when the thread finished
+}
+
 void LuaSession::interrupt()
 {
     if(!expressionQueue().isEmpty())
     {
         qDebug()<<"interrupting " << expressionQueue().first()->command();
-        if(m_process && m_process->state() != QProcess::NotRunning)
+        if (m_engine)
+            m_engine->interrupt();
+        else if(m_process && m_process->state() != QProcess::NotRunning)
         {
 #ifndef Q_OS_WIN
             const int pid = m_process->processId();
@@ -277,9 +335,27 @@ void LuaSession::runFirstExpression()
     qDebug() << "final command to be executed " << command;
 
     m_lastExpression->setStatus(Cantor::Expression::Computing);
+
+    if (m_engine)
+    {
+        ++m_engineCommandId;
+        QMetaObject::invokeMethod(m_engine, "evaluate", Qt::QueuedConnection,
+                                  Q_ARG(int, m_engineCommandId), Q_ARG(QString, m_lastExpression->internalCommand()));
+        return;
+    }
+
     m_process->write(command.toLocal8Bit());
 }
 
+void LuaSession::engineFinished(int id, const QStringList& results, const QString& error)
+{
+    // the result of an interrupted command
+    if (id != m_engineCommandId || !m_lastExpression || m_lastExpression->status() != Cantor::Expression::Computing)
+        return;
+
+    m_lastExpression->parseResults(results, error);
+}
+
 Cantor::CompletionObject* LuaSession::completionFor(const QString& command, int index)
 {
     return new LuaCompletionObject(command, index, this);
@@ -307,3 +383,8 @@ lua_State* LuaSession::getState() const
 {
     return m_L;
 }
+
+LuaEngine* LuaSession::engine() const
+{
+    return m_engine;
+}
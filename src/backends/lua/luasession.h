@@ -10,8 +10,10 @@
 #include "session.h"
 #include <lua.hpp>
 
+class LuaEngine;
 class LuaExpression;
 class QProcess;
+class QThread;
 
 class LuaSession : public Cantor::Session
 {
@@ -33,6 +35,7 @@ public:
 
     bool isLuaJIT() const;
     lua_State* getState() const;
+    LuaEngine* engine() const;
 
 public Q_SLOTS:
     void readIntroMessage();
@@ -42,14 +45,19 @@ public Q_SLOTS:
 
 private Q_SLOTS:
     void expressionFinished(Cantor::Expression::Status);
+    void engineFinished(int id, const QStringList& results, const QString& error);
 
 private:
     void readOutputLua();
     void readOutputLuaJIT();
     bool isPromptString(const QString&);
+    void stopEngine();
 
     lua_State* m_L{nullptr};
     QProcess* m_process{nullptr};
+    LuaEngine* m_engine{nullptr};
+    QThread* m_engineThread{nullptr};
+    int m_engineCommandId{0};
     LuaExpression* m_lastExpression{nullptr};
     QStringList m_inputCommands;
     QStringList m_output;
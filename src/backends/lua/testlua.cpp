@@ -180,4 +180,33 @@ void TestLua::testFunction()
     QCOMPARE( cleanOutput(e2->result()->data().toString()), QLatin1String("10") );
 }
 
+void TestLua::testExpressionValue()
+{
+    auto* e = evalExp(QLatin1String("2+2, 'a'"));
+
+    QVERIFY(e != nullptr);
+    if (e->status() == Cantor::Expression::Error)
+        QSKIP("The values of the expressions are only shown by the embedded interpreter", SkipSingle);
+
+    QVERIFY(e->result() != nullptr);
+    QCOMPARE(e->result()->data().toString(), QLatin1String("4\ta"));
+}
+
+void TestLua::testInterrupt()
+{
+    auto* e = session()->evaluateExpression(QLatin1String("while true do end"));
+    QVERIFY(e != nullptr);
+    if (e->status() != Cantor::Expression::Computing)
+        waitForSignal(e, SIGNAL(statusChanged(Cantor::Expression::Status)));
+
+    session()->interrupt();
+    QCOMPARE(e->status(), Cantor::Expression::Interrupted);
+
+    // the session is usable after the interruption
+    auto* e2 = evalExp(QLatin1String("print(5)"));
+    QVERIFY(e2 != nullptr);
+    QVERIFY(e2->result() != nullptr);
+    QCOMPARE(cleanOutput(e2->result()->data().toString()), QLatin1String("5"));
+}
+
 QTEST_MAIN( TestLua )
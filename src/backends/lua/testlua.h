@@ -28,6 +28,8 @@ private Q_SLOTS:
     void testForLoop();
     void testWhileLoop();
     void testFunction();
+    void testExpressionValue();
+    void testInterrupt();
 
 private:
     QString backendName() override;
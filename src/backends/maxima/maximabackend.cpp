@@ -62,8 +62,17 @@ Cantor::Backend::Capabilities MaximaBackend::capabilities() const
 
 bool MaximaBackend::requirementsFullfilled(QString* const reason) const
 {
-    const QString& path = MaximaSettings::self()->path().toLocalFile();
-    return Cantor::Backend::checkExecutable(QLatin1String("Maxima"), path, reason);
+    QString name;
+    QString path;
+    requiredExecutable(&name, &path);
+    return name.isEmpty() || Cantor::Backend::checkExecutable(name, path, reason);
+}
+
+bool MaximaBackend::requiredExecutable(QString* name, QString* path) const
+{
+    *name = QLatin1String("Maxima");
+    *path = MaximaSettings::self()->path().toLocalFile();
+    return true;
 }
 
 QUrl MaximaBackend::helpUrl() const
@@ -25,6 +25,7 @@ class MaximaBackend : public Cantor::Backend
     Cantor::Session* createSession() override;
     Cantor::Backend::Capabilities capabilities() const override;
     bool requirementsFullfilled(QString* const reason = nullptr) const override;
+    bool requiredExecutable(QString* name, QString* path) const override;
 
     QUrl helpUrl() const override;
     QString defaultHelp() const override;
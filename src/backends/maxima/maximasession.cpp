@@ -52,23 +52,33 @@ void MaximaSession::login()
     const QString initFile = locateCantorFile(QLatin1String("maximabackend/cantor-initmaxima.lisp"));
     arguments << QLatin1String("--init-lisp=") + initFile; //Set the name of the Lisp initialization file
 
+    // maxima is started asynchronously, the expressions are held back until its first prompt
+    holdExpressions();
+    m_startOutput.clear();
+
     m_process = new QProcess(this);
+    connect(m_process, SIGNAL(readyReadStandardOutput()), this, SLOT(readStartOutput()));
+    connect(m_process, SIGNAL(error(QProcess::ProcessError)), this, SLOT(reportProcessError(QProcess::ProcessError)));
     m_process->start(MaximaSettings::self()->path().toLocalFile(), arguments);
-    m_process->waitForStarted();
+}
 
-    // Wait until first maxima prompt
-    QString input;
-    while (!input.contains(QLatin1String("</cantor-prompt>")))
-    {
-        m_process->waitForReadyRead();
-        input += QString::fromLatin1(m_process->readAllStandardOutput());
-        qDebug() << input;
-    }
+/*!
+ * reads the output of the starting maxima, the login is finished with its first prompt
+ */
+void MaximaSession::readStartOutput()
+{
+    m_startOutput += m_process->readAllStandardOutput();
+    if (!m_startOutput.contains("</cantor-prompt>"))
+        return;
+
+    qDebug() << m_startOutput;
+    m_startOutput.clear();
+    disconnect(m_process, SIGNAL(readyReadStandardOutput()), this, SLOT(readStartOutput()));
 
     connect(m_process, SIGNAL(finished(int,QProcess::ExitStatus)), this, SLOT(restartMaxima()));
     connect(m_process, SIGNAL(readyReadStandardOutput()), this, SLOT(readStdOut()));
     connect(m_process, SIGNAL(readyReadStandardError()), this, SLOT(readStdErr()));
-    connect(m_process, SIGNAL(error(QProcess::ProcessError)), this, SLOT(reportProcessError(QProcess::ProcessError)));
+    releaseExpressions();
 
     //enable latex typesetting if needed
     const QString& val = QLatin1String((isTypesettingEnabled() ? "t":"nil"));
@@ -153,6 +163,8 @@ void MaximaSession::readStdOut()
 {
     QString out = QString::fromLocal8Bit(m_process->readAllStandardOutput());
     m_cache += out;
+    if (!expressionQueue().isEmpty())
+        expressionQueue().first()->markTime(Cantor::Expression::FirstOutputTime);
 
     //collect the multi-line output until Maxima has finished the calculation and returns a new promt
     if ( !out.contains(QLatin1String("</cantor-prompt>")) )
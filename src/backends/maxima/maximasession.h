@@ -48,6 +48,7 @@ class MaximaSession : public Cantor::Session
     void readStdErr();
 
   private Q_SLOTS:
+    void readStartOutput();
     void restartMaxima();
     void restartsCooledDown();
     void reportProcessError(QProcess::ProcessError);
@@ -57,6 +58,7 @@ class MaximaSession : public Cantor::Session
 
     QProcess* m_process{nullptr};
     QString m_cache;
+    QByteArray m_startOutput;
     bool m_justRestarted{false};
     Mode m_mode{Maxima};
 };
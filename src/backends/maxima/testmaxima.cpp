@@ -13,6 +13,10 @@
 #include "textresult.h"
 #include "imageresult.h"
 #include "epsresult.h"
+#include "latexresult.h"
+#include "latexrenderer.h"
+#include "typesettingqueue.h"
+#include "renderer.h"
 #include "syntaxhelpobject.h"
 #include "completionobject.h"
 #include "defaultvariablemodel.h"
@@ -484,6 +488,97 @@ void TestMaxima::testTextQuotes()
     QVERIFY(e != nullptr);
 }
 
+void TestMaxima::testTypesetting()
+{
+#ifndef WITH_EPS
+    QSKIP("Cantor is built without EPS support", SkipSingle);
+#endif
+    if (!Cantor::LatexRenderer::isLatexAvailable())
+        QSKIP("latex and dvips are required for typesetting", SkipSingle);
+
+    session()->setTypesettingEnabled(true);
+
+    // both results are typeset in one batch
+    auto* e1 = evalExp(QLatin1String("x^2"));
+    auto* e2 = evalExp(QLatin1String("x^3"));
+    QVERIFY(e1 != nullptr);
+    QVERIFY(e2 != nullptr);
+
+    if (e1->results().isEmpty())
+        waitForSignal(e1, SIGNAL(gotResult()));
+    if (e2->results().isEmpty())
+        waitForSignal(e2, SIGNAL(gotResult()));
+
+    QVERIFY(e1->result() != nullptr);
+    QVERIFY(e2->result() != nullptr);
+    QCOMPARE(e1->result()->type(), (int)Cantor::LatexResult::Type);
+    QCOMPARE(e2->result()->type(), (int)Cantor::LatexResult::Type);
+    QVERIFY(e1->result()->url() != e2->result()->url());
+
+    // the same output again is taken from the cache
+    auto* e3 = evalExp(QLatin1String("x^2"));
+    QVERIFY(e3 != nullptr);
+    if (e3->results().isEmpty())
+        waitForSignal(e3, SIGNAL(gotResult()));
+
+    QVERIFY(e3->result() != nullptr);
+    QCOMPARE(e3->result()->type(), (int)Cantor::LatexResult::Type);
+    QCOMPARE(e3->result()->url(), e1->result()->url());
+
+    // rendering the same page at the same zoom level again is served from the raster cache
+    const QImage& first = Cantor::Renderer::fileRenderToImage(e1->result()->url(), 1.5, false);
+    const QImage& second = Cantor::Renderer::fileRenderToImage(e1->result()->url(), 1.5, false);
+    QVERIFY(!first.isNull());
+    QCOMPARE(second.cacheKey(), first.cacheKey());
+
+    session()->setTypesettingEnabled(false);
+}
+
+void TestMaxima::benchmarkTypesetting_data()
+{
+    QTest::addColumn<int>("format");
+
+    QTest::newRow("eps") << (int)Cantor::LatexRenderer::EpsImage;
+    QTest::newRow("pdf") << (int)Cantor::LatexRenderer::PdfImage;
+}
+
+void TestMaxima::benchmarkTypesetting()
+{
+    QFETCH(int, format);
+
+#ifndef WITH_EPS
+    QSKIP("Cantor is built without EPS support", SkipSingle);
+#endif
+    if (format == Cantor::LatexRenderer::PdfImage && !Cantor::LatexRenderer::isPdfLatexAvailable())
+        QSKIP("pdflatex is required for the PDF pipeline", SkipSingle);
+    if (format == Cantor::LatexRenderer::EpsImage
+        && (QStandardPaths::findExecutable(QLatin1String("latex")).isEmpty() || QStandardPaths::findExecutable(QLatin1String("dvips")).isEmpty()))
+        QSKIP("latex and dvips are required for the EPS pipeline", SkipSingle);
+
+    auto* queue = session()->typesettingQueue();
+    queue->setImageFormat(static_cast<Cantor::LatexRenderer::ImageFormat>(format));
+    session()->setTypesettingEnabled(true);
+
+    QBENCHMARK {
+        queue->clearCache();
+
+        QVector<Cantor::Expression*> expressions;
+        for (int i = 0; i < 20; ++i)
+            expressions << session()->evaluateExpression(QString::fromLatin1("integrate(x^%1*sin(x), x)").arg(i));
+
+        for (auto* e : expressions)
+        {
+            if (e->results().isEmpty())
+                waitForSignal(e, SIGNAL(gotResult()));
+            QVERIFY(e->result() != nullptr);
+            QCOMPARE(e->result()->type(), (int)Cantor::LatexResult::Type);
+        }
+    }
+
+    session()->setTypesettingEnabled(false);
+    queue->setImageFormat(Cantor::LatexRenderer::defaultImageFormat());
+}
+
 void TestMaxima::testVariableModel()
 {
     QAbstractItemModel* model = session()->variableModel();
@@ -70,6 +70,12 @@ private Q_SLOTS:
 
     void testTextQuotes();
 
+    //tests the batched typesetting of the latex results
+    void testTypesetting();
+    //compares the latex+dvips (EPS) and pdflatex (PDF) typesetting pipelines
+    void benchmarkTypesetting_data();
+    void benchmarkTypesetting();
+
     void testLoginLogout();
     void testRestartWhileRunning();
 
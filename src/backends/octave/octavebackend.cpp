@@ -53,8 +53,17 @@ Cantor::Session* OctaveBackend::createSession()
 
 bool OctaveBackend::requirementsFullfilled(QString* const reason) const
 {
-    const QString& path = OctaveSettings::path().toLocalFile();
-    return Cantor::Backend::checkExecutable(QLatin1String("Octave"), path, reason);
+    QString name;
+    QString path;
+    requiredExecutable(&name, &path);
+    return name.isEmpty() || Cantor::Backend::checkExecutable(name, path, reason);
+}
+
+bool OctaveBackend::requiredExecutable(QString* name, QString* path) const
+{
+    *name = QLatin1String("Octave");
+    *path = OctaveSettings::path().toLocalFile();
+    return true;
 }
 
 QUrl OctaveBackend::helpUrl() const
@@ -21,6 +21,7 @@ class OctaveBackend : public Cantor::Backend
     Cantor::Session* createSession() override;
 
     bool requirementsFullfilled(QString* const reason = nullptr) const override;
+    bool requiredExecutable(QString* name, QString* path) const override;
     QUrl helpUrl() const override;
     QString description() const override;
     QWidget* settingsWidget(QWidget* parent) const override;
@@ -17,13 +17,14 @@
 #include <QDesktopWidget>
 #include <QDebug>
 #include <QFile>
+#include <QFileInfo>
 #include <QDir>
 #include <QFileSystemWatcher>
 #include <QRegularExpression>
 
 #include <KLocalizedString>
 
-static const QString printCommandTemplate = QString::fromLatin1("print(\"%1\", \"-S%2,%3\")");
+static const QString printCommandTemplate = QString::fromLatin1("print(\"%1\", \"-S%2,%3\");cantor_plot_written(\"%1\", \"%4\");");
 
 static const QStringList plotCommands({
     QLatin1String("plot"), QLatin1String("semilogx"), QLatin1String("semilogy"),
@@ -51,6 +52,12 @@ const QStringList OctaveExpression::plotExtensions({
     QLatin1String("png")
 });
 
+static const QStringList plotMimeTypes({
+    QLatin1String("application/pdf"),
+    QLatin1String("image/svg+xml"),
+    QLatin1String("image/png")
+});
+
 OctaveExpression::OctaveExpression(Cantor::Session* session, bool internal): Expression(session, internal)
 {
 }
@@ -102,7 +109,7 @@ QString OctaveExpression::internalCommand()
                         w = OctaveSettings::plotWidth() / 2.54 * QApplication::desktop()->physicalDpiX();
                         h = OctaveSettings::plotHeight() / 2.54 * QApplication::desktop()->physicalDpiX();
                     }
-                    cmd += printCommandTemplate.arg(m_plotFilename, QString::number(w), QString::number(h));
+                    cmd += printCommandTemplate.arg(m_plotFilename, QString::number(w), QString::number(h), plotMimeTypes[OctaveSettings::inlinePlotFormat()]);
 
                     auto* watcher = fileWatcher();
                     if (!watcher->files().isEmpty())
@@ -193,16 +200,29 @@ void OctaveExpression::parseOutput(const QString& output)
     else
         qDebug() << "parseOutput: " << output;
 
-    if (!output.trimmed().isEmpty())
+    // the plot is announced in the output after print() has written the file
+    QString text = output;
+    const auto& plotFiles = takePlotFiles(text);
+
+    if (!text.trimmed().isEmpty())
     {
         // TODO: what about help in comment? printf with '... help ...'?
         // This must be corrected.
         if (command().contains(QLatin1String("help")))
-            addResult(new Cantor::HelpResult(output));
+            addResult(new Cantor::HelpResult(text));
         else
-            addResult(new Cantor::TextResult(output));
+            addResult(new Cantor::TextResult(text));
     }
 
+    for (const auto& file : plotFiles)
+        if (addPlotResult(file) && file.path == m_plotFilename)
+            m_plotPending = false;
+
+    // not announced, e.g. if the script directory is missing: use the file if it is there already,
+    // otherwise wait for the file watcher
+    if (m_plotPending && QFileInfo(m_plotFilename).size() > 0 && addPlotResult({m_plotFilename, QString(), -1}))
+        m_plotPending = false;
+
     m_finished = true;
     if (!m_plotPending)
         setStatus(Done);
@@ -224,6 +244,10 @@ void OctaveExpression::parseError(const QString& error)
 
 void OctaveExpression::imageChanged()
 {
+    // print() may be still writing the file, wait for the announcement in the output
+    if (!m_finished || !m_plotPending)
+        return;
+
     QFile file(m_plotFilename);
     if(!file.open(QIODevice::ReadOnly)/* || file.size() <= 0*/)
     {
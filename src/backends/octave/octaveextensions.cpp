@@ -44,6 +44,11 @@ QString OctaveScriptExtension::commandSeparator()
     return QLatin1String(";");
 }
 
+QString OctaveScriptExtension::commentStartingSequence()
+{
+    return QLatin1String("%");
+}
+
 OCTAVE_EXT_CDTOR(Plot)
 
 QString OctavePlotExtension::plotFunction2d(const QString& function, const QString& variable, const QString& left, const QString& right)
@@ -193,6 +198,16 @@ QString OctaveVariableManagementExtension::loadVariables(const QString& fileName
     return QString::fromLatin1("load %1;").arg(fileName);
 }
 
+QString OctaveVariableManagementExtension::saveSessionState(const QString& fileName)
+{
+    return QString::fromLatin1("save -binary \"%1\";").arg(fileName);
+}
+
+QString OctaveVariableManagementExtension::restoreSessionState(const QString& fileName)
+{
+    return QString::fromLatin1("load \"%1\";").arg(fileName);
+}
+
 OCTAVE_EXT_CDTOR(Packaging)
 
 QString OctavePackagingExtension::importPackage(const QString& package)
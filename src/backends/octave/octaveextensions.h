@@ -27,6 +27,7 @@ class OctaveScriptExtension : public Cantor::ScriptExtension
     QString highlightingMode() override;
     QString runExternalScript(const QString& path) override;
     QString commandSeparator() override;
+    QString commentStartingSequence() override;
 };
 
 class OctavePlotExtension : public Cantor::PlotExtension
@@ -63,6 +64,8 @@ class OctaveVariableManagementExtension : public Cantor::VariableManagementExten
     QString saveVariables(const QString& fileName) override;
     QString loadVariables(const QString& fileName) override;
     QString clearVariables() override;
+    QString saveSessionState(const QString& fileName) override;
+    QString restoreSessionState(const QString& fileName) override;
 };
 
 class OctavePackagingExtension : public Cantor::PackagingExtension
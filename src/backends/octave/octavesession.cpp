@@ -25,7 +25,6 @@
 #include <QTimer>
 #include <QFile>
 #include <QDir>
-#include <QStringRef>
 
 #ifndef Q_OS_WIN
 #include <signal.h>
@@ -35,11 +34,16 @@
 
 const QRegularExpression OctaveSession::PROMPT_UNCHANGEABLE_COMMAND = QRegularExpression(QStringLiteral("^(?:,|;)+$"));
 
-OctaveSession::OctaveSession(Cantor::Backend* backend) : Session(backend),
-m_prompt(QStringLiteral("CANTOR_OCTAVE_BACKEND_PROMPT:([0-9]+)> ")),
-m_subprompt(QStringLiteral("CANTOR_OCTAVE_BACKEND_SUBPROMPT:([0-9]+)> "))
+static const QByteArray PROMPT_MARKER("CANTOR_OCTAVE_BACKEND_PROMPT:");
+static const QByteArray SUBPROMPT_MARKER("CANTOR_OCTAVE_BACKEND_SUBPROMPT:");
+static const QByteArray PROMPT_END("> ");
+
+OctaveSession::OctaveSession(Cantor::Backend* backend) : Session(backend)
 {
     setVariableModel(new OctaveVariableModel(this));
+
+    // the buffer keeps its capacity between the results, large outputs don't need to reallocate on every read
+    m_outputBuffer.reserve(64 * 1024);
 }
 
 OctaveSession::~OctaveSession()
@@ -116,29 +120,7 @@ void OctaveSession::login()
     }
 
     if (!m_worksheetPath.isEmpty())
-    {
-        static const QString mfilenameTemplate = QLatin1String(
-            "function retval = mfilename(arg_mem = \"\")\n"
-                "type_info=typeinfo(arg_mem);\n"
-                "if (strcmp(type_info, \"string\"))\n"
-                    "if (strcmp(arg_mem, \"fullpath\"))\n"
-                        "retval = \"%1\";\n"
-                    "elseif (strcmp(arg_mem, \"fullpathext\"))\n"
-                        "retval = \"%2\";\n"
-                    "else\n"
-                        "retval = \"script\";\n"
-                    "endif\n"
-                "else\n"
-                    "error(\"wrong type argument '%s'\", type_info)\n"
-                "endif\n"
-            "endfunction"
-        );
-        const QString& worksheetDirPath = QFileInfo(m_worksheetPath).absoluteDir().absolutePath();
-        const QString& worksheetPathWithoutExtension = m_worksheetPath.mid(0, m_worksheetPath.lastIndexOf(QLatin1Char('.')));
-
-        evaluateExpression(QLatin1String("cd ")+worksheetDirPath, OctaveExpression::DeleteOnFinish, true);
-        evaluateExpression(mfilenameTemplate.arg(worksheetPathWithoutExtension, m_worksheetPath), OctaveExpression::DeleteOnFinish, true);
-    }
+        applyWorksheetPath();
 
     changeStatus(Cantor::Session::Done);
     emit loginDone();
@@ -148,6 +130,38 @@ void OctaveSession::login()
 void OctaveSession::setWorksheetPath(const QString& path)
 {
     m_worksheetPath = path;
+
+    // a session taken from the session pool is logged in before the worksheet is known
+    if (m_process && status() != Cantor::Session::Disable && !m_worksheetPath.isEmpty())
+        applyWorksheetPath();
+}
+
+/*!
+ * changes to the directory of the worksheet and defines mfilename() returning its path
+ */
+void OctaveSession::applyWorksheetPath()
+{
+    static const QString mfilenameTemplate = QLatin1String(
+        "function retval = mfilename(arg_mem = \"\")\n"
+            "type_info=typeinfo(arg_mem);\n"
+            "if (strcmp(type_info, \"string\"))\n"
+                "if (strcmp(arg_mem, \"fullpath\"))\n"
+                    "retval = \"%1\";\n"
+                "elseif (strcmp(arg_mem, \"fullpathext\"))\n"
+                    "retval = \"%2\";\n"
+                "else\n"
+                    "retval = \"script\";\n"
+                "endif\n"
+            "else\n"
+                "error(\"wrong type argument '%s'\", type_info)\n"
+            "endif\n"
+        "endfunction"
+    );
+    const QString& worksheetDirPath = QFileInfo(m_worksheetPath).absoluteDir().absolutePath();
+    const QString& worksheetPathWithoutExtension = m_worksheetPath.mid(0, m_worksheetPath.lastIndexOf(QLatin1Char('.')));
+
+    evaluateExpression(QLatin1String("cd ")+worksheetDirPath, OctaveExpression::DeleteOnFinish, true);
+    evaluateExpression(mfilenameTemplate.arg(worksheetPathWithoutExtension, m_worksheetPath), OctaveExpression::DeleteOnFinish, true);
 }
 
 void OctaveSession::logout()
@@ -189,6 +203,7 @@ void OctaveSession::logout()
     expressionQueue().clear();
 
     m_output.clear();
+    clearOutputBuffer();
     m_previousPromptNumber = 1;
 
     Session::logout();
@@ -220,6 +235,7 @@ void OctaveSession::interrupt()
         // If we move this code for interruption to Session, we need add function for
         // cleaning before setting Done status
         m_output.clear();
+        clearOutputBuffer();
         m_process->write("\n");
 
         qDebug()<<"done interrupting";
@@ -264,6 +280,17 @@ void OctaveSession::runFirstExpression()
 }
 
 void OctaveSession::readError()
+{
+    if (parseErrorOutput())
+    {
+        // drop the output received so far, a prompt not completely received yet doesn't contain any line break
+        const int removed = m_outputBuffer.lastIndexOf('\n') + 1;
+        m_outputBuffer.remove(0, removed);
+        m_scanPosition = qMax(0, m_scanPosition - removed);
+    }
+}
+
+bool OctaveSession::parseErrorOutput()
 {
     QString error = QString::fromLocal8Bit(m_process->readAllStandardError());
     if (!expressionQueue().isEmpty() && !error.isEmpty())
@@ -278,44 +305,69 @@ void OctaveSession::readError()
             exp->parseError(error);
 
         m_output.clear();
+        return true;
     }
+
+    return false;
 }
 
+/*!
+ * reads the output of octave in blocks. The blocks are collected in the buffer until the prompt
+ * marking the end of the result was received, the result is passed to the expression at once.
+ * The prompt is searched in the raw bytes, the already scanned part of the buffer is not searched again.
+ */
 void OctaveSession::readOutput()
 {
-    while (m_process->bytesAvailable() > 0)
+    m_outputBuffer.append(m_process->readAllStandardOutput());
+    if (!expressionQueue().isEmpty())
+        expressionQueue().first()->markTime(Cantor::Expression::FirstOutputTime);
+
+    while (true)
     {
-        QString line = QString::fromLocal8Bit(m_process->readLine());
+        const int promptStart = m_outputBuffer.indexOf(PROMPT_MARKER, m_scanPosition);
+        const int subpromptStart = m_outputBuffer.indexOf(SUBPROMPT_MARKER, m_scanPosition);
 
-        qDebug()<<"start parsing " << "  " << line;
-        QRegularExpressionMatch match = m_prompt.match(line);
-        if (match.hasMatch())
+        int start = promptStart;
+        int markerSize = PROMPT_MARKER.size();
+        if (subpromptStart != -1 && (promptStart == -1 || subpromptStart < promptStart))
         {
-            const int promptNumber = match.captured(1).toInt();
-            // Add all text before prompt, if exists
-            m_output += QStringRef(&line, 0, match.capturedStart(0)).toString();
-            if (!expressionQueue().isEmpty())
-            {
-                const QString& command = expressionQueue().first()->command();
-                if (m_previousPromptNumber + 1 == promptNumber || isSpecialOctaveCommand(command))
-                {
-                    if (!expressionQueue().isEmpty())
-                    {
-                        readError();
-                        expressionQueue().first()->parseOutput(m_output);
-                    }
-                }
-                else
-                {
-                    // Error command don't increase octave prompt number (usually, but not always)
-                    readError();
-                }
-            }
-            m_previousPromptNumber = promptNumber;
-            m_output.clear();
+            start = subpromptStart;
+            markerSize = SUBPROMPT_MARKER.size();
         }
-        else if ((match = m_subprompt.match(line)).hasMatch()
-                 && match.captured(1).toInt() == m_previousPromptNumber)
+
+        if (start == -1)
+        {
+            // the end of the buffer can contain the beginning of a marker, scan it again with the next block
+            m_scanPosition = qMax(m_scanPosition, m_outputBuffer.size() - SUBPROMPT_MARKER.size());
+            return;
+        }
+
+        const int numberEnd = m_outputBuffer.indexOf(PROMPT_END, start + markerSize);
+        if (numberEnd == -1)
+        {
+            // the prompt is not complete yet
+            m_scanPosition = start;
+            return;
+        }
+
+        bool ok = false;
+        const int promptNumber = m_outputBuffer.mid(start + markerSize, numberEnd - start - markerSize).toInt(&ok);
+        const int promptEnd = numberEnd + PROMPT_END.size();
+        if (!ok)
+        {
+            // some output looking like a prompt, not the prompt itself
+            m_scanPosition = start + markerSize;
+            continue;
+        }
+
+        if (start == promptStart)
+        {
+            const QString& output = QString::fromLocal8Bit(m_outputBuffer.constData(), start);
+            m_outputBuffer.remove(0, promptEnd);
+            m_scanPosition = 0;
+            processPrompt(output, promptNumber);
+        }
+        else if (promptNumber == m_previousPromptNumber)
         {
             // User don't write finished octave statement (for example, write 'a = [1,2, ' only), so
             // octave print subprompt and waits input finish.
@@ -323,10 +375,43 @@ void OctaveSession::readOutput()
             qDebug() << "subprompt catch";
             m_process->write(")]'\"\n"); // force exit from subprompt
             m_output.clear();
+            m_outputBuffer.remove(0, promptEnd);
+            m_scanPosition = 0;
+        }
+        else
+            m_scanPosition = promptEnd;
+    }
+}
+
+void OctaveSession::processPrompt(const QString& output, int promptNumber)
+{
+    // Add all text before prompt, if exists
+    m_output += output;
+
+    if (!expressionQueue().isEmpty())
+    {
+        const QString& command = expressionQueue().first()->command();
+        if (m_previousPromptNumber + 1 == promptNumber || isSpecialOctaveCommand(command))
+        {
+            parseErrorOutput();
+            if (!expressionQueue().isEmpty())
+                expressionQueue().first()->parseOutput(m_output);
         }
         else
-            m_output += line;
+        {
+            // Error command don't increase octave prompt number (usually, but not always)
+            parseErrorOutput();
+        }
     }
+    m_previousPromptNumber = promptNumber;
+    m_output.clear();
+}
+
+void OctaveSession::clearOutputBuffer()
+{
+    // resize() instead of clear() to keep the reserved capacity
+    m_outputBuffer.resize(0);
+    m_scanPosition = 0;
 }
 
 Cantor::CompletionObject* OctaveSession::completionFor(const QString& cmd, int index)
@@ -44,8 +44,8 @@ class OctaveSession : public Cantor::Session
     private:
         QProcess* m_process{nullptr};
         QTextStream m_stream;
-        QRegularExpression m_prompt;
-        QRegularExpression m_subprompt;
+        QByteArray m_outputBuffer; // raw output of octave not processed yet
+        int m_scanPosition{0}; // position in m_outputBuffer to continue the search for the prompt at
         int m_previousPromptNumber{1};
         bool m_syntaxError{false};
         QString m_output;
@@ -56,9 +56,13 @@ class OctaveSession : public Cantor::Session
 
     private:
         void readFromOctave(QByteArray);
+        void processPrompt(const QString& output, int promptNumber);
+        void clearOutputBuffer();
+        bool parseErrorOutput();
         bool isDoNothingCommand(const QString&);
         bool isSpecialOctaveCommand(const QString&);
         void checkWritableTempFolder();
+        void applyWorksheetPath();
 
     private Q_SLOTS:
         void readOutput();
@@ -20,44 +20,22 @@ OctaveVariableModel::OctaveVariableModel(OctaveSession* session): DefaultVariabl
 
 void OctaveVariableModel::update()
 {
-    static const QString code = QString::fromLatin1(
-        "printf('__cantor_delimiter_line__');"
-        "__cantor_list__ = who();"
-        "__cantor_split_var__ = split_long_rows(0);"
-        "__cantor_parse_values__ = %1;"
-        "for __cantor_index__ = 1:length(__cantor_list__)"
-        "  __cantor_varname__ = char(__cantor_list__{__cantor_index__});"
-        "  printf([__cantor_varname__ '\\n']);"
-        "  if (__cantor_parse_values__)"
-        "    try"
-        "      eval(['__cantor_string__ = disp(' __cantor_varname__ ');']);"
-        "      printf([num2str(eval(['sizeof(' __cantor_varname__ ');'])) '\\n']);"
-        "      printf([eval(['typeinfo(' __cantor_varname__ ');']) '\\n']);"
-        "      printf([num2str(eval(['rows(' __cantor_varname__ ');'])) '\\n']);"
-        "      printf([num2str(eval(['columns(' __cantor_varname__ ');'])) '\\n']);"
-        "      printf(__cantor_string__);"
-        "    catch"
-        "      printf(['<unprintable value>' '\\n']);"
-        "      printf(['0' '\\n']);"
-        "    end_try_catch;"
-        "  else"
-        "    printf('');"
-        "  endif;"
-        "  printf('__cantor_delimiter_line__');"
-        "endfor;"
-        "split_long_rows(__cantor_split_var__);"
-        "clear __cantor_list__;"
-        "clear __cantor_index__;"
-        "clear __cantor_varname__;"
-        "clear __cantor_parse_values__;"
-        "clear __cantor_string__;"
-        "clear __cantor_split_var__;"
-    );
+    // values are only printed for variables up to this size, the refresh doesn't depend on the size of the workspace
+    static const int maxValueBytes = 64 * 1024;
+    static const int maxValueLength = 1000;
 
     if (m_expr)
         return;
 
-    const QString& cmd = code.arg(OctaveSettings::self()->variableManagement() ? QLatin1String("true") : QLatin1String("false"));
+    // the state of the previous call is lost on restarts, start from scratch when we don't know the variables.
+    // m_resetPending is cleared when the output of this call is parsed, so a failed call is followed by a full update
+    const bool reset = m_resetPending || m_knownVariables.isEmpty();
+
+    const QString& cmd = QString::fromLatin1("cantor_variables(%1, %2, %3, %4);").arg(
+        OctaveSettings::self()->variableManagement() ? QLatin1String("true") : QLatin1String("false"),
+        QString::number(maxValueBytes),
+        QString::number(maxValueLength),
+        reset ? QLatin1String("true") : QLatin1String("false"));
     m_expr = session()->evaluateExpression(cmd, Expression::FinishingBehavior::DoNotDelete, true);
     connect(m_expr, &Expression::statusChanged, this, &OctaveVariableModel::parseNewVariables);
 }
@@ -68,58 +46,75 @@ void OctaveVariableModel::parseNewVariables(Expression::Status status)
     {
         case Expression::Status::Done:
         {
-            static const QLatin1String delimiter("__cantor_delimiter_line__");
+            static const QLatin1String header("__cantor_variables__\n");
 
             if (m_expr->results().isEmpty())
             {
                 qWarning() << "Octave code for parsing variables finish with done status, but without results";
+                m_resetPending = true;
                 break;
             }
 
-            QString text = static_cast<Cantor::TextResult*>(m_expr->result())->plain();
-            const QStringList& variableData = text.split(delimiter, QString::SkipEmptyParts);
-            QList<Variable> vars;
-
-            for (const auto& data : variableData)
+            const QString& text = static_cast<Cantor::TextResult*>(m_expr->result())->plain();
+            const int start = text.indexOf(header);
+            if (start == -1)
             {
-                // every variable data has 4 parts/elements separated by a new line - the name of the variable, its size, type and the actual value
-                const auto& elements = data.split(QLatin1String("\n"), QString::SkipEmptyParts);
-                int count = elements.count();
-                if (count < 6)
-                    continue;
-
-                const QString& name = elements.constFirst();
+                qWarning() << "unexpected output of the Octave code for parsing variables" << text.left(200);
+                m_resetPending = true;
+                break;
+            }
 
-                // skip the output of results that are not assigned to any varialbe ("ans" used by Octave)
-                if (name == QStringLiteral("ans"))
-                    continue;
+            // every line has the name, the type, the dimensions, the size and the value of the variable
+            // separated by tabs or only the name for the variables not changed since the last update
+            const QVector<QStringRef>& lines = text.midRef(start + header.size()).split(QLatin1Char('\n'), QString::SkipEmptyParts);
+            QHash<QString, Variable> knownVariables;
+            QList<Variable> vars;
+            bool outOfSync = false;
 
-                const QString& size = elements.at(1);
-                const QString& type = elements.at(2);
-                const QString& rows = elements.at(3);
-                const QString& columns = elements.at(4);
+            for (const auto& line : lines)
+            {
+                const QVector<QStringRef>& elements = line.split(QLatin1Char('\t'));
+                const QString& name = elements.constFirst().toString();
 
-                // the last section(s) contain(s) the value (single-line or multi-line output)
-                QString value;
-                if (OctaveSettings::self()->variableManagement())
+                if (elements.size() == 1)
                 {
-                    for (int i = 5; i < count; ++i)
+                    const auto it = m_knownVariables.constFind(name);
+                    if (it == m_knownVariables.constEnd())
                     {
-                        if (!value.isEmpty())
-                            value += QStringLiteral("; "); // separate multi-line values like in column vectors or in matrices by a semicolon
-                        value += elements.at(i).trimmed();
+                        // out of sync with Octave, request the complete data with the next update
+                        outOfSync = true;
+                        continue;
                     }
+                    vars << it.value();
+                    knownVariables.insert(name, it.value());
+                    continue;
                 }
 
-                value = value.replace(QStringLiteral("   "), QStringLiteral(" ")); // for vectors Octave is separating the values with three blanks, replace with one
-                vars << Variable(name, value, size.toULongLong(), type, rows + QStringLiteral("x") + columns);
+                if (elements.size() < 5)
+                    continue;
+
+                QString value = elements.at(4).toString();
+                value.replace(QStringLiteral("   "), QStringLiteral(" ")); // for vectors Octave is separating the values with three blanks, replace with one
+
+                const Variable var(name, value, elements.at(3).toULongLong(), elements.at(1).toString(), elements.at(2).toString());
+                vars << var;
+                knownVariables.insert(name, var);
             }
 
+            // the variables are only committed after the complete output was parsed
+            m_resetPending = outOfSync;
+            m_knownVariables = knownVariables;
             setVariables(vars);
             break;
         }
+        // Octave remembers the variables of this call already, the next call
+        // has to send all of them again, since their output got lost
         case Expression::Status::Error:
             qWarning() << "Octave code for parsing variables finish with error message: " << m_expr->errorMessage();
+            m_resetPending = true;
+            break;
+        case Expression::Status::Interrupted:
+            m_resetPending = true;
             break;
 
         default:
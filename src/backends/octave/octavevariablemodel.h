@@ -9,6 +9,8 @@
 
 #include "defaultvariablemodel.h"
 
+#include <QHash>
+
 class OctaveSession;
 
 class OctaveVariableModel : public Cantor::DefaultVariableModel
@@ -24,6 +26,8 @@ class OctaveVariableModel : public Cantor::DefaultVariableModel
 
   private:
     Cantor::Expression* m_expr = nullptr;
+    QHash<QString, Variable> m_knownVariables; // variables as last sent by Octave, unchanged ones are only sent by their name
+    bool m_resetPending = true;
 };
 
 #endif /* _OCTAVEVARIABLEMODEL_H */
@@ -0,0 +1,12 @@
+%{
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+%}
+
+% Announces the plot file to Cantor, must be called after the file was written and closed
+function cantor_plot_written(path, mime)
+  [info, err] = stat(path);
+  if (err == 0 && info.size > 0)
+    printf("__cantor_plot__:%s\t%s\t%d\n", path, mime, info.size);
+  endif
+endfunction
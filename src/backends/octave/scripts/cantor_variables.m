@@ -0,0 +1,68 @@
+%{
+    SPDX-FileCopyrightText: 2026 Cantor authors
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+%}
+
+% Prints one line per variable of the caller's workspace:
+%   name<TAB>type<TAB>dimensions<TAB>bytes<TAB>preview
+% The preview is only computed for numeric, logical, char and cell values not larger
+% than max_bytes and is truncated to max_chars characters.
+% Variables unchanged since the previous call are printed with their name only.
+% The state of a call is only compared with after Cantor parsed its output, which
+% the next call without reset confirms. reset forgets the state of the previous call.
+function cantor_variables(parse_values, max_bytes, max_chars, reset)
+  persistent previous = struct();
+  persistent pending = struct();
+  if (reset)
+    previous = struct();
+  else
+    previous = pending;
+  endif
+
+  names = evalin('caller', 'who()');
+  split = split_long_rows(0);
+  current = struct();
+  lines = cell(1, numel(names));
+  count = 0;
+
+  for i = 1:numel(names)
+    name = names{i};
+    if (strcmp(name, 'ans'))
+      continue;
+    endif
+
+    value = evalin('caller', name);
+    bytes = sizeof(value);
+    preview = '';
+    if (parse_values && bytes <= max_bytes
+        && (isnumeric(value) || islogical(value) || ischar(value) || iscell(value)))
+      try
+        preview = strtrim(disp(value));
+        preview = regexprep(preview, '\s*\n\s*', '; ');
+        preview = strrep(preview, "\t", ' ');
+        if (numel(preview) > max_chars)
+          preview = [preview(1:max_chars) '...'];
+        endif
+      catch
+        preview = '<unprintable value>';
+      end_try_catch
+    endif
+
+    dims = sprintf('%dx', size(value));
+    record = sprintf("%s\t%s\t%d\t%s", typeinfo(value), dims(1:end-1), bytes, preview);
+    current.(name) = record;
+
+    count++;
+    if (isfield(previous, name) && strcmp(previous.(name), record))
+      lines{count} = name;
+    else
+      lines{count} = [name "\t" record];
+    endif
+  endfor
+
+  split_long_rows(split);
+  pending = current;
+  printf("__cantor_variables__\n");
+  printf("%s\n", lines{1:count});
+endfunction
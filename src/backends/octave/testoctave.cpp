@@ -475,6 +475,38 @@ void TestOctave::testVariableChangeSizeType()
     QCOMPARE(model->index(0,3).data().toInt(), 8); // 8 bytes for a scalar value
 }
 
+void TestOctave::testVariableLargeValue()
+{
+    QAbstractItemModel* model = session()->variableModel();
+    QVERIFY(model != nullptr);
+
+    evalExp(QLatin1String("clear();"));
+
+    // the value of large variables is not printed, only their size
+    auto* e1 = evalExp(QLatin1String("big = ones(1000, 1000); small = 2;"));
+    QVERIFY(e1 != nullptr);
+
+    if(session()->status() == Cantor::Session::Running)
+        waitForSignal(session(), SIGNAL(statusChanged(Cantor::Session::Status)));
+
+    QCOMPARE(2, model->rowCount());
+    QCOMPARE(model->index(0,0).data().toString(), QLatin1String("big"));
+    QCOMPARE(model->index(0,1).data().toString(), QString());
+    QCOMPARE(model->index(0,3).data().toInt(), 8000000);
+
+    // the unchanged variable keeps its data, the changed one is updated
+    auto* e2 = evalExp(QLatin1String("small = 3;"));
+    QVERIFY(e2 != nullptr);
+
+    if(session()->status() == Cantor::Session::Running)
+        waitForSignal(session(), SIGNAL(statusChanged(Cantor::Session::Status)));
+
+    QCOMPARE(2, model->rowCount());
+    QCOMPARE(model->index(0,3).data().toInt(), 8000000);
+    QCOMPARE(model->index(1,0).data().toString(), QLatin1String("small"));
+    QCOMPARE(model->index(1,1).data().toString(), QLatin1String("3"));
+}
+
 void TestOctave::testVariableCreatingFromCodeWithPlot()
 {
     QAbstractItemModel* model = session()->variableModel();
@@ -535,6 +567,8 @@ void TestOctave::testPlot()
 
     QVERIFY(e->result() != nullptr);
     QCOMPARE(e->result()->type(), (int)Cantor::ImageResult::Type );
+    // the announcement of the plot file is not shown as text
+    QCOMPARE(e->results().size(), 1);
     QVERIFY(!e->result()->data().isNull());
     QVERIFY(e->errorMessage().isNull());
 }
@@ -626,5 +660,20 @@ void TestOctave::testRestartWhileRunning()
     QCOMPARE(cleanOutput(e2->result()->data().toString() ), QLatin1String("ans = 4"));
 }
 
+void TestOctave::benchmarkLargeMatrixOutput()
+{
+    auto* e = evalExp(QLatin1String("A = ones(2000, 2000);"));
+    QVERIFY(e != nullptr);
+
+    QBENCHMARK {
+        e = evalExp(QLatin1String("A"));
+
+        QVERIFY(e != nullptr);
+        QCOMPARE(e->status(), Cantor::Expression::Done);
+        QVERIFY(e->result() != nullptr);
+        QVERIFY(e->result()->data().toString().size() > 2000 * 2000);
+    }
+}
+
 QTEST_MAIN( TestOctave )
 
@@ -55,6 +55,7 @@ private Q_SLOTS:
     void testVariablesMultiRowValues();
     void testVariableChangeSizeType();
     void testVariableCleanupAfterRestart();
+    void testVariableLargeValue();
     void testVariableCreatingFromCodeWithPlot();
 
     //tests doing a plot
@@ -64,6 +65,9 @@ private Q_SLOTS:
 
     void testLoginLogout();
     void testRestartWhileRunning();
+
+    //measures the processing of large outputs
+    void benchmarkLargeMatrixOutput();
 private:
     QString backendName() override;
 };
@@ -0,0 +1,41 @@
+def _cantor_plot_written(path, mime):
+  """Announces the plot file to Cantor, must be called after the file was written and closed"""
+  import os
+  if os.path.isfile(path) and os.path.getsize(path) > 0:
+    print('__cantor_plot__:%s\t%s\t%d' % (path, mime, os.path.getsize(path)))
+
+def cantor_plot(x, *ys, names=()):
+  """Shows the numeric data as a plot rendered by Cantor, e.g. cantor_plot(x, y1, y2, names=('a', 'b'))"""
+  import os, struct, sys, tempfile
+  if not ys:
+    ys = (x,)
+    x = range(len(x))
+  def values(data):
+    try:
+      import numpy
+      return numpy.ascontiguousarray(data, dtype='<f8').tobytes()
+    except ImportError:
+      import array
+      a = array.array('d', data)
+      if sys.byteorder == 'big':
+        a.byteswap()
+      return a.tobytes()
+  xData = values(x)
+  # the file is removed by Cantor together with the plot result
+  fd, path = tempfile.mkstemp(prefix='cantor_plot_', suffix='.cantorplot')
+  try:
+    with os.fdopen(fd, 'wb') as f:
+      f.write(b'CANTPLT1' + struct.pack('<II', len(ys), 0))
+      for i, y in enumerate(ys):
+        name = (names[i] if i < len(names) else '').encode('utf-8')
+        yData = values(y)
+        if len(yData) != len(xData):
+          raise ValueError('x and y must have the same length')
+        f.write(struct.pack('<IIQ', len(name), 0, len(xData) // 8))
+        f.write(name + b'\0' * (-len(name) % 8))
+        f.write(xData)
+        f.write(yData)
+  except:
+    os.remove(path)
+    raise
+  _cantor_plot_written(path, 'application/x-cantor-plot')
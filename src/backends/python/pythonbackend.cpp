@@ -54,7 +54,8 @@ Cantor::Backend::Capabilities PythonBackend::capabilities() const
         Cantor::Backend::SyntaxHighlighting |
         Cantor::Backend::Completion         |
         Cantor::Backend::SyntaxHelp         |
-        Cantor::Backend::IntegratedPlots;
+        Cantor::Backend::IntegratedPlots    |
+        Cantor::Backend::PipelinedEvaluation;
 
     if(PythonSettings::variableManagement())
         cap |= Cantor::Backend::VariableManagement;
@@ -80,12 +81,21 @@ KConfigSkeleton* PythonBackend::config() const
 
 bool PythonBackend::requirementsFullfilled(QString* const reason) const
 {
+    QString name;
+    QString path;
+    requiredExecutable(&name, &path);
+    return name.isEmpty() || Cantor::Backend::checkExecutable(name, path, reason);
+}
+
+bool PythonBackend::requiredExecutable(QString* name, QString* path) const
+{
+    *name = QLatin1String("Cantor Python Server");
 #ifdef Q_OS_WIN
-    const QString& path = QStandardPaths::findExecutable(QLatin1String("cantor_pythonserver.exe"));
+    *path = QStandardPaths::findExecutable(QLatin1String("cantor_pythonserver.exe"));
 #else
-    const QString& path = QStandardPaths::findExecutable(QLatin1String("cantor_pythonserver"));
+    *path = QStandardPaths::findExecutable(QLatin1String("cantor_pythonserver"));
 #endif
-    return Cantor::Backend::checkExecutable(QLatin1String("Cantor Python Server"), path, reason);
+    return true;
 }
 
 K_PLUGIN_FACTORY_WITH_JSON(pythonbackend, "pythonbackend.json", registerPlugin<PythonBackend>();)
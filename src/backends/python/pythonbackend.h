@@ -24,6 +24,7 @@ class PythonBackend : public Cantor::Backend
     QUrl helpUrl() const override;
     QString description() const override;
     bool requirementsFullfilled(QString* const reason = nullptr) const override;
+    bool requiredExecutable(QString* name, QString* path) const override;
     KConfigSkeleton* config() const override;
 };
 
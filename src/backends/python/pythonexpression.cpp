@@ -106,8 +106,19 @@ void PythonExpression::parseOutput(const QString& output)
         QString resultStr = output;
         setResult(new Cantor::HelpResult(resultStr.remove(output.lastIndexOf(QLatin1String("None")), 4)));
     } else {
-        if (!output.isEmpty())
-            addResult(new Cantor::TextResult(output));
+        // the plots are announced in the output after their files were written
+        QString text = output;
+        const auto& plotFiles = takePlotFiles(text);
+        if (!text.isEmpty())
+            addResult(new Cantor::TextResult(text));
+
+        for (const auto& file : plotFiles)
+            addPlotResult(file);
+
+        // savefig() has closed its file when the command finished, it isn't announced in the output
+        // to keep the command of the user unchanged
+        if (m_tempFile && m_tempFile->size() > 0)
+            addPlotResult({m_tempFile->fileName(), QString(), -1});
      }
 
     setStatus(Cantor::Expression::Done);
@@ -133,7 +144,9 @@ void PythonExpression::parseWarning(const QString& warning)
 
 void PythonExpression::imageChanged()
 {
-    if(m_tempFile->size() <= 0)
+    // while the command is queued or running, also when it was already sent in a pipeline,
+    // the file may be still written, the plot is shown when it is announced in the output
+    if(status() != Done || !m_tempFile || m_tempFile->size() <= 0)
         return;
 
     auto* newResult = new Cantor::ImageResult(QUrl::fromLocalFile(m_tempFile->fileName()));
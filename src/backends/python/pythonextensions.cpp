@@ -289,6 +289,12 @@ QString PythonPlotExtension::plotFunction3d(const QString& function, const Varia
     return command;
 }
 
+QString PythonPlotExtension::plotData2d(const QString& x, const QString& y)
+{
+    // cantor_plot() is defined at the login of the session
+    return QString::fromLatin1("cantor_plot(%1, %2)").arg(x, y);
+}
+
 PYTHON_EXT_CDTOR(Script)
 
 QString PythonScriptExtension::runExternalScript(const QString& path)
@@ -337,3 +343,13 @@ QString PythonVariableManagementExtension::loadVariables(const QString& fileName
 {
     return fromSource(QLatin1String(":/py/variables_loader.py")).arg(fileName);
 }
+
+QString PythonVariableManagementExtension::saveSessionState(const QString& fileName)
+{
+    return fromSource(QLatin1String(":/py/session_state_saver.py")).arg(fileName);
+}
+
+QString PythonVariableManagementExtension::restoreSessionState(const QString& fileName)
+{
+    return fromSource(QLatin1String(":/py/session_state_loader.py")).arg(fileName);
+}
@@ -40,6 +40,7 @@ class PythonPlotExtension : public Cantor::PlotExtension
     PYTHON_EXT_CDTOR_DECL(Plot)
     QString plotFunction2d(const QString& function, const QString& variable, const QString& left, const QString& right) override;
     QString plotFunction3d(const QString& function, const VariableParameter& var1, const VariableParameter& var2) override;
+    QString plotData2d(const QString& x, const QString& y) override;
 };
 
 class PythonScriptExtension : public Cantor::ScriptExtension
@@ -61,6 +62,8 @@ class PythonVariableManagementExtension : public Cantor::VariableManagementExten
     QString saveVariables(const QString& fileName) override;
     QString loadVariables(const QString& fileName) override;
     QString clearVariables() override;
+    QString saveSessionState(const QString& fileName) override;
+    QString restoreSessionState(const QString& fileName) override;
 };
 
 #endif // PYTHONEXTENSIONS_H
@@ -24,6 +24,10 @@ string EXIT("exit");
 string CODE("code");
 string FILEPATH("setFilePath");
 string MODEL("model");
+string PIPELINED("pipelined");
+
+// pipeline whose remaining commands are skipped after an error or an interrupt
+string abortedPipeline;
 
 void signal_handler(int signal)
 {
@@ -100,6 +104,51 @@ int main()
                     isInterrupted = false;
                 }
             }
+            else if (records[0] == PIPELINED)
+            {
+                // the client sends the commands of a pipeline without waiting for the results,
+                // so the results are tagged and the remaining commands are skipped after an error
+                const vector<string>& args = split(records[1], unitSep);
+                if (args.size() == 3)
+                {
+                    const string& tag = args[0];
+                    const string& pipeline = args[1];
+                    if (pipeline == abortedPipeline)
+                    {
+                        const string& result = string() + unitSep + unitSep + "2" + unitSep + tag + messageEnd;
+                        std::cout << result.c_str();
+                    }
+                    else
+                    {
+                        server.runPythonCommand(args[2]);
+
+                        if (!isInterrupted)
+                        {
+                            const string& error = server.getError();
+                            if (server.isError() && !error.empty())
+                                abortedPipeline = pipeline;
+
+                            const string& result =
+                                server.getOutput()
+                                + unitSep
+                                + error
+                                + unitSep
+                                + to_string((int)server.isError())
+                                + unitSep
+                                + tag
+                                + messageEnd;
+
+                            std::cout << result.c_str();
+                        }
+                        else
+                        {
+                            // No replay when interrupted, the rest of the pipeline is dropped too
+                            isInterrupted = false;
+                            abortedPipeline = pipeline;
+                        }
+                    }
+                }
+            }
             else if (records[0] == MODEL)
             {
                 bool ok, val;
@@ -17,6 +17,7 @@
 
 #include <random>
 
+#include <QDateTime>
 #include <QDebug>
 #include <QDir>
 #include <QStandardPaths>
@@ -33,6 +34,9 @@ const QChar recordSep(30);
 const QChar unitSep(31);
 const QChar messageEnd = 29;
 
+// maximal number of pipelined expressions sent to the server ahead of their results
+static const int MaxPipelinedExpressions = 64;
+
 PythonSession::PythonSession(Cantor::Backend* backend) : Session(backend)
 {
     setVariableModel(new PythonVariableModel(this));
@@ -51,13 +55,27 @@ PythonSession::~PythonSession()
 void PythonSession::login()
 {
     qDebug()<<"login";
+
+    // the server is still starting
+    if (m_process && isHoldingExpressions())
+        return;
+
     emit loginStarted();
 
     if (m_process)
+    {
+        disconnect(m_process, nullptr, this, nullptr);
         m_process->deleteLater();
+    }
+
+    // the server is started asynchronously, the expressions are held back until it's ready
+    holdExpressions();
+    m_startOutput.clear();
 
     m_process = new QProcess(this);
     m_process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    connect(m_process, &QProcess::readyReadStandardOutput, this, &PythonSession::readServerStart);
+    connect(m_process, &QProcess::errorOccurred, this, &PythonSession::reportServerProcessError);
 
 #ifdef Q_OS_WIN
     const QString& serverExecutablePath = QStandardPaths::findExecutable(QLatin1String("cantor_pythonserver.exe"));
@@ -67,21 +85,21 @@ void PythonSession::login()
     const QString& serverExecutablePath = QStandardPaths::findExecutable(QLatin1String("cantor_pythonserver"));
     m_process->start(serverExecutablePath);
 #endif
+}
 
-    m_process->waitForStarted();
-    m_process->waitForReadyRead();
-    QTextStream stream(m_process->readAllStandardOutput());
-
-    const QString& readyStatus = QString::fromLatin1("ready");
-    while (m_process->state() == QProcess::Running)
-    {
-        const QString& rl = stream.readLine();
-        if (rl == readyStatus)
-            break;
-    }
+/*!
+ * reads the output of the starting server, the login is finished once the server is ready
+ */
+void PythonSession::readServerStart()
+{
+    m_startOutput += m_process->readAllStandardOutput();
+    if (!m_startOutput.contains("ready"))
+        return;
 
+    m_startOutput.clear();
+    disconnect(m_process, &QProcess::readyReadStandardOutput, this, &PythonSession::readServerStart);
     connect(m_process, &QProcess::readyReadStandardOutput, this, &PythonSession::readOutput);
-    connect(m_process, &QProcess::errorOccurred, this, &PythonSession::reportServerProcessError);
+    releaseExpressions();
 
     sendCommand(QLatin1String("login"));
     QString dir;
@@ -102,6 +120,7 @@ void PythonSession::login()
 
     m_plotFileCounter = 0;
     evaluateExpression(QLatin1String("__cantor_plot_global_counter__ = 0"), Cantor::Expression::DeleteOnFinish, true);
+    evaluateExpression(fromSource(QLatin1String(":/py/cantor_plot.py")), Cantor::Expression::DeleteOnFinish, true);
 
     const QStringList& scripts = PythonSettings::autorunScripts();
     if(!scripts.isEmpty()){
@@ -130,6 +149,7 @@ void PythonSession::logout()
     }
     m_process->deleteLater();
     m_process = nullptr;
+    m_pipelineTags.clear();
 
     if (!m_plotFilePrefixPath.isEmpty())
     {
@@ -161,6 +181,8 @@ void PythonSession::interrupt()
             expression->setStatus(Cantor::Expression::Interrupted);
         expressionQueue().clear();
 
+        // the server drops the rest of the interrupted pipeline
+        m_pipelineTags.clear();
         m_output.clear();
 
         qDebug()<<"done interrupting";
@@ -196,6 +218,23 @@ void PythonSession::runFirstExpression()
         return;
 
     auto* expr = expressionQueue().first();
+
+    // already sent to the server together with the previous expressions of its pipeline
+    if (m_pipelineTags.contains(expr))
+    {
+        expr->setStatus(Cantor::Expression::Computing);
+        runPipelinedExpressions();
+        return;
+    }
+
+    if (pipeline(expr) != 0 && supportsPipelining())
+    {
+        expr->setStatus(Cantor::Expression::Computing);
+        sendPipelinedExpression(expr);
+        runPipelinedExpressions();
+        return;
+    }
+
     const QString& command = expr->internalCommand();
     qDebug() << "run first expression" << command;
     expr->setStatus(Cantor::Expression::Computing);
@@ -206,7 +245,36 @@ void PythonSession::runFirstExpression()
         sendCommand(QLatin1String("model"), QStringList(arg));
     }
     else
-        sendCommand(QLatin1String("code"), QStringList(expr->internalCommand()));
+        sendCommand(QLatin1String("code"), QStringList(command));
+}
+
+void PythonSession::runPipelinedExpressions()
+{
+    const auto& queue = expressionQueue();
+    if (queue.isEmpty() || !m_pipelineTags.contains(queue.first()))
+        return;
+
+    // send the following expressions of the pipeline without waiting for the results of the previous ones
+    const int firstPipeline = pipeline(queue.first());
+    const int count = qMin(queue.size(), MaxPipelinedExpressions);
+    for (int i = 1; i < count; ++i)
+    {
+        auto* expr = queue.at(i);
+        if (pipeline(expr) != firstPipeline)
+            break;
+
+        if (!m_pipelineTags.contains(expr))
+            sendPipelinedExpression(expr);
+    }
+}
+
+void PythonSession::sendPipelinedExpression(Cantor::Expression* expr)
+{
+    // the expression is sent before it becomes the first one in the queue and changes to Computing
+    expr->markTime(Cantor::Expression::SentTime);
+    const int tag = ++m_pipelineTagCount;
+    m_pipelineTags.insert(expr, tag);
+    sendCommand(QLatin1String("pipelined"), QStringList() << QString::number(tag) << QString::number(pipeline(expr)) << expr->internalCommand());
 }
 
 void PythonSession::sendCommand(const QString& command, const QStringList arguments) const
@@ -224,6 +292,9 @@ void PythonSession::readOutput()
         m_output.append(QString::fromUtf8(bytes));
     }
 
+    if (!expressionQueue().isEmpty())
+        expressionQueue().first()->markTime(Cantor::Expression::FirstOutputTime);
+
     qDebug() << "m_output: " << m_output;
 
     if (!m_output.contains(messageEnd))
@@ -242,8 +313,30 @@ void PythonSession::readOutput()
 
         const QString& output = message.section(unitSep, 0, 0);
         const QString& error = message.section(unitSep, 1, 1);
-        bool isError = message.section(unitSep, 2, 2).toInt();
+        const int errorState = message.section(unitSep, 2, 2).toInt();
+        const QString& tag = message.section(unitSep, 3, 3);
         auto* expr = expressionQueue().first();
+        // the replies of the pipelined expressions following the first one arrived in the same block
+        expr->markTime(Cantor::Expression::FirstOutputTime);
+
+        if (!tag.isEmpty())
+        {
+            // the result of a pipelined expression, the results of the expressions
+            // removed from the queue after an error or an interrupt are dropped
+            if (m_pipelineTags.value(expr) != tag.toInt())
+                continue;
+            m_pipelineTags.remove(expr);
+
+            // skipped by the server after an error in the pipeline
+            if (errorState == 2)
+            {
+                expr->setStatus(Cantor::Expression::Interrupted);
+                finishFirstExpression(true);
+                continue;
+            }
+        }
+
+        const bool isError = errorState != 0;
         if (isError)
         {
             if(error.isEmpty()){
@@ -259,11 +352,29 @@ void PythonSession::readOutput()
         }
         finishFirstExpression(true);
     }
+
+    // forget the pipelined expressions which were removed from the queue after an error
+    for (auto it = m_pipelineTags.begin(); it != m_pipelineTags.end();)
+    {
+        if (!expressionQueue().contains(it.key()))
+            it = m_pipelineTags.erase(it);
+        else
+            ++it;
+    }
 }
 
 void PythonSession::setWorksheetPath(const QString& path)
 {
     m_worksheetPath = path;
+
+    // a session taken from the session pool is logged in before the worksheet is known
+    if (m_process && status() != Cantor::Session::Disable)
+    {
+        QString dir;
+        if (!m_worksheetPath.isEmpty())
+            dir = QFileInfo(m_worksheetPath).absoluteDir().absolutePath();
+        sendCommand(QLatin1String("setFilePath"), QStringList() << m_worksheetPath << dir);
+    }
 }
 
 void PythonSession::reportServerProcessError(QProcess::ProcessError serverError)
@@ -318,3 +429,22 @@ QString PythonSession::graphicPackageErrorMessage(QString packageId) const
     return QString();
 }
 
+
+QString PythonSession::graphicPackageProbeLabelCommand(const QString& label) const
+{
+    return QString::fromLatin1("print('%1')").arg(label);
+}
+
+QString PythonSession::interpreterId() const
+{
+    // the server embeds the interpreter, it is rebuilt or replaced for a new version of Python
+#ifdef Q_OS_WIN
+    const QString& serverExecutablePath = QStandardPaths::findExecutable(QLatin1String("cantor_pythonserver.exe"));
+#else
+    const QString& serverExecutablePath = QStandardPaths::findExecutable(QLatin1String("cantor_pythonserver"));
+#endif
+    if (serverExecutablePath.isEmpty())
+        return QString();
+
+    return serverExecutablePath + QLatin1Char(':') + QFileInfo(serverExecutablePath).lastModified().toString(Qt::ISODate);
+}
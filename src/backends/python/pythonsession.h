@@ -8,6 +8,7 @@
 #define _PYTHONSESSION_H
 
 #include "session.h"
+#include <QHash>
 #include <QStringList>
 #include <QProcess>
 
@@ -35,17 +36,26 @@ class PythonSession : public Cantor::Session
     QProcess* m_process{nullptr};
     QString m_worksheetPath;
     QString m_output;
+    QByteArray m_startOutput;
     QString m_plotFilePrefixPath;
     int m_plotFileCounter{0};
+    // tags of the pipelined expressions sent to the server and still waiting for their results
+    QHash<Cantor::Expression*, int> m_pipelineTags;
+    int m_pipelineTagCount{0};
 
   private Q_SLOT:
+    void readServerStart();
     void readOutput();
     void reportServerProcessError(QProcess::ProcessError);
 
   private:
     void runFirstExpression() override;
+    void runPipelinedExpressions() override;
+    void sendPipelinedExpression(Cantor::Expression*);
     void updateGraphicPackagesFromSettings();
     QString graphicPackageErrorMessage(QString packageId) const override;
+    QString graphicPackageProbeLabelCommand(const QString& label) const override;
+    QString interpreterId() const override;
 
     void sendCommand(const QString& command, const QStringList arguments = QStringList()) const;
 };
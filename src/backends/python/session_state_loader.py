@@ -0,0 +1,90 @@
+def __cantor_restore_session_state__(filename):
+    import builtins
+    import importlib
+    import importlib.util
+    import marshal
+    import pickle
+    import sys
+    import types
+    import zipfile
+
+    namespace = globals()
+    archive = zipfile.ZipFile(filename)
+    names = set(archive.namelist())
+
+    def read(name, default):
+        return pickle.loads(archive.read(name)) if name in names else default
+
+    modules = read('__cantor_modules__', {})
+    definitions = read('__cantor_definitions__', [])
+    incomplete = set(read('__cantor_incomplete__', []))
+
+    # the code objects can't be loaded by another version of the interpreter,
+    # the functions and classes of such a snapshot have to be evaluated again
+    if read('__cantor_version__', None) != (tuple(sys.version_info[:2]), importlib.util.MAGIC_NUMBER):
+        incomplete.update(name for name, kind, data in definitions)
+        definitions = []
+    names.difference_update(['__cantor_version__', '__cantor_modules__', '__cantor_definitions__', '__cantor_incomplete__'])
+
+    # the names not found in the globals are looked up in the builtins of the worksheet,
+    # so the modules are imported and the variables are unpickled from the snapshot on their first use
+    class CantorLazyBuiltins(dict):
+        def __missing__(self, name):
+            if name in self.__cantor_modules__:
+                value = importlib.import_module(self.__cantor_modules__.pop(name))
+            elif name in self.__cantor_pending__:
+                self.__cantor_pending__.discard(name)
+                value = pickle.loads(self.__cantor_archive__.read(name))
+            elif name in self.__cantor_incomplete__:
+                raise NameError("name '%s' couldn't be saved with the session state, evaluate its definition again" % name)
+            else:
+                raise KeyError(name)
+            return namespace.setdefault(name, value)
+
+    lazy = CantorLazyBuiltins(builtins.__dict__)
+    lazy.__cantor_archive__ = archive
+    lazy.__cantor_pending__ = names
+    lazy.__cantor_modules__ = modules
+    lazy.__cantor_incomplete__ = incomplete
+    namespace['__builtins__'] = lazy
+
+    def loadFunction(data, cell=None):
+        name, code, extra = data
+        code = marshal.loads(code)
+        defaults, kwdefaults, doc, qualname = pickle.loads(extra)
+        closure = tuple(cell for _ in code.co_freevars) if code.co_freevars else None
+        function = types.FunctionType(code, namespace, name, defaults, closure)
+        function.__kwdefaults__ = kwdefaults
+        function.__doc__ = doc
+        function.__qualname__ = qualname
+        return function
+
+    def loadClass(data):
+        name, bases, members = data
+        # the cell of "__class__" used by super() without arguments
+        cell = types.CellType()
+        attributes = {}
+        for key, kind, value in members:
+            if kind == 'function':
+                attributes[key] = loadFunction(value, cell)
+            elif kind == 'staticmethod':
+                attributes[key] = staticmethod(loadFunction(value, cell))
+            elif kind == 'classmethod':
+                attributes[key] = classmethod(loadFunction(value, cell))
+            elif kind == 'property':
+                attributes[key] = property(*[loadFunction(f, cell) if f else None for f in value])
+            else:
+                attributes[key] = pickle.loads(value)
+        cls = type(name, pickle.loads(bases), attributes)
+        cell.cell_contents = cls
+        return cls
+
+    # the definitions are needed to unpickle the objects of the classes defined in the worksheet
+    for name, kind, data in definitions:
+        try:
+            namespace[name] = loadFunction(data) if kind == 'function' else loadClass(data)
+        except Exception:
+            incomplete.add(name)
+
+__cantor_restore_session_state__('%1')
+del __cantor_restore_session_state__
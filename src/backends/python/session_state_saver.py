@@ -0,0 +1,84 @@
+def __cantor_save_session_state__(filename):
+    import importlib.util
+    import marshal
+    import os
+    import pickle
+    import sys
+    import types
+    import zipfile
+
+    namespace = globals()
+    lazy = namespace.get('__builtins__')
+    pending = getattr(lazy, '__cantor_pending__', set())
+    mainModule = namespace.get('__name__')
+
+    # the functions and classes defined in the worksheet can't be pickled by reference,
+    # the code objects of their functions are stored instead
+    def dumpFunction(function):
+        if function.__code__.co_freevars not in ((), ('__class__',)):
+            raise TypeError('closures are not supported')
+        return (function.__name__, marshal.dumps(function.__code__),
+                pickle.dumps((function.__defaults__, function.__kwdefaults__, function.__doc__, function.__qualname__)))
+
+    def dumpClass(cls):
+        if type(cls) is not type:
+            raise TypeError('metaclasses are not supported')
+        members = []
+        for key, value in cls.__dict__.items():
+            if key in ('__dict__', '__weakref__'):
+                continue
+            if isinstance(value, types.FunctionType):
+                members.append((key, 'function', dumpFunction(value)))
+            elif isinstance(value, (staticmethod, classmethod)):
+                members.append((key, type(value).__name__, dumpFunction(value.__func__)))
+            elif isinstance(value, property):
+                members.append((key, 'property', [dumpFunction(f) if f else None for f in (value.fget, value.fset, value.fdel)]))
+            else:
+                members.append((key, 'value', pickle.dumps(value)))
+        return (cls.__name__, pickle.dumps(cls.__bases__), members)
+
+    # imported modules by their names, e.g. "np" -> "numpy"
+    modules = dict((name, module) for name, module in getattr(lazy, '__cantor_modules__', {}).items() if name not in namespace)
+    # definitions in the order of the worksheet, they are restored before the variables
+    definitions = []
+    # names which couldn't be saved, the restored session tells to evaluate them again
+    incomplete = set(name for name in getattr(lazy, '__cantor_incomplete__', set()) if name not in namespace)
+
+    # one pickle per variable, so the variables can be restored one by one
+    with zipfile.ZipFile(filename + '.part', 'w', zipfile.ZIP_STORED, allowZip64=True) as archive:
+        for name, value in list(namespace.items()):
+            if name.startswith('_'):
+                continue
+            try:
+                if isinstance(value, types.ModuleType):
+                    modules[name] = value.__name__
+                elif isinstance(value, types.FunctionType) and value.__module__ == mainModule:
+                    definitions.append((name, 'function', dumpFunction(value)))
+                elif isinstance(value, type) and value.__module__ == mainModule:
+                    definitions.append((name, 'class', dumpClass(value)))
+                else:
+                    archive.writestr(name, pickle.dumps(value, protocol=pickle.HIGHEST_PROTOCOL))
+            except Exception:
+                incomplete.add(name)
+
+        # variables of the restored snapshot which weren't used yet
+        for name in pending:
+            if name not in namespace:
+                archive.writestr(name, lazy.__cantor_archive__.read(name))
+
+        # the format of the marshalled code objects depends on the version of the interpreter
+        archive.writestr('__cantor_version__', pickle.dumps((tuple(sys.version_info[:2]), importlib.util.MAGIC_NUMBER)))
+        archive.writestr('__cantor_modules__', pickle.dumps(modules))
+        archive.writestr('__cantor_definitions__', pickle.dumps(definitions))
+        archive.writestr('__cantor_incomplete__', pickle.dumps(sorted(incomplete)))
+
+    # the previous snapshot might be replaced, its pending variables are read from the new one
+    if hasattr(lazy, '__cantor_archive__'):
+        lazy.__cantor_archive__.close()
+    os.replace(filename + '.part', filename)
+    if hasattr(lazy, '__cantor_archive__'):
+        lazy.__cantor_archive__ = zipfile.ZipFile(filename)
+        lazy.__cantor_pending__ = set(name for name in pending if name not in namespace)
+
+__cantor_save_session_state__('%1')
+del __cantor_save_session_state__
@@ -6,14 +6,24 @@
 
 #include "testpython.h"
 
+#include "backend.h"
 #include "session.h"
+#include "extension.h"
 #include "expression.h"
 #include "imageresult.h"
+#include "plotresult.h"
 #include "defaultvariablemodel.h"
 #include "completionobject.h"
 
 #include "settings.h"
 
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+
 QString TestPython3::backendName()
 {
     return QLatin1String("python");
@@ -56,6 +66,86 @@ void TestPython3::testCommandQueue()
     QCOMPARE(cleanOutput(e3->result()->data().toString()), QLatin1String("3"));
 }
 
+void TestPython3::testPipelinedEvaluation()
+{
+    QVERIFY(session()->supportsPipelining());
+
+    // many tiny commands, evaluated one after another and as pipeline
+    const int count = 500;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < count; ++i)
+        evalExp(QString::fromLatin1("x = %1").arg(i));
+    const qint64 sequential = timer.elapsed();
+
+    timer.restart();
+    QVector<Cantor::Expression*> expressions;
+    session()->beginPipeline();
+    for (int i = 0; i < count; ++i)
+        expressions << session()->evaluateExpression(QString::fromLatin1("x = %1").arg(i));
+    expressions << session()->evaluateExpression(QLatin1String("x"));
+    session()->endPipeline();
+    if (expressions.last()->status() != Cantor::Expression::Done)
+        waitForSignal(expressions.last(), SIGNAL(expressionFinished(Cantor::Expression::Status)));
+    const qint64 pipelined = timer.elapsed();
+    qDebug() << count << "commands evaluated in" << sequential << "ms one after another and in" << pipelined << "ms pipelined";
+
+    // the results arrive in the order of the commands
+    QCOMPARE(expressions.last()->status(), Cantor::Expression::Done);
+    QVERIFY(expressions.last()->result());
+    QCOMPARE(cleanOutput(expressions.last()->result()->data().toString()), QString::number(count - 1));
+
+    // the commands following a failed one are not evaluated
+    session()->beginPipeline();
+    auto* e1 = session()->evaluateExpression(QLatin1String("y = 1"));
+    auto* e2 = session()->evaluateExpression(QLatin1String("raise ValueError('failed')"));
+    auto* e3 = session()->evaluateExpression(QLatin1String("y = 3"));
+    session()->endPipeline();
+    if (e2->status() != Cantor::Expression::Error)
+        waitForSignal(e2, SIGNAL(expressionFinished(Cantor::Expression::Status)));
+
+    QCOMPARE(e1->status(), Cantor::Expression::Done);
+    QCOMPARE(e2->status(), Cantor::Expression::Error);
+    QCOMPARE(e3->status(), Cantor::Expression::Interrupted);
+
+    auto* e = evalExp(QLatin1String("y"));
+    QVERIFY(e->result());
+    QCOMPARE(cleanOutput(e->result()->data().toString()), QLatin1String("1"));
+
+    evalExp(QLatin1String("del x; del y"));
+}
+
+void TestPython3::testExpressionTiming()
+{
+    using Expression = Cantor::Expression;
+
+    auto* e = evalExp(QLatin1String("import time; time.sleep(0.2)"));
+    QVERIFY(e != nullptr);
+    QCOMPARE(e->status(), Expression::Done);
+
+    // the lifecycle is timestamped in order
+    QVERIFY(e->time(Expression::CreatedTime) >= 0);
+    QVERIFY(e->time(Expression::QueuedTime) >= e->time(Expression::CreatedTime));
+    QVERIFY(e->time(Expression::SentTime) >= e->time(Expression::QueuedTime));
+    QVERIFY(e->time(Expression::FirstOutputTime) >= e->time(Expression::SentTime));
+    QVERIFY(e->time(Expression::FinishedTime) >= e->time(Expression::FirstOutputTime));
+    QVERIFY(e->elapsed(Expression::SentTime, Expression::FinishedTime) >= 200 * 1000 * 1000);
+    QCOMPARE(e->time(Expression::RenderedTime), -1);
+
+    // the trace contains the whole evaluation and its stages
+    const auto& trace = QJsonDocument::fromJson(Expression::chromeTrace({e})).object();
+    QStringList names;
+    for (const auto& event : trace.value(QLatin1String("traceEvents")).toArray())
+    {
+        const auto& object = event.toObject();
+        if (object.value(QLatin1String("ph")).toString() != QLatin1String("X"))
+            continue;
+        names << object.value(QLatin1String("name")).toString();
+        QCOMPARE(object.value(QLatin1String("tid")).toInt(), e->id());
+    }
+    QCOMPARE(names, QStringList({QLatin1String("expression"), QLatin1String("queue"), QLatin1String("backend"), QLatin1String("output")}));
+}
+
 void TestPython3::testCommentExpression()
 {
     auto* e = evalExp(QLatin1String("#only comment"));
@@ -94,6 +184,80 @@ void TestPython3::testInvalidSyntax()
     QCOMPARE( e->status(), Cantor::Expression::Error );
 }
 
+void TestPython3::testSessionState()
+{
+    auto* ext = dynamic_cast<Cantor::VariableManagementExtension*>(session()->backend()->extension(QLatin1String("VariableManagementExtension")));
+    QVERIFY(ext != nullptr);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString& file = dir.filePath(QLatin1String("worksheet.cws.state"));
+
+    auto* e = evalExp(QLatin1String("state_value = [40 + 2, 'cantor']"));
+    QVERIFY(e != nullptr);
+    QVERIFY(e->errorMessage().isEmpty());
+
+    // the modules, functions and classes of the worksheet are restored too
+    e = evalExp(QLatin1String(
+        "import os.path as state_path\n"
+        "class StatePoint:\n"
+        "    def __init__(self, x):\n"
+        "        self.x = x\n"
+        "def state_twice(p):\n"
+        "    return 2 * p.x\n"
+        "state_point = StatePoint(21)"));
+    QVERIFY(e != nullptr);
+    QVERIFY(e->errorMessage().isEmpty());
+
+    e = evalExp(ext->saveSessionState(file));
+    QVERIFY(e != nullptr);
+    QVERIFY(e->errorMessage().isEmpty());
+    QVERIFY(QFile::exists(file));
+
+    evalExp(ext->clearVariables());
+    e = evalExp(ext->restoreSessionState(file));
+    QVERIFY(e != nullptr);
+    QVERIFY(e->errorMessage().isEmpty());
+
+    // the variable is read from the snapshot on its first use
+    e = evalExp(QLatin1String("print(state_value)"));
+    QVERIFY(e != nullptr);
+    QVERIFY(e->result() != nullptr);
+    QCOMPARE(e->result()->data().toString(), QLatin1String("[42, 'cantor']"));
+
+    e = evalExp(QLatin1String("print(state_twice(state_point), state_path.basename('/a/b'))"));
+    QVERIFY(e != nullptr);
+    QVERIFY(e->errorMessage().isEmpty());
+    QVERIFY(e->result() != nullptr);
+    QCOMPARE(e->result()->data().toString(), QLatin1String("42 b"));
+
+    // the code objects of a snapshot of another interpreter version are not loaded
+    evalExp(ext->clearVariables());
+    e = evalExp(QString::fromLatin1(
+        "import pickle as state_pickle, zipfile as state_zipfile\n"
+        "with state_zipfile.ZipFile('%1') as a, state_zipfile.ZipFile('%1.other', 'w') as b:\n"
+        "    for n in a.namelist():\n"
+        "        b.writestr(n, state_pickle.dumps(((2, 0), b'')) if n == '__cantor_version__' else a.read(n))\n"
+        "del state_pickle, state_zipfile").arg(file));
+    QVERIFY(e != nullptr);
+    QVERIFY(e->errorMessage().isEmpty());
+
+    e = evalExp(ext->restoreSessionState(file + QLatin1String(".other")));
+    QVERIFY(e != nullptr);
+    QVERIFY(e->errorMessage().isEmpty());
+
+    e = evalExp(QLatin1String("print(state_value)"));
+    QVERIFY(e != nullptr);
+    QVERIFY(e->result() != nullptr);
+    QCOMPARE(e->result()->data().toString(), QLatin1String("[42, 'cantor']"));
+
+    e = evalExp(QLatin1String("state_twice"));
+    QVERIFY(e != nullptr);
+    QVERIFY(e->errorMessage().contains(QLatin1String("evaluate its definition again")));
+
+    evalExp(ext->clearVariables());
+}
+
 void TestPython3::testCompletion()
 {
     if(session()->status()==Cantor::Session::Running)
@@ -112,6 +276,42 @@ void TestPython3::testCompletion()
 }
 
 
+void TestPython3::testNativePlot()
+{
+    auto* e = evalExp(QLatin1String("cantor_plot([1, 2, 3], [4, 5, 6], names=('data',))"));
+    QVERIFY(e != nullptr);
+
+    if (session()->status() == Cantor::Session::Running)
+        waitForSignal(session(), SIGNAL(statusChanged(Cantor::Session::Status)));
+
+    // the file is announced in the output, no text result is left
+    QCOMPARE(e->results().size(), 1);
+    auto* result = dynamic_cast<Cantor::PlotResult*>(e->result());
+    QVERIFY(result != nullptr);
+    QVERIFY(result->isValid());
+    QCOMPARE(result->seriesCount(), 1);
+    QCOMPARE(result->series(0).name, QLatin1String("data"));
+    QCOMPARE(result->series(0).count, qint64(3));
+    QCOMPARE(result->series(0).y[2], 6.0);
+}
+
+void TestPython3::testGraphicPackagesProbe()
+{
+    const auto& packages = session()->backend()->availableGraphicPackages();
+    QVERIFY(!packages.isEmpty());
+
+    // all packages are tested in one expression without blocking the caller
+    QSignalSpy spy(session(), &Cantor::Session::graphicPackagesTested);
+    session()->testGraphicsPackages(packages);
+    if (spy.isEmpty())
+        QVERIFY(spy.wait(5000));
+
+    QCOMPARE(spy.count(), 1);
+    const auto& availability = spy.first().first().value<QMap<QString, bool>>();
+    for (const auto& package : packages)
+        QVERIFY(availability.contains(package.id()));
+}
+
 void TestPython3::testImportStatement()
 {
     auto* e = evalExp(QLatin1String("import sys"));
@@ -16,8 +16,12 @@ class TestPython3 : public BackendTest
     void testMultilineCommand();
     void testCodeWithComments();
     void testCommandQueue();
+    void testPipelinedEvaluation();
+    void testExpressionTiming();
 
     void testSimplePlot();
+    void testNativePlot();
+    void testGraphicPackagesProbe();
 
     void testImportStatement();
     void testPython3Code();
@@ -31,6 +35,7 @@ class TestPython3 : public BackendTest
     void testVariableChangeSizeType();
     void testVariableCleanupAfterRestart();
     void testDictVariable();
+    void testSessionState();
 
     void testCompletion();
     void testInterrupt();
@@ -4,3 +4,10 @@ for keyPythonBackend in dir():
     del(globals()[keyPythonBackend])
 
 del(keyPythonBackend)
+
+# the variables, modules and definitions of a restored session state, which weren't used yet
+if hasattr(__builtins__, '__cantor_pending__'):
+    __builtins__.__cantor_pending__.clear()
+    __builtins__.__cantor_modules__.clear()
+    __builtins__.__cantor_incomplete__.clear()
+    __builtins__.__cantor_archive__.close()
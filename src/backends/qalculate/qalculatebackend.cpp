@@ -43,7 +43,7 @@ Cantor::Session* QalculateBackend::createSession()
 
 Cantor::Backend::Capabilities QalculateBackend::capabilities() const
 {
-    return Cantor::Backend::Completion | Cantor::Backend::SyntaxHighlighting | Cantor::Backend::SyntaxHelp | Cantor::Backend::VariableManagement;
+    return Cantor::Backend::LaTexOutput | Cantor::Backend::Completion | Cantor::Backend::SyntaxHighlighting | Cantor::Backend::SyntaxHelp | Cantor::Backend::VariableManagement;
 }
 
 QString QalculateBackend::description() const
@@ -63,8 +63,21 @@ QUrl QalculateBackend::helpUrl() const
 
 bool QalculateBackend::requirementsFullfilled(QString* const reason) const
 {
-    const QString& path = QalculateSettings::self()->path().toLocalFile();
-    return Cantor::Backend::checkExecutable(QLatin1String("Qalculate!"), path, reason);
+    QString name;
+    QString path;
+    requiredExecutable(&name, &path);
+    return name.isEmpty() || Cantor::Backend::checkExecutable(name, path, reason);
+}
+
+bool QalculateBackend::requiredExecutable(QString* name, QString* path) const
+{
+    // libqalculate is linked, qalc is only needed when running out of process
+    if (QalculateSettings::self()->inProcess())
+        return true;
+
+    *name = QLatin1String("Qalculate!");
+    *path = QalculateSettings::self()->path().toLocalFile();
+    return true;
 }
 
 KConfigSkeleton* QalculateBackend::config() const
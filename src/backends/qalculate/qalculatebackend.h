@@ -26,6 +26,7 @@ public:
     QString description() const override;
     QUrl helpUrl() const override;
     bool requirementsFullfilled(QString* const reason = nullptr) const override;
+    bool requiredExecutable(QString* name, QString* path) const override;
 
     QWidget* settingsWidget(QWidget* parent) const override;
     KConfigSkeleton* config() const override;
@@ -14,6 +14,7 @@
 #include <libqalculate/Function.h>
 
 #include "qalculatesession.h"
+#include "qalculateengine.h"
 
 QalculateCompletionObject::QalculateCompletionObject(const QString& command, int index, QalculateSession* session)
     : Cantor::CompletionObject(session)
@@ -23,6 +24,12 @@ QalculateCompletionObject::QalculateCompletionObject(const QString& command, int
 
 void QalculateCompletionObject::fetchIdentifierType()
 {
+    const QalculateCalculatorTryLocker locker;
+    if (!locker.isLocked()) {
+        emit fetchingTypeDone(UnknownType);
+        return;
+    }
+
     Variable* var = CALCULATOR->getVariable(identifier().toLatin1().data());
     if (var) {
         emit fetchingTypeDone(VariableType);
@@ -56,6 +63,15 @@ int QalculateCompletionObject::locateIdentifier(const QString& cmd, int index) c
 void QalculateCompletionObject::fetchCompletions()
 {
     QStringList comp;
+
+    // no completion while a calculation is running
+    const QalculateCalculatorTryLocker locker;
+    if (!locker.isLocked()) {
+        setCompletions(comp);
+        emit fetchingDone();
+        return;
+    }
+
     // Matching Qt::CaseInsensitive here does not help, because a) Qalculate
     // does distinguish cases, and b) KCompletion::makeCompletion matches
     // case sensitive.
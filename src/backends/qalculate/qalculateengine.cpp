@@ -0,0 +1,255 @@
+/*
+    SPDX-FileCopyrightText: 2026 Cantor authors
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "qalculateengine.h"
+
+#include <libqalculate/Function.h>
+#include <libqalculate/MathStructure.h>
+#include <libqalculate/Variable.h>
+
+#include <QDebug>
+#include <QMutexLocker>
+
+QalculateEngine::QalculateEngine()
+{
+    QMutexLocker locker(&calculatorMutex());
+
+    // the last answer, used by "store"/"save" like in qalc
+    Variable* ans = CALCULATOR->getActiveVariable("ans");
+    if (ans && ans->isKnown())
+        m_ans = static_cast<KnownVariable*>(ans);
+    else
+    {
+        MathStructure undefined;
+        undefined.setUndefined();
+        m_ans = static_cast<KnownVariable*>(CALCULATOR->addVariable(new KnownVariable("Temporary", "ans", undefined, "Last Answer", false)));
+    }
+}
+
+static QString latexEscaped(const QString& text)
+{
+    QString escaped;
+    for (const QChar c : text)
+    {
+        if (c == QLatin1Char('\\'))
+            escaped += QLatin1String("\\textbackslash{}");
+        else if (c == QLatin1Char('^') || c == QLatin1Char('~'))
+            escaped += QLatin1Char('\\') + c + QLatin1String("{}");
+        else if (QStringLiteral("{}$&#_%").contains(c))
+            escaped += QLatin1Char('\\') + c;
+        else
+            escaped += c;
+    }
+    return escaped;
+}
+
+/*!
+ * returns the LaTeX code of the formatted structure @p m, the structures
+ * without a LaTeX counterpart are written as they are printed by libqalculate
+ */
+static QString latexCode(const MathStructure& m, const PrintOptions& po)
+{
+    // the operands with a lower precedence than the operation are put in parentheses
+    auto operand = [&m, &po](size_t i, bool power) -> QString {
+        const QString& code = latexCode(m[i], po);
+        const QString& parenthesized = QLatin1String("\\left(") + code + QLatin1String("\\right)");
+        switch (m[i].type())
+        {
+            case STRUCT_ADDITION:
+            case STRUCT_NEGATE:
+            case STRUCT_COMPARISON:
+                return parenthesized;
+            case STRUCT_MULTIPLICATION:
+            case STRUCT_DIVISION:
+            case STRUCT_INVERSE:
+            case STRUCT_POWER:
+                return power ? parenthesized : code;
+            case STRUCT_NUMBER:
+                return power && code.startsWith(QLatin1Char('-')) ? parenthesized : code;
+            default:
+                return code;
+        }
+    };
+    auto operands = [&m, &po](const QString& separator) -> QString {
+        QStringList codes;
+        for (size_t i = 0; i < m.size(); ++i)
+            codes << latexCode(m[i], po);
+        return codes.join(separator);
+    };
+
+    switch (m.type())
+    {
+        case STRUCT_NUMBER:
+            return QString::fromStdString(m.number().print(po));
+        case STRUCT_ADDITION:
+        {
+            QString code = latexCode(m[0], po);
+            for (size_t i = 1; i < m.size(); ++i)
+            {
+                const QString& term = latexCode(m[i], po);
+                if (!term.startsWith(QLatin1Char('-')))
+                    code += QLatin1Char('+');
+                code += term;
+            }
+            return code;
+        }
+        case STRUCT_MULTIPLICATION:
+        {
+            QStringList factors;
+            for (size_t i = 0; i < m.size(); ++i)
+                factors << operand(i, false);
+            return factors.join(QLatin1String(" \\cdot "));
+        }
+        case STRUCT_INVERSE:
+            return QLatin1String("\\frac{1}{") + latexCode(m[0], po) + QLatin1Char('}');
+        case STRUCT_DIVISION:
+            return QLatin1String("\\frac{") + latexCode(m[0], po) + QLatin1String("}{") + latexCode(m[1], po) + QLatin1Char('}');
+        case STRUCT_NEGATE:
+            return QLatin1Char('-') + operand(0, false);
+        case STRUCT_POWER:
+            return QLatin1Char('{') + operand(0, true) + QLatin1String("}^{") + latexCode(m[1], po) + QLatin1Char('}');
+        case STRUCT_FUNCTION:
+        {
+            const QString& name = QString::fromStdString(m.function()->name());
+            if (name == QLatin1String("sqrt") && m.size() == 1)
+                return QLatin1String("\\sqrt{") + latexCode(m[0], po) + QLatin1Char('}');
+            return QLatin1String("\\mathrm{") + latexEscaped(name) + QLatin1String("}\\left(") + operands(QLatin1String(", ")) + QLatin1String("\\right)");
+        }
+        case STRUCT_VECTOR:
+            return QLatin1String("\\left[") + operands(QLatin1String(", ")) + QLatin1String("\\right]");
+        case STRUCT_COMPARISON:
+        {
+            QString comparison;
+            switch (m.comparisonType())
+            {
+                case COMPARISON_LESS: comparison = QLatin1String(" < "); break;
+                case COMPARISON_GREATER: comparison = QLatin1String(" > "); break;
+                case COMPARISON_EQUALS_LESS: comparison = QLatin1String(" \\le "); break;
+                case COMPARISON_EQUALS_GREATER: comparison = QLatin1String(" \\ge "); break;
+                case COMPARISON_NOT_EQUALS: comparison = QLatin1String(" \\neq "); break;
+                default: comparison = QLatin1String(" = "); break;
+            }
+            return latexCode(m[0], po) + comparison + latexCode(m[1], po);
+        }
+        case STRUCT_VARIABLE:
+        case STRUCT_SYMBOLIC:
+        case STRUCT_UNIT:
+        {
+            const QString& name = QString::fromStdString(m.print(po));
+            if (name == QLatin1String("pi"))
+                return QLatin1String("\\pi");
+            if (name.size() == 1 && name.at(0).isLetter())
+                return name;
+            return QLatin1String("\\mathrm{") + latexEscaped(name) + QLatin1Char('}');
+        }
+        default:
+            return QLatin1String("\\mbox{") + latexEscaped(QString::fromStdString(m.print(po))) + QLatin1Char('}');
+    }
+}
+
+QMutex& QalculateEngine::calculatorMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+void QalculateEngine::evaluate(int id, const QStringList& commands, const EvaluationOptions& eo, const PrintOptions& po, bool latex)
+{
+    QStringList output;
+    QStringList latexRows;
+    QStringList errors;
+
+    // the unicode signs can't be typeset by LaTeX
+    PrintOptions latexOptions = po;
+    latexOptions.use_unicode_signs = false;
+
+    QMutexLocker locker(&calculatorMutex());
+
+    for (const auto& command : commands)
+    {
+        if (command.trimmed().isEmpty())
+            continue;
+
+        // the calculation is blocking in this thread, with the control enabled
+        // CALCULATOR->abort() from the GUI thread stops it
+        MathStructure parsed;
+        CALCULATOR->startControl();
+        MathStructure result = CALCULATOR->calculate(command.toStdString(), eo, &parsed);
+        const bool aborted = CALCULATOR->aborted();
+        CALCULATOR->stopControl();
+
+        if (aborted)
+        {
+            CALCULATOR->clearMessages();
+            errors << QLatin1String("aborted");
+            break;
+        }
+
+        bool hasError = false;
+        for (CalculatorMessage* message = CALCULATOR->message(); message; message = CALCULATOR->nextMessage())
+        {
+            const QString& text = QString::fromStdString(message->message());
+            switch (message->type())
+            {
+                case MESSAGE_ERROR:
+                    errors << text;
+                    hasError = true;
+                    break;
+                case MESSAGE_WARNING:
+                    output << QLatin1String("warning: ") + text;
+                    latexRows << QLatin1String("\\multicolumn{3}{l}{\\mbox{") + latexEscaped(QLatin1String("warning: ") + text) + QLatin1String("}}");
+                    break;
+                default:
+                    qDebug() << "qalculate message:" << text;
+                    break;
+            }
+        }
+
+        if (hasError)
+            break;
+
+        m_ans->set(result);
+
+        parsed.format(po);
+        result.format(po);
+        const QString& parsedString = QString::fromStdString(parsed.print(po));
+        const QString& resultString = QString::fromStdString(result.print(po));
+
+        // show the interpreted expression like qalc does
+        if (parsedString == resultString)
+            output << resultString;
+        else
+            output << parsedString + (result.isApproximate() ? QStringLiteral(" ≈ ") : QStringLiteral(" = ")) + resultString;
+
+        if (latex)
+        {
+            const QString& resultCode = latexCode(result, latexOptions);
+            if (parsedString == resultString)
+                latexRows << QLatin1String("& & ") + resultCode;
+            else
+                latexRows << latexCode(parsed, latexOptions) + (result.isApproximate() ? QLatin1String(" & \\approx & ") : QLatin1String(" & = & ")) + resultCode;
+        }
+    }
+
+    QString latexOutput;
+    if (latex && !latexRows.isEmpty())
+        latexOutput = QLatin1String("\\begin{eqnarray*}") + latexRows.join(QLatin1String(" \\\\\n")) + QLatin1String("\\end{eqnarray*}");
+
+    QStringList names;
+    QStringList values;
+    for (auto* variable : CALCULATOR->variables)
+    {
+        if (variable == m_ans || !variable->isLocal() || variable->isBuiltin() || !variable->isKnown() || !variable->isActive())
+            continue;
+
+        MathStructure value(static_cast<KnownVariable*>(variable)->get());
+        value.format(po);
+        names << QString::fromStdString(variable->name());
+        values << QString::fromStdString(value.print(po));
+    }
+
+    emit finished(id, output.join(QLatin1Char('\n')), latexOutput, errors, names, values);
+}
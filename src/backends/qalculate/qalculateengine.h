@@ -0,0 +1,80 @@
+/*
+    SPDX-FileCopyrightText: 2026 Cantor authors
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef QALCULATE_ENGINE_H
+#define QALCULATE_ENGINE_H
+
+#include <QMutex>
+#include <QObject>
+#include <QStringList>
+
+#include <libqalculate/Calculator.h>
+
+class KnownVariable;
+
+Q_DECLARE_METATYPE(EvaluationOptions)
+Q_DECLARE_METATYPE(PrintOptions)
+
+/**
+ * Evaluates the commands with the libqalculate API directly instead of the qalc process.
+ *
+ * The engine lives in a worker thread, the evaluation is blocking there. A running
+ * calculation is stopped with CALCULATOR->abort() from any thread.
+ *
+ * CALCULATOR is a global instance shared with the GUI thread, all the other accesses
+ * to it have to hold calculatorMutex(). The interactive ones, like the highlighting
+ * and the completion, only try to lock it and skip their work while a calculation runs.
+ */
+class QalculateEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    QalculateEngine();
+
+    static QMutex& calculatorMutex();
+
+public Q_SLOTS:
+    /**
+     * Evaluates @p commands one after another, the outputs of the commands are separated by new lines.
+     * The commands have to be unlocalized already. With @p latex the outputs are written as LaTeX code too.
+     */
+    void evaluate(int id, const QStringList& commands, const EvaluationOptions& eo, const PrintOptions& po, bool latex);
+
+Q_SIGNALS:
+    /**
+     * @p latex is the LaTeX code of the outputs, if requested, one row of an eqnarray per output.
+     * @p variableNames and @p variableValues contain all the variables defined by the user
+     */
+    void finished(int id, const QString& output, const QString& latex, const QStringList& errors,
+                  const QStringList& variableNames, const QStringList& variableValues);
+
+private:
+    KnownVariable* m_ans{nullptr};
+};
+
+/**
+ * Locks QalculateEngine::calculatorMutex() if it's free, for the accesses to CALCULATOR
+ * which are skipped while a calculation is running
+ */
+class QalculateCalculatorTryLocker
+{
+public:
+    QalculateCalculatorTryLocker() : m_locked(QalculateEngine::calculatorMutex().tryLock()) {}
+    ~QalculateCalculatorTryLocker()
+    {
+        if (m_locked)
+            QalculateEngine::calculatorMutex().unlock();
+    }
+
+    bool isLocked() const { return m_locked; }
+
+private:
+    Q_DISABLE_COPY(QalculateCalculatorTryLocker)
+    bool m_locked;
+};
+
+#endif
@@ -17,6 +17,7 @@
 #include "qalculateexpression.h"
 #include "qalculatesession.h"
 #include "qalculatesyntaxhelpobject.h"
+#include "qalculateengine.h"
 
 #include <libqalculate/ExpressionItem.h>
 #include <libqalculate/Unit.h>
@@ -27,6 +28,7 @@
 // required for the plotting interface of Qalculator
 
 #include <QDir>
+#include <QMutexLocker>
 #include <QTemporaryFile>
 
 #include <KMessageBox>
@@ -97,6 +99,38 @@ void QalculateExpression::parseOutput(const QString& output)
     setStatus(Cantor::Expression::Done);
 }
 
+void QalculateExpression::parseEngineOutput(const QString& output, const QString& latex, const QStringList& errors)
+{
+    if (errors.isEmpty())
+    {
+        // the output of the library is taken as it is, ">" is a valid part of it, e.g. in "5 > 3"
+        const QString& plain = output.trimmed();
+        qDebug() << "output from libqalculate for command: " << command() << " " << plain;
+
+        auto* result = latex.isEmpty() ? new Cantor::TextResult(plain) : new Cantor::TextResult(latex, plain);
+        if (!latex.isEmpty())
+            result->setFormat(Cantor::TextResult::LatexFormat);
+        setResult(result);
+
+        updateVariables();
+        setStatus(Cantor::Expression::Done);
+        return;
+    }
+
+    KColorScheme scheme(QApplication::palette().currentColorGroup());
+    const QString errorColor = scheme.foreground(KColorScheme::NegativeText).color().name();
+    const QString msgFormat(QLatin1String("<font color=\"%1\">%2: %3</font><br>\n"));
+
+    QString msg;
+    for (const auto& error : errors)
+        msg.append(msgFormat.arg(errorColor, i18n("ERROR"), error.toHtmlEscaped()));
+
+    qDebug() << "Error from libqalculate for command: " << command() << " " << errors;
+    updateVariables();
+    setErrorMessage(msg);
+    setStatus(Cantor::Expression::Error);
+}
+
 void QalculateExpression::updateVariables()
 {
     auto* currentSession = dynamic_cast<QalculateSession*>(session());
@@ -120,6 +154,9 @@ void QalculateExpression::parseError(const QString& error)
 
 void QalculateExpression::evaluatePlotCommand()
 {
+    // CALCULATOR is shared with the engines of the sessions running in their threads
+    QMutexLocker locker(&QalculateEngine::calculatorMutex());
+
     QString argString = command().mid(command().indexOf(QLatin1String("plot"))+4);
     argString = QLatin1String(unlocalizeExpression(argString).c_str());
     argString = argString.trimmed();
@@ -13,6 +13,7 @@
 #include <libqalculate/Calculator.h>
 
 #include <QSharedPointer>
+#include <QStringList>
 
 class QalculateSession;
 class QTemporaryFile;
@@ -29,6 +30,16 @@ public:
     void parseOutput(const QString&) override;
     void parseError(const QString&) override;
 
+    /**
+     * Handles the output of the in-process evaluation, @p errors are the error messages of libqalculate.
+     * Unlike the output of qalc, @p output has no prompt. @p latex is typeset if it's not empty.
+     */
+    void parseEngineOutput(const QString& output, const QString& latex, const QStringList& errors);
+
+    QSharedPointer<PrintOptions> printOptions();
+    EvaluationOptions evaluationOptions();
+    std::string unlocalizeExpression(QString expr);
+
 private:
     QTemporaryFile* m_tempFile{nullptr};
 
@@ -42,10 +53,7 @@ private:
     void showMessage(QString msg, MessageType mtype);
     int checkForCalculatorMessages();
     void updateVariables();
-    QSharedPointer<PrintOptions> printOptions();
-    EvaluationOptions evaluationOptions();
     ParseOptions parseOptions();
-    std::string unlocalizeExpression(QString expr);
 };
 
 #endif
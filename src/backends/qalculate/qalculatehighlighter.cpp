@@ -5,6 +5,7 @@
 */
 
 #include "qalculatehighlighter.h"
+#include "qalculateengine.h"
 
 #include <libqalculate/Calculator.h>
 #include <libqalculate/Variable.h>
@@ -16,6 +17,7 @@
 #include <QLocale>
 #include <QDebug>
 #include <QRegularExpression>
+#include <QTimer>
 
 QalculateHighlighter::QalculateHighlighter(QObject* parent)
     : Cantor::DefaultHighlighter(parent)
@@ -39,6 +41,19 @@ void QalculateHighlighter::highlightBlock(const QString& text)
 
     qDebug() << "highlight block:" << text;
 
+    // the block is highlighted again after the calculation running in the engine
+    const QalculateCalculatorTryLocker locker;
+    if (!locker.isLocked()) {
+        if (!m_rehighlightPending) {
+            m_rehighlightPending = true;
+            QTimer::singleShot(250, this, [this]() {
+                m_rehighlightPending = false;
+                rehighlight();
+            });
+        }
+        return;
+    }
+
     CALCULATOR->beginTemporaryStopMessages();
 
     const QString decimalSymbol = QLocale().decimalPoint();
@@ -20,6 +20,8 @@ protected:
 
 private:
     bool isOperatorAndWhitespace(const QString &word) const;
+
+    bool m_rehighlightPending{false};
 };
 
 #endif // QALCULATEHIGHLIGHTER_H
@@ -9,11 +9,14 @@
 #include "settings.h"
 
 #include "qalculatesession.h"
+#include "qalculateengine.h"
 #include "qalculatecompletionobject.h"
 #include "qalculatehighlighter.h"
 #include "defaultvariablemodel.h"
 
+#include <QMutexLocker>
 #include <QProcess>
+#include <QThread>
 #include <QRegularExpression>
 
 #include <libqalculate/Calculator.h>
@@ -36,6 +39,7 @@ QalculateSession::QalculateSession( Cantor::Backend* backend)
         graphs
     */
 
+    QMutexLocker locker(&QalculateEngine::calculatorMutex());
     if ( !CALCULATOR ) {
              new Calculator();
              CALCULATOR->loadGlobalDefinitions();
@@ -47,6 +51,7 @@ QalculateSession::QalculateSession( Cantor::Backend* backend)
 QalculateSession::~QalculateSession()
 {
     CALCULATOR->abort();
+    stopEngine();
     if(m_process)
     {
         m_process->kill();
@@ -57,12 +62,30 @@ QalculateSession::~QalculateSession()
 
 void QalculateSession::login()
 {
-    if (m_process)
+    if (m_process || m_engine)
         return;
 
     emit loginStarted();
     qDebug() << "login started";
 
+    if (QalculateSettings::self()->inProcess())
+    {
+        // evaluate with the library directly, the worker thread keeps the GUI responsive during long calculations
+        qRegisterMetaType<EvaluationOptions>();
+        qRegisterMetaType<PrintOptions>();
+
+        m_engineThread = new QThread(this);
+        m_engine = new QalculateEngine();
+        m_engine->moveToThread(m_engineThread);
+        connect(m_engineThread, &QThread::finished, m_engine, &QObject::deleteLater);
+        connect(m_engine, &QalculateEngine::finished, this, &QalculateSession::engineFinished);
+        m_engineThread->start();
+
+        changeStatus(Session::Done);
+        emit loginDone();
+        return;
+    }
+
     /* we will , most probably, use autoscripts for setting the mode , evaluate options, print options etc */
 
     // if(!QalculateSettings::autorunScripts().isEmpty()){
@@ -201,9 +224,56 @@ void QalculateSession::processStarted()
     qDebug() << "process  started " << m_process->program() << m_process->processId();
 }
 
+void QalculateSession::stopEngine()
+{
+    if (!m_engineThread)
+        return;
+
+    CALCULATOR->abort();
+    m_engineThread->quit();
+    m_engineThread->wait();
+    delete m_engineThread;
+    m_engineThread = nullptr;
+    m_engine = nullptr;
+}
+
+void QalculateSession::engineFinished(int id, const QString& output, const QString& latex, const QStringList& errors,
+                                      const QStringList& variableNames, const QStringList& variableValues)
+{
+    // results of interrupted evaluations are dropped
+    if (id != m_engineCommandId || !m_currentExpression || m_currentExpression->status() != Cantor::Expression::Computing)
+        return;
+
+    variables.clear();
+    for (int i = 0; i < variableNames.size(); ++i)
+        variables.insert(variableNames.at(i), variableValues.at(i));
+
+    // the error of a save command is only part of the plain output, it's shown without typesetting
+    QString result = output;
+    QString latexResult = latex;
+    if (!m_saveError.isEmpty())
+    {
+        result.append(QLatin1Char('\n') + m_saveError);
+        latexResult.clear();
+        m_saveError.clear();
+    }
+
+    m_currentExpression->parseEngineOutput(result, latexResult, errors);
+}
+
 void QalculateSession::logout()
 {
     qDebug () << "logging out";
+    if (m_engine)
+    {
+        if(status() == Cantor::Session::Running)
+            interrupt();
+
+        stopEngine();
+        Session::logout();
+        return;
+    }
+
     if (!m_process)
         return;
 
@@ -222,6 +292,12 @@ void QalculateSession::logout()
 void QalculateSession::interrupt()
 {
     qDebug () << "interrupting .... ";
+    if (m_engine)
+    {
+        ++m_engineCommandId;
+        CALCULATOR->abort();
+    }
+
     if(m_currentExpression)
         m_currentExpression->interrupt();
 
@@ -237,6 +313,38 @@ void QalculateSession::interrupt()
 void QalculateSession::runExpression()
 {
     const QString& command = m_currentExpression->command();
+    if (m_engine)
+    {
+        QStringList commands;
+        m_saveError.clear();
+        QMutexLocker locker(&QalculateEngine::calculatorMutex());
+        for (QString cmd : command.split(QLatin1Char('\n')))
+        {
+            // qalc's save/store commands are mapped to the save() function of the library
+            const QString& trimmed = cmd.trimmed();
+            if (trimmed.startsWith(QLatin1String("save"), Qt::CaseInsensitive)
+                || trimmed.startsWith(QLatin1String("store"), Qt::CaseInsensitive))
+            {
+                const QString error = m_saveError;
+                m_saveError.clear();
+                cmd = parseSaveCommand(cmd);
+                m_saveError.prepend(error);
+                m_isSaveCommand = false;
+            }
+
+            if (!cmd.trimmed().isEmpty())
+                commands << QString::fromStdString(m_currentExpression->unlocalizeExpression(cmd));
+        }
+
+        QMetaObject::invokeMethod(m_engine, "evaluate", Qt::QueuedConnection,
+                                  Q_ARG(int, ++m_engineCommandId),
+                                  Q_ARG(QStringList, commands),
+                                  Q_ARG(EvaluationOptions, m_currentExpression->evaluationOptions()),
+                                  Q_ARG(PrintOptions, *m_currentExpression->printOptions()),
+                                  Q_ARG(bool, isTypesettingEnabled()));
+        return;
+    }
+
     foreach(const QString& cmd, command.split(QLatin1Char('\n'))) {
         m_commandQueue.enqueue(cmd);
     }
@@ -23,6 +23,7 @@ class DefaultVariableModel;
 
 class QalculateEngine;
 class QProcess;
+class QThread;
 
 
 class QalculateSession : public Cantor::Session
@@ -32,6 +33,9 @@ class QalculateSession : public Cantor::Session
 private:
     Cantor::DefaultVariableModel* m_variableModel;
     QProcess* m_process;
+    QalculateEngine* m_engine{nullptr};
+    QThread* m_engineThread{nullptr};
+    int m_engineCommandId{0};
     QalculateExpression* m_currentExpression;
     QString m_output;
     QString m_finalOutput;
@@ -47,6 +51,7 @@ private:
     void runCommandQueue();
     QString parseSaveCommand(QString& currentCmd);
     void storeVariables(QString& currentCmd, QString output);
+    void stopEngine();
 
 public:
     explicit QalculateSession( Cantor::Backend* backend);
@@ -73,6 +78,8 @@ public Q_SLOTS:
     void readError();
     void processStarted();
     void currentExpressionStatusChanged(Cantor::Expression::Status status);
+    void engineFinished(int id, const QString& output, const QString& latex, const QStringList& errors,
+                        const QStringList& variableNames, const QStringList& variableValues);
 };
 
 #endif
@@ -7,6 +7,7 @@
 #include "qalculatesyntaxhelpobject.h"
 #include "settings.h"
 #include "qalculatesession.h"
+#include "qalculateengine.h"
 
 #include <KLocalizedString>
 
@@ -40,6 +41,12 @@ void QalculateSyntaxHelpObject::fetchInformation()
 	return;
     }
 
+    const QalculateCalculatorTryLocker locker;
+    if (!locker.isLocked()) {
+        m_answer = i18n("The help is not available while a calculation is running.");
+        return;
+    }
+
     ExpressionItem *item = CALCULATOR->getActiveExpressionItem(cmd);
 
     if (!item) {
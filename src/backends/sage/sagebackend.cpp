@@ -59,8 +59,17 @@ Cantor::Backend::Capabilities SageBackend::capabilities() const
 
 bool SageBackend::requirementsFullfilled(QString* const reason) const
 {
-    const QString& path = SageSettings::self()->path().toLocalFile();
-    return Cantor::Backend::checkExecutable(QLatin1String("Sage"), path, reason);
+    QString name;
+    QString path;
+    requiredExecutable(&name, &path);
+    return name.isEmpty() || Cantor::Backend::checkExecutable(name, path, reason);
+}
+
+bool SageBackend::requiredExecutable(QString* name, QString* path) const
+{
+    *name = QLatin1String("Sage");
+    *path = SageSettings::self()->path().toLocalFile();
+    return true;
 }
 
 QWidget* SageBackend::settingsWidget(QWidget* parent) const
@@ -452,6 +452,13 @@ void SageSession::setTypesettingEnabled(bool enable)
 void SageSession::setWorksheetPath(const QString& path)
 {
     m_worksheetPath = path;
+
+    // a session taken from the session pool is logged in before the worksheet is known
+    if (m_isInitialized && !m_worksheetPath.isEmpty())
+    {
+        const QString cmd = QLatin1String("__file__ = '%1'");
+        evaluateExpression(cmd.arg(m_worksheetPath), Cantor::Expression::DeleteOnFinish, true);
+    }
 }
 
 Cantor::CompletionObject* SageSession::completionFor(const QString& command, int index)
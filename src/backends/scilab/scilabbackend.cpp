@@ -48,8 +48,17 @@ Cantor::Backend::Capabilities ScilabBackend::capabilities() const
 
 bool ScilabBackend::requirementsFullfilled(QString* const reason) const
 {
-    const QString& path = ScilabSettings::self()->path().toLocalFile();
-    return Cantor::Backend::checkExecutable(QLatin1String("Scilab"), path, reason);
+    QString name;
+    QString path;
+    requiredExecutable(&name, &path);
+    return name.isEmpty() || Cantor::Backend::checkExecutable(name, path, reason);
+}
+
+bool ScilabBackend::requiredExecutable(QString* name, QString* path) const
+{
+    *name = QLatin1String("Scilab");
+    *path = ScilabSettings::self()->path().toLocalFile();
+    return true;
 }
 
 QWidget* ScilabBackend::settingsWidget(QWidget* parent) const
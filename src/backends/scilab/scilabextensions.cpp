@@ -33,6 +33,11 @@ QString ScilabScriptExtension::commandSeparator()
     return QLatin1String(";");
 }
 
+QString ScilabScriptExtension::commentStartingSequence()
+{
+    return QLatin1String("//");
+}
+
 SCILAB_EXT_CDTOR(VariableManagement)
 
 QString ScilabVariableManagementExtension::addVariable(const QString& name, const QString& value)
@@ -19,6 +19,7 @@ class ScilabScriptExtension : public Cantor::ScriptExtension
         QString highlightingMode() override;
         QString runExternalScript(const QString& path) override;
         QString commandSeparator() override;
+        QString commentStartingSequence() override;
 };
 
 class ScilabVariableManagementExtension : public Cantor::VariableManagementExtension
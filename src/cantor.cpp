@@ -30,8 +30,11 @@
 #include <QGraphicsView>
 #include <QPushButton>
 #include <QRegularExpression>
+#include <QTimer>
 
 #include "lib/backend.h"
+#include "lib/backendrequirements.h"
+#include "lib/sessionpool.h"
 #include "lib/worksheetaccess.h"
 
 #include "backendchoosedialog.h"
@@ -69,6 +72,17 @@ CantorShell::CantorShell() : KParts::MainWindow(), m_tabWidget(new QTabWidget(th
     initPanels();
 
     updateNewSubmenu();
+
+    // the backends are listed with the requirements known from the last run, only the outdated
+    // results are checked again in the background, all of them after a change of the settings
+    auto* requirements = Cantor::BackendRequirements::instance();
+    connect(requirements, &Cantor::BackendRequirements::checked, this, &CantorShell::updateNewSubmenu);
+    connect(this, &CantorShell::settingsChanges, requirements, &Cantor::BackendRequirements::checkAll);
+    QTimer::singleShot(0, requirements, &Cantor::BackendRequirements::checkOutdated);
+
+    // the pool is shared by all worksheets, it's configured here once and not by every worksheet
+    connect(this, &CantorShell::settingsChanges, this, &CantorShell::configureSessionPool);
+    QTimer::singleShot(0, this, &CantorShell::configureSessionPool);
 }
 
 CantorShell::~CantorShell()
@@ -249,16 +263,7 @@ void CantorShell::fileOpen()
 
 void CantorShell::addWorksheet()
 {
-    bool hasBackend = false;
-    for (auto* b : Cantor::Backend::availableBackends())
-    {
-        if(b->isEnabled())
-        {
-            hasBackend = true;
-            break;
-        }
-    }
-
+    const bool hasBackend = !Cantor::Backend::listAvailableBackends().isEmpty();
     if(hasBackend) //There is no point in asking for the backend, if no one is available
     {
         QString backend = Settings::self()->defaultBackend();
@@ -694,35 +699,42 @@ KParts::ReadWritePart* CantorShell::findPart(QWidget* widget)
 
 void CantorShell::initPanels()
 {
+    // the panels are created empty, their plugins are instantiated when shown the first time
+    connect(&m_panelHandler, &Cantor::PanelPluginHandler::pluginLoaded, this, &CantorShell::setupPanelPlugin);
     m_panelHandler.loadPlugins();
 
-    for (auto* plugin : m_panelHandler.allPlugins())
+    for (const auto& plugin : m_panelHandler.allPluginsMetaData())
     {
-        if (!plugin)
-        {
-            qDebug()<<"invalid panel found, skipping it.";
-            continue;
-        }
-
-        qDebug()<<"adding panel for "<<plugin->name();
-        plugin->setParentWidget(this);
-        plugin->connectToShell(this);
-
-        QDockWidget* docker = new QDockWidget(plugin->name(), this);
-        docker->setObjectName(plugin->name());
-        docker->setWidget(plugin->widget());
+        qDebug()<<"adding panel for "<<plugin.name();
+        QDockWidget* docker = new QDockWidget(plugin.name(), this);
+        docker->setObjectName(plugin.name());
         docker->setWindowIcon(QIcon::fromTheme(QStringLiteral("format-text-bold")));
         addDockWidget(Qt::RightDockWidgetArea, docker);
 
         docker->hide();
 
-        connect(plugin, &Cantor::PanelPlugin::visibilityRequested, this, &CantorShell::pluginVisibilityRequested);
-        connect(plugin, &Cantor::PanelPlugin::requestRunCommand, this, &CantorShell::pluginCommandRunRequested);
+        connect(docker, &QDockWidget::visibilityChanged, this, [this, docker](bool visible) {
+            if (visible && !docker->widget())
+            {
+                auto* plugin = m_panelHandler.plugin(docker->objectName());
+                if (plugin)
+                    docker->setWidget(plugin->widget());
+            }
+        });
 
         m_panels.append(docker);
     }
 }
 
+void CantorShell::setupPanelPlugin(Cantor::PanelPlugin* plugin)
+{
+    plugin->setParentWidget(this);
+    plugin->connectToShell(this);
+
+    connect(plugin, &Cantor::PanelPlugin::visibilityRequested, this, &CantorShell::pluginVisibilityRequested);
+    connect(plugin, &Cantor::PanelPlugin::requestRunCommand, this, &CantorShell::pluginCommandRunRequested);
+}
+
 void CantorShell::updatePanel()
 {
     unplugActionList(QLatin1String("view_show_panel_list"));
@@ -746,16 +758,19 @@ void CantorShell::updatePanel()
         wa = m_part->findChild<Cantor::WorksheetAccessInterface*>(Cantor::WorksheetAccessInterface::Name);
 
     // Worksheet interface can be missing on m_part clossing (and m_part on this moment can be nullptr)
-    QList<Cantor::PanelPlugin*> plugins;
+    QStringList plugins;
     if (wa)
     {
         QDockWidget* last = nullptr;
-        plugins = m_panelHandler.activePluginsForSession(wa->session(), m_pluginsStates.contains(m_part) ? m_pluginsStates[m_part] : Cantor::PanelPluginHandler::PanelStates());
-        for (auto* plugin : plugins)
+        // the states of the plugins not instantiated yet are restored when they're shown
+        const auto& supportedPlugins = m_panelHandler.preparePluginsForSession(wa->session(), m_pluginsStates.contains(m_part) ? m_pluginsStates[m_part] : Cantor::PanelPluginHandler::PanelStates());
+        for (const auto& plugin : supportedPlugins)
         {
+            plugins << plugin.name();
+
             QDockWidget* foundDocker = nullptr;
             for (auto* docker : m_panels)
-                if (docker->objectName() == plugin->name())
+                if (docker->objectName() == plugin.name())
                 {
                     foundDocker = docker;
                     break;
@@ -763,21 +778,21 @@ void CantorShell::updatePanel()
 
             if (!foundDocker)
             {
-                qDebug() << "something wrong: can't find panel for plugin \"" << plugin->name() << "\"";
+                qDebug() << "something wrong: can't find panel for plugin \"" << plugin.name() << "\"";
                 continue;
             }
 
             // Set visibility for dock from saved info
             if (isNewWorksheet)
             {
-                if (plugin->showOnStartup())
+                if (Cantor::PanelPluginHandler::showOnStartup(plugin))
                     foundDocker->show();
                 else
                     foundDocker->hide();
             }
             else
             {
-                if (m_pluginsVisibility[m_part].contains(plugin->name()))
+                if (m_pluginsVisibility[m_part].contains(plugin.name()))
                     foundDocker->show();
                 else
                     foundDocker->hide();
@@ -794,17 +809,9 @@ void CantorShell::updatePanel()
     }
 
     // Hide plugins, which don't supported on current session
-    QList<Cantor::PanelPlugin*> allPlugins=m_panelHandler.allPlugins();
-    for(auto* plugin : allPlugins)
-    {
-        if (plugins.indexOf(plugin) == -1)
-            for (QDockWidget* docker : m_panels)
-                if (docker->objectName() == plugin->name())
-                {
-                    docker->hide();
-                    break;
-                }
-    }
+    for (QDockWidget* docker : m_panels)
+        if (!plugins.contains(docker->objectName()))
+            docker->hide();
 
     plugActionList(QLatin1String("view_show_panel_list"), panelActions);
 
@@ -817,12 +824,13 @@ void CantorShell::updateNewSubmenu()
     qDeleteAll(m_newBackendActions);
     m_newBackendActions.clear();
 
-    for (auto* backend : Cantor::Backend::availableBackends())
+    auto* requirements = Cantor::BackendRequirements::instance();
+    for (const auto& plugin : Cantor::Backend::availableBackendsMetaData())
     {
-        if (!backend->isEnabled())
+        if (requirements->state(plugin.pluginId()) == Cantor::BackendRequirements::Missing)
             continue;
-        QAction* action = new QAction(QIcon::fromTheme(backend->icon()), backend->name(), nullptr);
-        action->setData(backend->name());
+        QAction* action = new QAction(QIcon::fromTheme(plugin.iconName()), plugin.name(), nullptr);
+        action->setData(plugin.name());
         connect(action, SIGNAL(triggered()), this, SLOT(fileNew()));
         m_newBackendActions << action;
     }
@@ -835,6 +843,14 @@ Cantor::WorksheetAccessInterface* CantorShell::currentWorksheetAccessInterface()
     return wa;
 }
 
+void CantorShell::configureSessionPool()
+{
+    auto* pool = Cantor::SessionPool::instance();
+    pool->setMinimumAvailableMemory(Settings::self()->sessionPoolMinAvailableMemory());
+    pool->setSize(Settings::self()->sessionPoolSize());
+    pool->addBackend(Cantor::Backend::getBackend(Settings::self()->defaultBackend()));
+}
+
 void CantorShell::pluginVisibilityRequested()
 {
     auto* plugin = static_cast<Cantor::PanelPlugin*>(sender());
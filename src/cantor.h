@@ -94,8 +94,10 @@ private Q_SLOTS:
     void openExample();
 
     void initPanels();
+    void setupPanelPlugin(Cantor::PanelPlugin*);
     void updatePanel();
     void updateNewSubmenu();
+    void configureSessionPool();
 
     void pluginVisibilityRequested();
     void pluginCommandRunRequested(const QString&);
@@ -11,6 +11,7 @@
 #include <cmath>
 
 #include "cantor_part.h"
+#include "entrydependenciesdialog.h"
 #include "lib/assistant.h"
 #include "lib/backend.h"
 #include "lib/extension.h"
@@ -184,6 +185,10 @@ CantorPart::CantorPart(QWidget* parentWidget, QObject* parent, const QVariantLis
     collection->addAction(QLatin1String("file_export_latex"), latexExport);
     connect(latexExport, &QAction::triggered, this, &CantorPart::exportToLatex);
 
+    QAction* traceExport = new QAction(QIcon::fromTheme(QLatin1String("office-chart-area")), i18n("Export Timing Trace"), collection);
+    collection->addAction(QLatin1String("file_export_timing_trace"), traceExport);
+    connect(traceExport, &QAction::triggered, this, &CantorPart::exportTimingTrace);
+
     QAction* print = KStandardAction::print(this, SLOT(print()), collection);
     print->setPriority(QAction::LowPriority);
 
@@ -244,6 +249,10 @@ CantorPart::CantorPart(QWidget* parentWidget, QObject* parent, const QVariantLis
     collection->addAction(QLatin1String("enable_expression_numbers"), m_exprNumbering);
     connect(m_exprNumbering, &KToggleAction::toggled, m_worksheet, &Worksheet::enableExpressionNumbering);
 
+    KToggleAction* exprDurations = new KToggleAction(i18n("Evaluation Durations"), collection);
+    collection->addAction(QLatin1String("enable_expression_durations"), exprDurations);
+    connect(exprDurations, &KToggleAction::toggled, m_worksheet, &Worksheet::enableExpressionDurations);
+
     m_animateWorksheet = new KToggleAction(i18n("Animations"), collection);
     m_animateWorksheet->setChecked(Settings::self()->animationDefault());
     collection->addAction(QLatin1String("enable_animations"), m_animateWorksheet);
@@ -269,6 +278,16 @@ CantorPart::CantorPart(QWidget* parentWidget, QObject* parent, const QVariantLis
     connect(evaluateCurrent, &QAction::triggered, m_worksheet, &Worksheet::evaluateCurrentEntry);
     m_editActions.push_back(evaluateCurrent);
 
+    QAction* evaluateChanged = new QAction(QIcon::fromTheme(QLatin1String("view-refresh")), i18n("Evaluate Changed Entries"), collection);
+    collection->addAction(QLatin1String("evaluate_changed_entries"), evaluateChanged);
+    collection->setDefaultShortcut(evaluateChanged, Qt::CTRL + Qt::SHIFT + Qt::Key_E);
+    connect(evaluateChanged, &QAction::triggered, this, &CantorPart::evaluateChangedEntries);
+    m_editActions.push_back(evaluateChanged);
+
+    QAction* showDependencies = new QAction(QIcon::fromTheme(QLatin1String("distribute-graph-directed")), i18n("Show Entry Dependencies"), collection);
+    collection->addAction(QLatin1String("show_entry_dependencies"), showDependencies);
+    connect(showDependencies, &QAction::triggered, this, &CantorPart::showEntryDependencies);
+
     QAction* insertCommandEntry = new QAction(QIcon::fromTheme(QLatin1String("run-build")), i18n("Insert Command Entry"), collection);
     collection->addAction(QLatin1String("insert_command_entry"),  insertCommandEntry);
     collection->setDefaultShortcut(insertCommandEntry, Qt::CTRL + Qt::Key_Return);
@@ -557,6 +576,18 @@ void CantorPart::exportToLatex()
     }
 }
 
+void CantorPart::exportTimingTrace()
+{
+    QString file_name = QFileDialog::getSaveFileName(widget(), i18n("Export Timing Trace"), QString(), i18n("Chrome Trace Files (*.json)"));
+
+    if (file_name.isEmpty() == false)
+    {
+        if (!file_name.endsWith(QLatin1String(".json")))
+            file_name += QLatin1String(".json");
+        m_worksheet->saveTimingTrace(file_name);
+    }
+}
+
 void CantorPart::guiActivateEvent( KParts::GUIActivateEvent * event )
 {
     KParts::ReadWritePart::guiActivateEvent(event);
@@ -579,6 +610,24 @@ void CantorPart::evaluateOrInterrupt()
     else
         m_worksheet->evaluate();
 }
+
+void CantorPart::evaluateChangedEntries()
+{
+    if (m_worksheet->isRunning())
+        return;
+
+    const int skipped = m_worksheet->evaluateChangedEntries();
+    if (skipped > 0)
+        showImportantStatusMessage(i18np("1 up-to-date entry skipped", "%1 up-to-date entries skipped", skipped));
+}
+
+void CantorPart::showEntryDependencies()
+{
+    QVector<CommandEntry*> entries;
+    auto* dialog = new EntryDependenciesDialog(m_worksheet->entryDependencies(entries), widget());
+    dialog->show();
+}
+
 void CantorPart::restartBackend()
 {
     bool restart = false;
@@ -674,6 +723,10 @@ void CantorPart::initialized()
         loadAssistants();
         adjustGuiToSession();
 
+        // a session taken from the session pool is already logged in
+        if (m_worksheet->session()->status() != Cantor::Session::Disable)
+            m_restart->setEnabled(true);
+
         // Don't set modification flag, if we add command entry in empty worksheet
         const bool modified = this->isModified();
         if (m_worksheet->isEmpty())
@@ -105,7 +105,10 @@ protected Q_SLOTS:
     void fileSavePlain();
     void exportToPDF();
     void exportToLatex();
+    void exportTimingTrace();
     void evaluateOrInterrupt();
+    void evaluateChangedEntries();
+    void showEntryDependencies();
     void restartBackend();
     void zoomValueEdited(const QString&);
     void updateZoomWidgetValue(double);
@@ -29,6 +29,7 @@
 #include <QPropertyAnimation>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QLocale>
 #include <QTextBlock>
 #include <QTextDocumentFragment>
 #include <QPainter>
@@ -41,6 +42,17 @@ const QString CommandEntry::MidPrompt  = QLatin1String(">>  ");
 const QString CommandEntry::HidePrompt = QLatin1String(">   ");
 const double CommandEntry::VerticalSpacing = 4;
 
+static QString formatDuration(qint64 nanoseconds)
+{
+    const double ms = nanoseconds / 1e6;
+    if (ms < 10)
+        return i18nc("duration in milliseconds", "%1 ms", QLocale().toString(ms, 'f', 1));
+    else if (ms < 1000)
+        return i18nc("duration in milliseconds", "%1 ms", QLocale().toString(qRound(ms)));
+    else
+        return i18nc("duration in seconds", "%1 s", QLocale().toString(ms / 1000, 'f', 2));
+}
+
 
 CommandEntry::CommandEntry(Worksheet* worksheet) : WorksheetEntry(worksheet),
     m_promptItem(new WorksheetTextItem(this, Qt::NoTextInteraction)),
@@ -890,10 +902,29 @@ bool CommandEntry::evaluate(EvaluationOption evalOp)
             return false;
         }
 
+        m_evaluatingCommand = cmd;
+
         auto* expr = worksheet()->session()->evaluateExpression(cmd);
+        worksheet()->setSessionStateModified();
         connect(expr, &Cantor::Expression::gotResult, this, [=]() { worksheet()->gotResult(expr); });
 
-        setExpression(expr);
+        // like the entries not evaluated yet when evaluating one after another, a queued entry
+        // keeps its previous results until its command is started. It isn't started at all if
+        // a previous command of the pipeline fails.
+        if (expr->status() == Cantor::Expression::Queued)
+        {
+            if (m_queuedExpression)
+                disconnect(m_queuedExpression, &Cantor::Expression::statusChanged, this, &CommandEntry::queuedExpressionChangedStatus);
+            m_queuedExpression = expr;
+            connect(expr, &Cantor::Expression::statusChanged, this, &CommandEntry::queuedExpressionChangedStatus);
+            updatePrompt();
+        }
+        else
+        {
+            m_queuedExpression = nullptr;
+            m_evaluated = false;
+            setExpression(expr);
+        }
 
         return true;
     }
@@ -906,11 +937,31 @@ bool CommandEntry::evaluate(EvaluationOption evalOp)
 
 void CommandEntry::interruptEvaluation()
 {
-    auto* expr = expression();
+    auto* expr = m_queuedExpression ? m_queuedExpression.data() : expression();
     if(expr)
         expr->interrupt();
 }
 
+void CommandEntry::queuedExpressionChangedStatus(Cantor::Expression::Status status)
+{
+    auto* expr = m_queuedExpression.data();
+    if (!expr || expr != sender() || status == Cantor::Expression::Queued)
+        return;
+
+    disconnect(expr, &Cantor::Expression::statusChanged, this, &CommandEntry::queuedExpressionChangedStatus);
+    m_queuedExpression = nullptr;
+
+    // skipped or interrupted before it was started, the previous results stay
+    if (status == Cantor::Expression::Interrupted)
+    {
+        updatePrompt();
+        return;
+    }
+
+    m_evaluated = false;
+    setExpression(expr);
+}
+
 void CommandEntry::updateEntry()
 {
     qDebug() << "update Entry";
@@ -946,10 +997,31 @@ void CommandEntry::updateEntry()
                                     || m_resultItems.size() > 0;
 
     animateSizeChange();
+
+    // results arriving after the end of the evaluation, like typeset LaTeX or plots
+    if (expr->status() == Cantor::Expression::Done || expr->status() == Cantor::Expression::Error)
+    {
+        expr->markTime(Cantor::Expression::RenderedTime);
+        if (worksheet()->showExpressionDurations())
+            m_promptItem->setToolTip(timingToolTip());
+    }
 }
 
 void CommandEntry::expressionChangedStatus(Cantor::Expression::Status status)
 {
+    if (status == Cantor::Expression::Done || status == Cantor::Expression::Error || status == Cantor::Expression::Interrupted)
+    {
+        // the results are shown once the event loop has processed the pending layout changes
+        QPointer<Cantor::Expression> expr = m_expression;
+        QTimer::singleShot(0, this, [this, expr]() {
+            if (!expr || expr != m_expression)
+                return;
+            expr->markTime(Cantor::Expression::RenderedTime);
+            if (worksheet()->showExpressionDurations())
+                m_promptItem->setToolTip(timingToolTip());
+        });
+    }
+
     switch (status)
     {
     case Cantor::Expression::Computing:
@@ -1000,6 +1072,8 @@ void CommandEntry::expressionChangedStatus(Cantor::Expression::Status status)
     case Cantor::Expression::Done:
         m_promptItemAnimation->stop();
         m_promptItem->setOpacity(1.);
+        m_evaluatedCommand = m_evaluatingCommand;
+        m_evaluated = true;
         evaluateNext(m_evaluationOption);
         m_evaluationOption = DoNothing;
         break;
@@ -1307,13 +1381,31 @@ void CommandEntry::updatePrompt(const QString& postfix)
     c.setCharFormat(cformat);
     cformat.setFontWeight(QFont::Bold);
 
+    //insert the duration of the evaluation if available
+    QString toolTip;
+    if (m_expression && worksheet()->showExpressionDurations())
+    {
+        const qint64 duration = m_expression->elapsed(Cantor::Expression::SentTime, Cantor::Expression::FinishedTime);
+        if (duration != -1)
+        {
+            QTextCharFormat durationFormat = cformat;
+            durationFormat.setFontWeight(QFont::Normal);
+            durationFormat.setForeground(color.foreground(KColorScheme::InactiveText));
+            c.insertText(formatDuration(duration) + QLatin1Char(' '), durationFormat);
+            toolTip = timingToolTip();
+        }
+    }
+    m_promptItem->setToolTip(toolTip);
+
     //insert the session id if available
     if(m_expression && worksheet()->showExpressionIds()&&m_expression->id()!=-1)
         c.insertText(QString::number(m_expression->id()),cformat);
 
     //detect the correct color for the prompt, depending on the
     //Expression state
-    if(m_expression)
+    if(m_queuedExpression)
+        cformat.setForeground(color.foreground(KColorScheme::InactiveText));
+    else if(m_expression)
     {
         if(m_expression ->status() == Cantor::Expression::Computing&&worksheet()->isRunning())
             cformat.setForeground(color.foreground(KColorScheme::PositiveText));
@@ -1331,6 +1423,35 @@ void CommandEntry::updatePrompt(const QString& postfix)
     recalculateSize();
 }
 
+/*!
+ * returns the durations of the stages of the evaluation, to tell the time spent
+ * in the interpreter from the time spent in the communication and in the rendering
+ */
+QString CommandEntry::timingToolTip()
+{
+    if (!m_expression)
+        return QString();
+
+    QStringList lines;
+    auto addLine = [&lines](const QString& label, qint64 duration) {
+        if (duration >= 0)
+            lines << i18nc("@info:tooltip stage of the evaluation and its duration", "%1: %2", label, formatDuration(duration));
+    };
+
+    using Expression = Cantor::Expression;
+    addLine(i18n("Waiting in the queue"), m_expression->elapsed(Expression::QueuedTime, Expression::SentTime));
+    if (m_expression->time(Expression::FirstOutputTime) != -1)
+    {
+        addLine(i18n("Backend until the first output"), m_expression->elapsed(Expression::SentTime, Expression::FirstOutputTime));
+        addLine(i18n("Receiving and parsing the output"), m_expression->elapsed(Expression::FirstOutputTime, Expression::FinishedTime));
+    }
+    else
+        addLine(i18n("Backend"), m_expression->elapsed(Expression::SentTime, Expression::FinishedTime));
+    addLine(i18n("Rendering the results"), m_expression->elapsed(Expression::FinishedTime, Expression::RenderedTime));
+
+    return lines.join(QLatin1Char('\n'));
+}
+
 WorksheetTextItem* CommandEntry::currentInformationItem()
 {
     if (m_informationItems.isEmpty())
@@ -1625,6 +1746,22 @@ bool CommandEntry::isExcludedFromExecution()
     return m_isExecutionEnabled == false;
 }
 
+bool CommandEntry::isEvaluated()
+{
+    return m_evaluated;
+}
+
+QString CommandEntry::evaluatedCommand()
+{
+    return m_evaluatedCommand;
+}
+
+void CommandEntry::resetEvaluation()
+{
+    m_evaluated = false;
+    m_evaluatedCommand.clear();
+}
+
 bool CommandEntry::isResultCollapsed()
 {
     return m_resultsCollapsed;
@@ -47,6 +47,14 @@ class CommandEntry : public WorksheetEntry
 
     bool isEmpty() override;
     bool isExcludedFromExecution();
+
+    /**
+     * true if the entry was evaluated successfully in the current session,
+     * evaluatedCommand() is the command evaluated then
+     */
+    bool isEvaluated();
+    QString evaluatedCommand();
+    void resetEvaluation();
     bool isResultCollapsed();
 
     void setContent(const QString&) override;
@@ -121,6 +129,7 @@ class CommandEntry : public WorksheetEntry
     void initMenus();
     void handleExistedCompletionBox();
     void makeCompletion(const QString& line, int position);
+    QString timingToolTip();
 
     enum CompletionMode {PreliminaryCompletion, FinalCompletion};
     static const double VerticalSpacing;
@@ -132,6 +141,7 @@ class CommandEntry : public WorksheetEntry
     WorksheetTextItem* m_errorItem;
     QList<WorksheetTextItem*> m_informationItems;
     Cantor::Expression* m_expression;
+    QPointer<Cantor::Expression> m_queuedExpression; // not started yet, m_expression is still shown
 
     Cantor::CompletionObject* m_completionObject;
     QPointer<KCompletionBox> m_completionBox;
@@ -155,10 +165,15 @@ class CommandEntry : public WorksheetEntry
     QColor m_activeExecutionTextColor;
     QColor m_activeExecutionBackgroundColor;
 
+    QString m_evaluatingCommand;
+    QString m_evaluatedCommand;
+    bool m_evaluated{false};
+
   private Q_SLOTS:
     void invalidate();
     void resultDeleted();
     void clearResultItems();
+    void queuedExpressionChangedStatus(Cantor::Expression::Status status);
     void removeResultItem(int index);
     void replaceResultItem(int index);
     void updateCompletions();
@@ -0,0 +1,474 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#include "entrydependencies.h"
+#include "lib/backend.h"
+#include "lib/extension.h"
+
+#include <QHash>
+#include <QRegularExpression>
+#include <QStringList>
+
+#include <algorithm>
+
+// keywords of the supported languages, they are neither read nor written
+static const QSet<QString> keywords({
+    QLatin1String("and"), QLatin1String("as"), QLatin1String("break"), QLatin1String("case"),
+    QLatin1String("catch"), QLatin1String("class"), QLatin1String("const"), QLatin1String("continue"),
+    QLatin1String("def"), QLatin1String("del"), QLatin1String("do"), QLatin1String("elif"),
+    QLatin1String("else"), QLatin1String("elseif"), QLatin1String("end"), QLatin1String("endfor"),
+    QLatin1String("endfunction"), QLatin1String("endif"), QLatin1String("endwhile"), QLatin1String("except"),
+    QLatin1String("FALSE"), QLatin1String("False"), QLatin1String("false"), QLatin1String("finally"),
+    QLatin1String("for"), QLatin1String("from"), QLatin1String("function"), QLatin1String("global"),
+    QLatin1String("if"), QLatin1String("import"), QLatin1String("in"), QLatin1String("is"),
+    QLatin1String("lambda"), QLatin1String("let"), QLatin1String("local"), QLatin1String("module"),
+    QLatin1String("NA"), QLatin1String("None"), QLatin1String("nonlocal"), QLatin1String("not"),
+    QLatin1String("nothing"), QLatin1String("NULL"), QLatin1String("or"), QLatin1String("pass"),
+    QLatin1String("persistent"), QLatin1String("raise"), QLatin1String("repeat"), QLatin1String("return"),
+    QLatin1String("struct"), QLatin1String("then"), QLatin1String("TRUE"), QLatin1String("True"),
+    QLatin1String("true"), QLatin1String("try"), QLatin1String("using"), QLatin1String("while"),
+    QLatin1String("with"), QLatin1String("yield")
+});
+
+/*!
+ * returns the comments of the language of @p backend, as used in its scripts
+ */
+EntryDependencies::Syntax EntryDependencies::syntax(Cantor::Backend* backend)
+{
+    Syntax syntax;
+    auto* extension = backend ? dynamic_cast<Cantor::ScriptExtension*>(backend->extension(QLatin1String("ScriptExtension"))) : nullptr;
+    if (!extension)
+        return syntax;
+
+    const QString& start = extension->commentStartingSequence().trimmed();
+    const QString& end = extension->commentEndingSequence().trimmed();
+    if (start.isEmpty())
+        return syntax;
+
+    if (end.isEmpty())
+    {
+        // the line comments of Octave start with % or #
+        syntax.lineComments = QStringList(start);
+        if (start == QLatin1String("%"))
+            syntax.lineComments << QStringLiteral("#");
+        syntax.blockCommentStart.clear();
+        syntax.blockCommentEnd.clear();
+    }
+    else
+    {
+        // Maxima has no line comments, its # is the "not equal" operator
+        syntax.lineComments.clear();
+        syntax.blockCommentStart = start;
+        syntax.blockCommentEnd = end;
+    }
+
+    return syntax;
+}
+
+EntryDependencies::Access EntryDependencies::analyze(const QString& command, const Syntax& syntax)
+{
+    Access access;
+
+    // R's assign("x", ...) and Python's globals()["x"] = ... name the written variable in a string
+    static const QRegularExpression namedWrite(QStringLiteral("(?:\\bassign\\s*\\(\\s*|\\bglobals\\s*\\(\\s*\\)\\s*\\[\\s*)([\"'])([A-Za-z_]\\w*)\\1"));
+    auto it = namedWrite.globalMatch(command);
+    while (it.hasNext())
+    {
+        const QString& name = it.next().captured(2);
+        access.writes.insert(name);
+        access.reads.insert(name);
+    }
+
+    const QString& code = stripStringsAndComments(command, syntax);
+
+    // the variables written by exec(), eval() and the like or by assign() and globals() with
+    // a computed name are unknown, the string literals are replaced by a space at this point
+    static const QRegularExpression dynamicWrite(QStringLiteral("(?<![\\w.$@])(?:(?:exec|eval|evalin|assignin|locals|vars|setattr)\\s*\\("
+                                                                "|globals\\s*\\(\\s*\\)(?!\\s*\\[\\s*\\])|assign\\s*\\((?!\\s*,))"));
+    access.unknownWrites = dynamicWrite.match(code).hasMatch();
+
+    static const QRegularExpression separator(QStringLiteral("[;\\n]"));
+    const QStringList& statements = code.split(separator, QString::SkipEmptyParts);
+    for (const QString& statement : statements)
+    {
+        analyzeStatement(statement, access);
+        analyzeModifications(statement, access);
+    }
+
+    access.reads.subtract(keywords);
+    access.writes.subtract(keywords);
+    return access;
+}
+
+void EntryDependencies::update(QVector<Node>& nodes, const Syntax& syntax)
+{
+    QHash<QString, int> lastWriter;
+    // the variables read by the body of the functions, by the name of the function
+    QHash<QString, QSet<QString>> calleeReads;
+    int lastUnknownWriter = -1;
+    QSet<QString> removedVariables;
+    bool unknownRemoved = false;
+
+    for (int i = 0; i < nodes.size(); ++i)
+    {
+        Node& node = nodes[i];
+        node.access = analyze(node.command, syntax);
+        node.changed = !node.evaluated || node.command != node.evaluatedCommand;
+
+        // calling a function reads the variables of its body with their values at the time of the call
+        QSet<QString> reads = node.access.reads;
+        QStringList called = reads.values();
+        while (!called.isEmpty())
+        {
+            const QSet<QString>& body = calleeReads.value(called.takeLast());
+            for (const QString& name : body)
+                if (!reads.contains(name))
+                {
+                    reads.insert(name);
+                    called << name;
+                }
+        }
+
+        node.dependencies.clear();
+        auto addDependency = [&node](int dependency) {
+            if (dependency != -1 && !node.dependencies.contains(dependency))
+                node.dependencies << dependency;
+        };
+        for (const QString& name : reads)
+            addDependency(lastWriter.value(name, -1));
+        if (!reads.isEmpty())
+            addDependency(lastUnknownWriter);
+        std::sort(node.dependencies.begin(), node.dependencies.end());
+
+        // stale are the changed nodes and, transitively, the nodes depending on them
+        node.stale = node.changed || reads.intersects(removedVariables)
+                     || (unknownRemoved && !reads.isEmpty());
+        for (int dependency : node.dependencies)
+            node.stale = node.stale || nodes.at(dependency).stale;
+
+        // the variables not written anymore by the changed command still have their old values
+        if (node.changed && node.evaluated)
+        {
+            const Access& evaluatedAccess = analyze(node.evaluatedCommand, syntax);
+            removedVariables.unite(QSet<QString>(evaluatedAccess.writes).subtract(node.access.writes));
+            unknownRemoved = unknownRemoved || (evaluatedAccess.unknownWrites && !node.access.unknownWrites);
+        }
+        removedVariables.subtract(node.access.writes);
+
+        for (const QString& name : node.access.writes)
+        {
+            lastWriter.insert(name, i);
+            if (node.access.definitions.contains(name))
+                calleeReads.insert(name, QSet<QString>(node.access.reads).subtract(node.access.writes));
+            else
+                calleeReads.remove(name);
+        }
+        if (node.access.unknownWrites)
+            lastUnknownWriter = i;
+    }
+}
+
+/*!
+ * replaces the string literals by a space and removes the comments of @p syntax
+ */
+QString EntryDependencies::stripStringsAndComments(const QString& command, const Syntax& syntax)
+{
+    auto startsLineComment = [&command, &syntax](int i) {
+        for (const QString& comment : syntax.lineComments)
+            if (command.midRef(i).startsWith(comment))
+                return true;
+        return false;
+    };
+
+    enum State {Code, String, LineComment, BlockComment};
+
+    QString code;
+    code.reserve(command.size());
+    State state = Code;
+    QChar quote;
+    QChar lastCodeChar;
+
+    for (int i = 0; i < command.size(); ++i)
+    {
+        const QChar c = command.at(i);
+
+        switch (state)
+        {
+        case Code:
+            if (!syntax.blockCommentStart.isEmpty() && command.midRef(i).startsWith(syntax.blockCommentStart))
+            {
+                state = BlockComment;
+                i += syntax.blockCommentStart.size() - 1;
+            }
+            else if (startsLineComment(i))
+                state = LineComment;
+            // ' after a value is the transpose operator of Octave and Julia
+            else if (c == QLatin1Char('"') || (c == QLatin1Char('\'')
+                     && !(lastCodeChar.isLetterOrNumber() || lastCodeChar == QLatin1Char('_') || lastCodeChar == QLatin1Char(')')
+                          || lastCodeChar == QLatin1Char(']') || lastCodeChar == QLatin1Char('\'') || lastCodeChar == QLatin1Char('.'))))
+            {
+                state = String;
+                quote = c;
+            }
+            else
+            {
+                code += c;
+                if (!c.isSpace())
+                    lastCodeChar = c;
+            }
+            break;
+        case String:
+            if (c == QLatin1Char('\\'))
+                ++i;
+            else if (c == quote)
+            {
+                state = Code;
+                code += QLatin1Char(' ');
+                lastCodeChar = QLatin1Char('_');
+            }
+            break;
+        case LineComment:
+            if (c == QLatin1Char('\n'))
+            {
+                state = Code;
+                code += c;
+            }
+            break;
+        case BlockComment:
+            if (command.midRef(i).startsWith(syntax.blockCommentEnd))
+            {
+                state = Code;
+                i += syntax.blockCommentEnd.size() - 1;
+            }
+            else if (c == QLatin1Char('\n'))
+                code += c;
+            break;
+        }
+    }
+
+    return code;
+}
+
+void EntryDependencies::analyzeStatement(const QString& statement, Access& access)
+{
+    auto addAll = [](QSet<QString>& set, const QStringList& names) {
+        for (const QString& name : names)
+            set.insert(name);
+    };
+
+    // function definitions of Octave with return values, "function r = f(x)"
+    static const QRegularExpression octaveFunction(QStringLiteral("^\\s*function\\s+(?:\\[[^\\]]*\\]|[A-Za-z_]\\w*)\\s*=\\s*([A-Za-z_]\\w*)(.*)$"));
+    static const QRegularExpression definition(QStringLiteral("^\\s*(?:def|class|function|macro|module|(?:mutable\\s+)?struct)\\s+([A-Za-z_]\\w*)(.*)$"));
+    static const QRegularExpression fromImport(QStringLiteral("^\\s*from\\s+[\\w.]+\\s+import\\s+(.+)$"));
+    static const QRegularExpression import(QStringLiteral("^\\s*(?:import|using)\\s+(.+)$"));
+    static const QRegularExpression forLoop(QStringLiteral("^\\s*for\\s+(.+?)\\s+in\\s+(.*)$"));
+    static const QRegularExpression colonAssignment(QStringLiteral("^\\s*([A-Za-z_]\\w*)\\s*:(?!=)(.*\\S.*)$"));
+
+    QRegularExpressionMatch match = octaveFunction.match(statement);
+    if (!match.hasMatch())
+        match = definition.match(statement);
+    if (match.hasMatch())
+    {
+        access.writes.insert(match.captured(1));
+        access.definitions.insert(match.captured(1));
+        addAll(access.reads, identifiers(match.captured(2)));
+        return;
+    }
+
+    match = fromImport.match(statement);
+    if (!match.hasMatch())
+        match = import.match(statement);
+    if (match.hasMatch())
+    {
+        // "import a.b as c" binds c, "import a.b" binds a, "using A: f, g" binds A, f and g
+        const QStringList& parts = match.captured(1).split(QRegularExpression(QStringLiteral("[,:]")), QString::SkipEmptyParts);
+        for (const QString& part : parts)
+        {
+            const QStringList& names = identifiers(part);
+            if (!names.isEmpty())
+                access.writes.insert(names.size() > 1 && part.contains(QLatin1String(" as ")) ? names.last() : names.first());
+        }
+        return;
+    }
+
+    match = forLoop.match(statement);
+    if (match.hasMatch())
+    {
+        addAll(access.writes, identifiers(match.captured(1)));
+        addAll(access.reads, identifiers(match.captured(2)));
+        return;
+    }
+
+    // find the assignment operator outside of brackets: =, <-, := and the augmented assignments like +=,
+    // but not the comparisons ==, <=, >=, != and ~= or =>
+    int depth = 0;
+    int position = -1;
+    int length = 0;
+    bool augmented = false;
+    for (int i = 0; i < statement.size() && position == -1; ++i)
+    {
+        const QChar c = statement.at(i);
+        const QChar next = i + 1 < statement.size() ? statement.at(i + 1) : QChar();
+        const QChar previous = i > 0 ? statement.at(i - 1) : QChar();
+
+        if (c == QLatin1Char('(') || c == QLatin1Char('[') || c == QLatin1Char('{'))
+            ++depth;
+        else if (c == QLatin1Char(')') || c == QLatin1Char(']') || c == QLatin1Char('}'))
+            depth = qMax(0, depth - 1);
+        else if (depth != 0)
+            continue;
+        else if ((c == QLatin1Char('<') && next == QLatin1Char('-')) || (c == QLatin1Char(':') && next == QLatin1Char('=')))
+        {
+            position = i;
+            length = 2;
+        }
+        else if (c == QLatin1Char('='))
+        {
+            if (next == QLatin1Char('=') || next == QLatin1Char('>'))
+                ++i;
+            else if (!QStringLiteral("=<>!~").contains(previous))
+            {
+                augmented = QStringLiteral("+-*/%^&|\\").contains(previous);
+                position = i;
+                length = 1;
+            }
+        }
+    }
+
+    if (position == -1)
+    {
+        // the assignment of Maxima, "x : 5", but not the blocks of Python like "else:"
+        match = colonAssignment.match(statement);
+        if (match.hasMatch() && !statement.trimmed().endsWith(QLatin1Char(':')))
+        {
+            access.writes.insert(match.captured(1));
+            addAll(access.reads, identifiers(match.captured(2)));
+        }
+        else
+            addAll(access.reads, identifiers(statement));
+        return;
+    }
+
+    QString lhs = statement.left(position);
+    while (augmented && !lhs.isEmpty() && QStringLiteral("+-*/%^&|\\").contains(lhs.at(lhs.size() - 1)))
+        lhs.chop(1);
+    addAll(access.reads, identifiers(statement.mid(position + length)));
+
+    // the header of a block on the same line like "if x > 0: y = 1" is read
+    depth = 0;
+    for (int i = lhs.size() - 1; i >= 0; --i)
+    {
+        const QChar c = lhs.at(i);
+        if (c == QLatin1Char(')') || c == QLatin1Char(']') || c == QLatin1Char('}'))
+            ++depth;
+        else if (c == QLatin1Char('(') || c == QLatin1Char('[') || c == QLatin1Char('{'))
+            depth = qMax(0, depth - 1);
+        else if (c == QLatin1Char(':') && depth == 0)
+        {
+            addAll(access.reads, identifiers(lhs.left(i)));
+            lhs = lhs.mid(i + 1);
+            break;
+        }
+    }
+
+    static const QRegularExpression leadingKeywords(QStringLiteral("^\\s*(?:(?:for|global|local|const|let|persistent)\\s+)+"));
+    lhs.remove(leadingKeywords);
+
+    // "f(x) = x^2" or "f(x) := x^2" defines the function f
+    static const QRegularExpression functionDefinition(QStringLiteral("^\\s*([A-Za-z_]\\w*)\\s*\\("));
+    match = functionDefinition.match(lhs);
+    if (match.hasMatch())
+    {
+        access.writes.insert(match.captured(1));
+        access.definitions.insert(match.captured(1));
+        return;
+    }
+
+    // the variables outside of brackets are written, "[a, b] = ..." of Octave too,
+    // the indices of "x[i] = ..." are read
+    const bool destructuring = lhs.trimmed().startsWith(QLatin1Char('['));
+    QString outer;
+    QString inner;
+    depth = 0;
+    for (const QChar c : lhs)
+    {
+        if (c == QLatin1Char('(') || c == QLatin1Char('[') || c == QLatin1Char('{'))
+        {
+            ++depth;
+            inner += QLatin1Char(' ');
+        }
+        else if (c == QLatin1Char(')') || c == QLatin1Char(']') || c == QLatin1Char('}'))
+        {
+            depth = qMax(0, depth - 1);
+            inner += QLatin1Char(' ');
+        }
+        else if (depth == 0 || (destructuring && depth == 1))
+            outer += c;
+        else
+            inner += c;
+    }
+
+    const QStringList& written = identifiers(outer);
+    addAll(access.writes, written);
+    addAll(access.reads, identifiers(inner));
+
+    // the assignment to an element or an attribute modifies the existing variable,
+    // anything else than plain names is read too, so that no dependency is missed
+    static const QRegularExpression plainNames(QStringLiteral("^[\\s\\w,]*$"));
+    if (augmented || !plainNames.match(destructuring ? outer : lhs).hasMatch())
+        addAll(access.reads, written);
+}
+
+/*!
+ * adds the variables modified in place by @p statement to the writes
+ */
+void EntryDependencies::analyzeModifications(const QString& statement, Access& access)
+{
+    // "lst.append(x)", "df.drop(...)" and "a.b.c(...)" might modify the receiver,
+    // "x[i]" might be assigned to or be the receiver of a call like "x[0].update(y)"
+    static const QRegularExpression receiver(QStringLiteral("(?<![\\w.$@])([A-Za-z_]\\w*)(?=\\s*\\[|(?:\\s*\\.\\s*[A-Za-z_]\\w*)+\\s*[\\[(])"));
+    // "with open(p) as f", "except E as e"
+    static const QRegularExpression alias(QStringLiteral("\\bas\\s+([A-Za-z_]\\w*)"));
+    // "push!(v, x)", the functions of Julia ending with ! modify their first argument
+    static const QRegularExpression mutatingFunction(QStringLiteral("[A-Za-z_]\\w*!\\s*\\(\\s*([A-Za-z_]\\w*)"));
+    // "del x", "global x", "clear x" of Octave, "kill(x)" of Maxima and "rm(x)" of R
+    static const QRegularExpression deletion(QStringLiteral("^\\s*(?:del|global|nonlocal|clear|kill|rm)\\b(?!\\s*=)(.*)$"));
+
+    // the name bound by "as" doesn't depend on its previous value
+    auto it = alias.globalMatch(statement);
+    while (it.hasNext())
+        access.writes.insert(it.next().captured(1));
+
+    QStringList names;
+    for (const QRegularExpression* expression : {&receiver, &mutatingFunction})
+    {
+        it = expression->globalMatch(statement);
+        while (it.hasNext())
+            names << it.next().captured(1);
+    }
+
+    const QRegularExpressionMatch& match = deletion.match(statement);
+    if (match.hasMatch())
+        names << identifiers(match.captured(1));
+
+    // the modified value depends on the previous one
+    for (const QString& name : names)
+    {
+        access.writes.insert(name);
+        access.reads.insert(name);
+    }
+}
+
+QStringList EntryDependencies::identifiers(const QString& code)
+{
+    // attributes like the "y" of "x.y" are not variables
+    static const QRegularExpression identifier(QStringLiteral("(?<![\\w.$@])([A-Za-z_]\\w*)"));
+
+    QStringList names;
+    auto it = identifier.globalMatch(code);
+    while (it.hasNext())
+        names << it.next().captured(1);
+    return names;
+}
@@ -0,0 +1,91 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#ifndef ENTRYDEPENDENCIES_H
+#define ENTRYDEPENDENCIES_H
+
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace Cantor {
+    class Backend;
+}
+
+/**
+ * Dependencies between the command entries of a worksheet, used to evaluate
+ * only the entries which are out of date after a change.
+ *
+ * The variables read and written by a command are found by a lexical analysis
+ * of the command, which works for all backends: assignments (=, <-, :=, : and the
+ * augmented assignments), definitions of functions and classes, loop variables,
+ * imports, "with ... as", "del" and "global" are writes. Since a method call or an
+ * element access can modify the object in place, the receivers of method calls
+ * like "lst.append(x)", the subscripted names and the first arguments of the
+ * mutating functions of Julia are writes too. All other identifiers are reads.
+ *
+ * A function reads the variables used in its body when it's called, an entry calling
+ * it depends on the entries writing them before the call, also if they follow the definition.
+ *
+ * The writes of exec(), eval(), globals(), setattr() and the like can't be known,
+ * such a command is considered to write every variable. Not detected are the
+ * modifications hidden in called functions, e.g. a function changing a global
+ * list passed to it under another name, the entries calling it have to be
+ * evaluated by hand.
+ */
+class EntryDependencies
+{
+  public:
+    struct Access
+    {
+        QSet<QString> reads;
+        QSet<QString> writes;
+        bool unknownWrites{false}; // might write any variable, e.g. by exec() or eval()
+        QSet<QString> definitions; // the written functions and classes, they read the variables of their body when called
+    };
+
+    /**
+     * The comments of the language of the backend, the default are the comments of Python and C
+     */
+    struct Syntax
+    {
+        QStringList lineComments{QStringLiteral("#")};
+        QString blockCommentStart{QStringLiteral("/*")};
+        QString blockCommentEnd{QStringLiteral("*/")};
+    };
+
+    /**
+     * One command entry, in the order of the worksheet
+     */
+    struct Node
+    {
+        QString command;
+        QString evaluatedCommand; // the command at the last successful evaluation
+        bool evaluated{false};
+
+        // set by update()
+        Access access;
+        QVector<int> dependencies; // nodes writing the variables read by this node
+        bool changed{false};       // not evaluated in its current version
+        bool stale{false};         // changed or reading variables written by stale nodes
+    };
+
+    static Syntax syntax(Cantor::Backend* backend);
+    static Access analyze(const QString& command, const Syntax& syntax = Syntax());
+
+    /**
+     * Computes the accessed variables, the dependencies and the state of @p nodes
+     */
+    static void update(QVector<Node>& nodes, const Syntax& syntax = Syntax());
+
+  private:
+    static QString stripStringsAndComments(const QString& command, const Syntax& syntax);
+    static void analyzeStatement(const QString& statement, Access& access);
+    static void analyzeModifications(const QString& statement, Access& access);
+    static QStringList identifiers(const QString& code);
+};
+
+#endif /* ENTRYDEPENDENCIES_H */
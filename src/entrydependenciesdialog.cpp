@@ -0,0 +1,86 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#include "entrydependenciesdialog.h"
+
+#include <QDialogButtonBox>
+#include <QHeaderView>
+#include <QLabel>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include <KLocalizedString>
+
+static QString sortedNames(const QSet<QString>& names)
+{
+    QStringList list = names.values();
+    list.sort();
+    return list.join(QLatin1String(", "));
+}
+
+EntryDependenciesDialog::EntryDependenciesDialog(const QVector<EntryDependencies::Node>& nodes, QWidget* parent)
+    : QDialog(parent), m_tree(new QTreeWidget(this))
+{
+    setWindowTitle(i18nc("@title:window", "Entry Dependencies"));
+    setWindowIcon(QIcon::fromTheme(QLatin1String("distribute-graph-directed")));
+    setAttribute(Qt::WA_DeleteOnClose);
+
+    auto* label = new QLabel(i18n("The variables read and written by the command entries are determined from their commands. "
+                                  "\"Evaluate Changed Entries\" evaluates the changed entries and the entries depending on them, "
+                                  "the entries which are up to date are skipped."), this);
+    label->setWordWrap(true);
+
+    m_tree->setRootIsDecorated(false);
+    m_tree->setHeaderLabels(QStringList() << i18n("Entry") << i18n("Command") << i18n("Reads") << i18n("Writes")
+                                          << i18n("Depends On") << i18n("State"));
+
+    int staleCount = 0;
+    for (int i = 0; i < nodes.size(); ++i)
+    {
+        const auto& node = nodes.at(i);
+
+        QStringList dependencies;
+        for (int dependency : node.dependencies)
+            dependencies << QString::number(dependency + 1);
+
+        QString state;
+        if (node.changed)
+            state = node.evaluated ? i18n("Changed") : i18n("Not evaluated");
+        else if (node.stale)
+            state = i18n("Depends on a changed entry");
+        else
+            state = i18n("Up to date, skipped");
+
+        auto* item = new QTreeWidgetItem(m_tree);
+        item->setText(0, QString::number(i + 1));
+        item->setText(1, node.command.section(QLatin1Char('\n'), 0, 0).simplified());
+        item->setToolTip(1, node.command);
+        item->setText(2, sortedNames(node.access.reads));
+        if (node.access.unknownWrites)
+            item->setText(3, i18nc("@item written variables", "any variable"));
+        else
+            item->setText(3, sortedNames(node.access.writes));
+        item->setText(4, dependencies.join(QLatin1String(", ")));
+        item->setText(5, state);
+        if (!node.stale)
+            item->setForeground(5, palette().color(QPalette::Disabled, QPalette::Text));
+        else
+            ++staleCount;
+    }
+    m_tree->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+
+    auto* summary = new QLabel(i18n("%1 of %2 entries are evaluated, %3 are skipped.", staleCount, nodes.size(), nodes.size() - staleCount), this);
+
+    auto* buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, this);
+    connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
+
+    auto* layout = new QVBoxLayout(this);
+    layout->addWidget(label);
+    layout->addWidget(m_tree);
+    layout->addWidget(summary);
+    layout->addWidget(buttonBox);
+
+    resize(800, 400);
+}
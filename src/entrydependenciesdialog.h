@@ -0,0 +1,30 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#ifndef ENTRYDEPENDENCIESDIALOG_H
+#define ENTRYDEPENDENCIESDIALOG_H
+
+#include <QDialog>
+
+#include "entrydependencies.h"
+
+class QTreeWidget;
+
+/**
+ * Shows the dependencies between the command entries of a worksheet
+ * and which of them are evaluated by "Evaluate Changed Entries"
+ */
+class EntryDependenciesDialog : public QDialog
+{
+  Q_OBJECT
+  public:
+    EntryDependenciesDialog(const QVector<EntryDependencies::Node>&, QWidget*);
+    ~EntryDependenciesDialog() override = default;
+
+  private:
+    QTreeWidget* m_tree;
+};
+
+#endif // ENTRYDEPENDENCIESDIALOG_H
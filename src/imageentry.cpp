@@ -121,7 +121,7 @@ QJsonValue ImageEntry::toJupyterJson()
 
     if (!m_imagePath.isEmpty() && m_imageItem)
     {
-        const QImage& image = m_imageItem->pixmap().toImage();
+        const QImage& image = m_imageItem->image();
         if (!image.isNull())
         {
             QJsonObject entry;
@@ -272,15 +272,13 @@ void ImageEntry::updateEntry()
             if (imagePath.endsWith(QLatin1String(".eps"), Qt::CaseInsensitive)) {
                 m_imageItem->setEps(QUrl::fromLocalFile(imagePath));
             } else {
-                QImage img(imagePath);
-                m_imageItem->setImage(img);
+                m_imageItem->setImageFile(imagePath);
             }
         } else {
             if (m_imagePath.endsWith(QLatin1String(".eps"), Qt::CaseInsensitive)) {
                 m_imageItem->setEps(QUrl::fromLocalFile(m_imagePath));
             } else {
-                QImage img(m_imagePath);
-                m_imageItem->setImage(img);
+                m_imageItem->setImageFile(m_imagePath);
             }
         }
 
@@ -40,8 +40,13 @@ void ImageResultItem::update()
     switch(m_result->type()) {
     case Cantor::ImageResult::Type:
     {
-        QSize displaySize = static_cast<Cantor::ImageResult*>(m_result)->displaySize();
-        if (displaySize.isValid())
+        auto* imageResult = static_cast<Cantor::ImageResult*>(m_result);
+        QSize displaySize = imageResult->displaySize();
+        const QUrl& url = imageResult->url();
+        // images are decoded or rasterized from their file in the displayed resolution
+        if (url.isLocalFile())
+            setImageFile(url.toLocalFile(), displaySize);
+        else if (displaySize.isValid())
             setImage(m_result->data().value<QImage>(), displaySize);
         else
             setImage(m_result->data().value<QImage>());
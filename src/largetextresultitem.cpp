@@ -0,0 +1,246 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#include "largetextresultitem.h"
+#include "commandentry.h"
+#include "worksheetcursor.h"
+#include "worksheetview.h"
+#include "lib/largetextbuffer.h"
+#include "lib/textresult.h"
+#include "settings.h"
+
+#include <QApplication>
+#include <QClipboard>
+#include <QFileDialog>
+#include <QGraphicsSceneWheelEvent>
+#include <QPainter>
+#include <QTextBlock>
+
+#include <KLocalizedString>
+#include <KStandardAction>
+
+// amount of lines shown if no limit for the visible lines is set in the settings
+static const int DefaultVisibleLines = 40;
+
+LargeTextResultItem::LargeTextResultItem(WorksheetEntry* parent, Cantor::Result* result)
+    : WorksheetTextItem(parent), ResultItem(result)
+{
+    setTextInteractionFlags(Qt::TextSelectableByMouse);
+    update();
+
+    auto* textResult = static_cast<Cantor::TextResult*>(result);
+    if (textResult->isWarning())
+        setDefaultTextColor(qApp->palette().color(QPalette::Highlight));
+}
+
+LargeTextResultItem::~LargeTextResultItem() = default;
+
+bool LargeTextResultItem::isLargeResult(Cantor::Result* result)
+{
+    // the threshold is set from the settings, see Worksheet::handleSettingsChanges()
+    return result->type() == Cantor::TextResult::Type && static_cast<Cantor::TextResult*>(result)->isLarge();
+}
+
+double LargeTextResultItem::setGeometry(double x, double y, double w)
+{
+    return WorksheetTextItem::setGeometry(x, y, w);
+}
+
+void LargeTextResultItem::populateMenu(QMenu* menu, QPointF)
+{
+    auto* copy = KStandardAction::copy(this, SLOT(copy()), menu);
+    copy->setEnabled(textCursor().hasSelection());
+    menu->addAction(copy);
+    menu->addAction(QIcon::fromTheme(QLatin1String("edit-copy")), i18n("Copy result"), this, SLOT(copyAll()));
+    ResultItem::addCommonActions(this, menu);
+}
+
+void LargeTextResultItem::update()
+{
+    // the buffer of the result is only extended by appended text, the visible lines are filled again
+    Q_ASSERT(m_result->type() == Cantor::TextResult::Type);
+    m_firstLine = qBound(0, m_firstLine, buffer()->lineCount() - visibleLineCount());
+    fillVisibleLines();
+}
+
+double LargeTextResultItem::width() const
+{
+    return WorksheetTextItem::width();
+}
+
+double LargeTextResultItem::height() const
+{
+    return WorksheetTextItem::height();
+}
+
+void LargeTextResultItem::deleteLater()
+{
+    WorksheetTextItem::deleteLater();
+}
+
+int LargeTextResultItem::firstVisibleLine() const
+{
+    return m_firstLine;
+}
+
+int LargeTextResultItem::visibleLineCount() const
+{
+    const int limit = Settings::visibleLinesLimit();
+    const int lines = limit > 0 ? limit : DefaultVisibleLines;
+    return qMin(lines, buffer()->lineCount());
+}
+
+void LargeTextResultItem::scrollToLine(int line)
+{
+    line = qBound(0, line, buffer()->lineCount() - visibleLineCount());
+    if (line == m_firstLine)
+        return;
+
+    m_firstLine = line;
+    fillVisibleLines();
+}
+
+const Cantor::LargeTextBuffer* LargeTextResultItem::buffer() const
+{
+    return static_cast<Cantor::TextResult*>(m_result)->textBuffer();
+}
+
+void LargeTextResultItem::fillVisibleLines()
+{
+    // only the visible lines are put into the document and layouted
+    setPlainText(buffer()->lines(m_firstLine, visibleLineCount()));
+}
+
+void LargeTextResultItem::copyAll()
+{
+    QApplication::clipboard()->setText(static_cast<Cantor::TextResult*>(m_result)->plain());
+}
+
+void LargeTextResultItem::saveResult()
+{
+    const auto& fileName = QFileDialog::getSaveFileName(worksheet()->worksheetView(), i18n("Save text result"), QString(),  i18n("Text Files (*.txt)"));
+    if (!fileName.isEmpty())
+        result()->save(fileName);
+}
+
+void LargeTextResultItem::wheelEvent(QGraphicsSceneWheelEvent* event)
+{
+    if (event->orientation() != Qt::Vertical)
+    {
+        WorksheetTextItem::wheelEvent(event);
+        return;
+    }
+
+    // scroll inside of the item as long as possible, the worksheet is scrolled at the beginning and at the end
+    const int lines = -event->delta() / 120 * QApplication::wheelScrollLines();
+    const int previousLine = m_firstLine;
+    scrollToLine(m_firstLine + (lines != 0 ? lines : (event->delta() > 0 ? -1 : 1)));
+    if (m_firstLine != previousLine)
+        event->accept();
+    else
+        WorksheetTextItem::wheelEvent(event);
+}
+
+void LargeTextResultItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* o, QWidget* w)
+{
+    WorksheetTextItem::paint(painter, o, w);
+
+    const int lineCount = buffer()->lineCount();
+    const int visibleLines = visibleLineCount();
+    if (lineCount <= visibleLines)
+        return;
+
+    // indicate the position of the visible lines in the whole text
+    const QRectF& rect = boundingRect();
+    const qreal handleHeight = qMax(qreal(8), rect.height() * visibleLines / lineCount);
+    const qreal handleY = (rect.height() - handleHeight) * m_firstLine / (lineCount - visibleLines);
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(qApp->palette().color(QPalette::Mid));
+    painter->drawRoundedRect(QRectF(rect.right() - 5, rect.top() + handleY, 4, handleHeight), 2, 2);
+}
+
+QTextCursor LargeTextResultItem::search(QString pattern,
+                                        QTextDocument::FindFlags qt_flags,
+                                        const WorksheetCursor& pos)
+{
+    if (pattern.isEmpty() || (pos.isValid() && pos.textItem() != this))
+        return QTextCursor();
+
+    // search in the whole text and not only in the visible lines
+    const bool backward = qt_flags & QTextDocument::FindBackward;
+    int line;
+    int column;
+    if (pos.isValid())
+    {
+        const QTextCursor& cursor = pos.textCursor();
+        const int position = backward ? cursor.selectionStart() : cursor.selectionEnd();
+        const QTextBlock& block = document()->findBlock(position);
+        line = m_firstLine + block.blockNumber();
+        column = position - block.position();
+    }
+    else
+    {
+        line = backward ? buffer()->lineCount() - 1 : 0;
+        column = backward ? -1 : 0;
+    }
+
+    while (line >= 0 && line < buffer()->lineCount())
+    {
+        const int index = findInLine(buffer()->line(line), pattern, column, qt_flags);
+        if (index != -1)
+        {
+            const int visibleLines = visibleLineCount();
+            if (line < m_firstLine || line >= m_firstLine + visibleLines)
+                scrollToLine(line - visibleLines / 2);
+
+            const QTextBlock& block = document()->findBlockByNumber(line - m_firstLine);
+            QTextCursor cursor(document());
+            cursor.setPosition(block.position() + index);
+            cursor.setPosition(block.position() + index + pattern.size(), QTextCursor::KeepAnchor);
+            return cursor;
+        }
+
+        line += backward ? -1 : 1;
+        column = backward ? -1 : 0;
+    }
+
+    return QTextCursor();
+}
+
+/*!
+ * returns the position of @p pattern in @p line starting the search at @p from.
+ * For backward searches the match has to start before @p from, -1 searches from the end of the line.
+ */
+int LargeTextResultItem::findInLine(const QString& line, const QString& pattern, int from, QTextDocument::FindFlags qt_flags) const
+{
+    const auto cs = (qt_flags & QTextDocument::FindCaseSensitively) ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    const bool backward = qt_flags & QTextDocument::FindBackward;
+
+    auto isWordBoundary = [&line](int position) {
+        return position < 0 || position >= line.size()
+            || !(line.at(position).isLetterOrNumber() || line.at(position) == QLatin1Char('_'));
+    };
+
+    int index;
+    if (backward)
+    {
+        if (from == 0)
+            return -1;
+        index = line.lastIndexOf(pattern, from < 0 ? -1 : from - 1, cs);
+    }
+    else
+        index = line.indexOf(pattern, from, cs);
+
+    while (index != -1 && (qt_flags & QTextDocument::FindWholeWords)
+           && !(isWordBoundary(index - 1) && isWordBoundary(index + pattern.size())))
+    {
+        if (backward)
+            index = index > 0 ? line.lastIndexOf(pattern, index - 1, cs) : -1;
+        else
+            index = line.indexOf(pattern, index + 1, cs);
+    }
+
+    return index;
+}
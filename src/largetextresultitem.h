@@ -0,0 +1,68 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#ifndef LARGETEXTRESULTITEM_H
+#define LARGETEXTRESULTITEM_H
+
+#include "resultitem.h"
+#include "worksheettextitem.h"
+
+namespace Cantor {
+    class LargeTextBuffer;
+}
+
+/*
+ * Result item for large text results. Instead of putting the whole text into the
+ * document of the text item, the document only contains the lines currently visible
+ * in the item, taken from the LargeTextBuffer of the result. The item has a fixed
+ * number of lines and is scrolled with the mouse wheel, the search of the worksheet
+ * is done on the whole text and scrolls to the found lines.
+ */
+class LargeTextResultItem : public WorksheetTextItem, public ResultItem
+{
+  Q_OBJECT
+  public:
+    explicit LargeTextResultItem(WorksheetEntry*, Cantor::Result*);
+    ~LargeTextResultItem() override;
+
+    static bool isLargeResult(Cantor::Result*);
+
+    using WorksheetTextItem::setGeometry;
+    double setGeometry(double x, double y, double w) override;
+    void populateMenu(QMenu*, QPointF) override;
+
+    void update() override;
+
+    double width() const override;
+    double height() const override;
+
+    void deleteLater() override;
+
+    QTextCursor search(QString pattern,
+                       QTextDocument::FindFlags qt_flags,
+                       const WorksheetCursor& pos) override;
+
+    int firstVisibleLine() const;
+    int visibleLineCount() const;
+    void scrollToLine(int line);
+
+  protected Q_SLOTS:
+    void copyAll();
+    void saveResult();
+
+  protected:
+    void wheelEvent(QGraphicsSceneWheelEvent*) override;
+    void paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget*) override;
+
+  private:
+    const Cantor::LargeTextBuffer* buffer() const;
+    void fillVisibleLines();
+    int findInLine(const QString& line, const QString& pattern, int from, QTextDocument::FindFlags qt_flags) const;
+
+  private:
+    int m_firstLine{0};
+};
+
+#endif // LARGETEXTRESULTITEM_H
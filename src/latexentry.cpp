@@ -117,7 +117,8 @@ void LatexEntry::setContent(const QDomElement& content, const KZip& file)
 
 #ifdef LIBSPECTRE_FOUND
             QString uuid = Cantor::LatexRenderer::genUuid();
-            m_renderedFormat = worksheet()->renderer()->render(m_textItem->document(), Cantor::Renderer::EPS, QUrl::fromLocalFile(imagePath), uuid);
+            const QUrl& url = QUrl::fromLocalFile(imagePath);
+            m_renderedFormat = worksheet()->renderer()->render(m_textItem->document(), Cantor::Renderer::methodForUrl(url), url, uuid);
             qDebug()<<"rendering successful? " << !m_renderedFormat.name().isEmpty();
 
             m_renderedFormat.setProperty(Cantor::Renderer::CantorFormula, Cantor::Renderer::LatexFormula);
@@ -367,8 +368,7 @@ void LatexEntry::updateEntry()
         qDebug()<<"found a formula... rendering the eps...";
         QTextImageFormat format=cursor.charFormat().toImageFormat();
         const QUrl& url=QUrl::fromLocalFile(format.property(Cantor::Renderer::ImagePath).toString());
-        QSizeF s = worksheet()->renderer()->renderToResource(m_textItem->document(), Cantor::Renderer::EPS, url, QUrl(format.name()));
-        qDebug()<<"rendering successful? "<< s.isValid();
+        worksheet()->mathRenderer()->rerender(m_textItem->document(), url, QUrl(format.name()));
 
         cursor.movePosition(QTextCursor::NextCharacter);
 
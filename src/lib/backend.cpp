@@ -6,10 +6,14 @@
 #include <vector>
 
 #include "backend.h"
+#include "backendrequirements.h"
 #include "extension.h"
 
 #include <QCoreApplication>
+#include <QDebug>
 #include <QDir>
+#include <QHash>
+#include <QJsonObject>
 #include <QPluginLoader>
 #include <QProcess>
 #include <QRegularExpression>
@@ -18,7 +22,6 @@
 
 #include <KPluginFactory>
 #include <KPluginMetaData>
-#include <KPluginFactory>
 #include <KLocalizedString>
 
 using namespace Cantor;
@@ -30,6 +33,7 @@ class Cantor::BackendPrivate
     QString comment;
     QString icon;
     QString url;
+    QString pluginId;
     bool enabled{true};
     QList<GraphicPackage> supportedGraphicPackagesCache;
 };
@@ -70,14 +74,26 @@ QString Backend::url() const
     return d->url;
 }
 
+QString Backend::pluginId() const
+{
+    return d->pluginId;
+}
+
 QString Backend::defaultHelp() const
 {
     return QString();
 }
 
+bool Backend::requiredExecutable(QString* name, QString* path) const
+{
+    Q_UNUSED(name);
+    Q_UNUSED(path);
+    return false;
+}
+
 bool Backend::isEnabled() const
 {
-    return d->enabled && requirementsFullfilled();
+    return d->enabled && BackendRequirements::instance()->isFulfilled(this);
 }
 
 void Backend::setEnabled(bool enabled)
@@ -85,57 +101,76 @@ void Backend::setEnabled(bool enabled)
     d->enabled = enabled;
 }
 
+/*!
+ * returns the loaded backend of @p plugin, the plugin is loaded on the first call
+ */
+Backend* Backend::loadBackend(const KPluginMetaData& plugin)
+{
+    // nullptr for the plugins which failed to load
+    static QHash<QString, Backend*> backendCache;
+    const auto it = backendCache.constFind(plugin.pluginId());
+    if (it != backendCache.constEnd())
+        return it.value();
+
+    const auto result = KPluginFactory::instantiatePlugin<Backend>(plugin, QCoreApplication::instance());
+    if (!result)
+        qDebug() << "Error while loading backend: " << result.errorText;
+
+    Backend* backend = result.plugin;
+    if (backend)
+    {
+        backend->d->name = plugin.name();
+        backend->d->comment = plugin.description();
+        backend->d->icon = plugin.iconName();
+        backend->d->url = plugin.website();
+        backend->d->pluginId = plugin.pluginId();
+    }
+    backendCache.insert(plugin.pluginId(), backend);
+    return backend;
+}
+
 QStringList Backend::listAvailableBackends()
 {
+    auto* requirements = BackendRequirements::instance();
+
     QStringList l;
-    for (Backend* b : availableBackends())
+    for (const auto& plugin : availableBackendsMetaData())
     {
-        if(b->isEnabled())
-            l<<b->name();
+        if (requirements->state(plugin.pluginId()) != BackendRequirements::Missing)
+            l<<plugin.name();
     }
 
     return l;
 }
 
+QVector<KPluginMetaData> Backend::availableBackendsMetaData()
+{
+    static const QVector<KPluginMetaData> plugins = KPluginMetaData::findPlugins(QStringLiteral("cantor/backends"));
+    return plugins;
+}
+
 QList<Backend*> Backend::availableBackends()
 {
-    static QList<Backend*> backendCache;
-    //if we already have all backends Cached, just return the cache.
-    //otherwise create the available backends
-    if(!backendCache.isEmpty())
+    QList<Backend*> backends;
+    for (const auto& plugin : availableBackendsMetaData())
     {
-        return backendCache;
-    }
-
-    const QVector<KPluginMetaData> plugins = KPluginMetaData::findPlugins(QStringLiteral("cantor/backends"));
-
-    for (const KPluginMetaData &plugin : plugins) {
-
-        const auto result = KPluginFactory::instantiatePlugin<Backend>(plugin, QCoreApplication::instance());
-
-        if (!result) {
-            qDebug() << "Error while loading backend: " << result.errorText;
-            continue;
-        }
-
-        Backend *backend = result.plugin;
-
-        backend->d->name = plugin.name();
-        backend->d->comment = plugin.description();
-        backend->d->icon = plugin.iconName();
-        backend->d->url = plugin.website();
-        backendCache << backend;
+        Backend* backend = loadBackend(plugin);
+        if (backend)
+            backends << backend;
     }
 
-    return backendCache;
+    return backends;
 }
 
 Backend* Backend::getBackend(const QString& name)
 {
-    for (Backend* b : availableBackends())
+    // the ids of the backends match their untranslated names, so the plugin can be found by its metadata
+    const QString& lowerName = name.toLower();
+    for (const auto& plugin : availableBackendsMetaData())
     {
-        if(b->name().toLower()==name.toLower() || b->id().toLower()==name.toLower())
-            return b;
+        const QString& untranslatedName = plugin.rawData().value(QLatin1String("KPlugin")).toObject().value(QLatin1String("Name")).toString();
+        if (plugin.name().toLower() == lowerName || untranslatedName.toLower() == lowerName || plugin.pluginId().toLower() == lowerName)
+            return loadBackend(plugin);
     }
 
     return nullptr;
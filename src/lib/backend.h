@@ -6,9 +6,11 @@
 #ifndef _BACKEND_H
 #define _BACKEND_H
 
+#include <KPluginMetaData>
 #include <KXMLGUIClient>
 #include <QObject>
 #include <QVariant>
+#include <QVector>
 
 #include "graphicpackage.h"
 
@@ -56,6 +58,9 @@ class CANTOR_EXPORT Backend : public QObject, public KXMLGUIClient
         VariableManagement = 0x20, ///< it offers access to the variables (for variable management panel)
         VariableDimension = 0x21, ///< it is able to show the dimensions of a variable (number of rows and columns)
         IntegratedPlots = 0x40,    ///< it offers, that backend supports plot not only as separate window, but also image result
+        PipelinedEvaluation = 0x80, /**< it accepts further expressions while the previous ones are still running,
+                                         @see Session::beginPipeline()
+                                    */
     };
     Q_DECLARE_FLAGS(Capabilities, Capability)
 
@@ -94,6 +99,17 @@ class CANTOR_EXPORT Backend : public QObject, public KXMLGUIClient
     */
     virtual bool requirementsFullfilled(QString* const reason = nullptr) const = 0;
 
+    /**
+     * Describes the requirements of this backend by the executable it needs, for checking them
+     * outside of the GUI thread, where the settings of the backend must not be read.
+     * BackendRequirements calls this in the GUI thread and checks the executable with
+     * checkExecutable() in the thread pool.
+     * @param name set to the name of the executable used in the messages, left empty if no executable is needed
+     * @param path set to the path of the executable
+     * @return @c false if the requirements can't be described like this, requirementsFullfilled() is used then
+     */
+    virtual bool requiredExecutable(QString* name, QString* path) const;
+
     /**
      * Returns a unique string to identify this backend.
      * In contrast to name() this string isn't translated
@@ -129,6 +145,11 @@ class CANTOR_EXPORT Backend : public QObject, public KXMLGUIClient
      * @return the url
      */
     QString url() const;
+    /**
+     * Returns the id of the plugin providing this backend
+     * @return the plugin id
+     */
+    QString pluginId() const;
     /**
      * Returns an Url pointing to the Help of the Backend
      * The method should be overwritten by all Backends(who have an online help)
@@ -150,6 +171,7 @@ class CANTOR_EXPORT Backend : public QObject, public KXMLGUIClient
      * @return @c true, if the enabled flag is set to true, and the requirements are fulfilled
      * @return @c false, if the backend was purposely disabled, or requirements are missing
      * @see requirementsFullfilled()
+     * @see BackendRequirements
      */
     bool isEnabled() const;
     /**
@@ -189,18 +211,27 @@ class CANTOR_EXPORT Backend : public QObject, public KXMLGUIClient
     Extension* extension(const QString& name) const;
 
     /**
-     * Returns a list of the names of all the installed and enabled backends
+     * Returns a list of the names of all the installed and enabled backends.
+     * The plugins aren't loaded for this, the requirements known from the last
+     * check are used, see BackendRequirements.
      * @return a list of the names of all the installed and enabled backends
      * @see isEnabled()
      */
     static QStringList listAvailableBackends();
     /**
-     * Returns Pointers to all the installed backends
+     * Returns the metadata (name, icon, description etc.) of all the installed backends without loading their plugins
+     * @return the metadata of all the installed backends
+     */
+    static QVector<KPluginMetaData> availableBackendsMetaData();
+    /**
+     * Returns Pointers to all the installed backends. This loads the plugins of all backends,
+     * use availableBackendsMetaData() or getBackend() if possible.
      * @return Pointers to all the installed backends
      */
     static QList<Backend*> availableBackends();
     /**
-     * Returns the backend with the given name, or null if it isn't found
+     * Returns the backend with the given name or plugin id, or null if it isn't found.
+     * Only the plugin of this backend is loaded.
      * @return the backend with the given name, or null if it isn't found
      */
     static Backend* getBackend(const QString& name);
@@ -226,6 +257,9 @@ class CANTOR_EXPORT Backend : public QObject, public KXMLGUIClient
      */
     QList<GraphicPackage> availableGraphicPackages() const;
 
+  private:
+    static Backend* loadBackend(const KPluginMetaData& plugin);
+
   private:
     BackendPrivate* d;
 };
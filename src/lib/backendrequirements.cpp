@@ -0,0 +1,218 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#include "backendrequirements.h"
+using namespace Cantor;
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFileInfo>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <KConfigGroup>
+#include <KPluginMetaData>
+#include <KSharedConfig>
+
+#include "backend.h"
+
+static const QLatin1String configGroup("BackendRequirements");
+static const QLatin1String reasonKey("Reason");
+static const QLatin1String pluginKey("Plugin");
+
+static QDateTime pluginModified(const QString& pluginId)
+{
+    for (const auto& plugin : Backend::availableBackendsMetaData())
+        if (plugin.pluginId() == pluginId)
+            return QFileInfo(plugin.fileName()).lastModified();
+
+    return QDateTime();
+}
+
+BackendRequirementsTask::BackendRequirementsTask(const QString& name, const QString& path) : m_name(name), m_path(path)
+{
+}
+
+void BackendRequirementsTask::run()
+{
+    QString reason;
+    const bool fulfilled = Backend::checkExecutable(m_name, m_path, &reason);
+    emit finished(fulfilled, reason);
+    deleteLater();
+}
+
+BackendRequirements* BackendRequirements::instance()
+{
+    static BackendRequirements* requirements = nullptr;
+    if (!requirements)
+        requirements = new BackendRequirements(QCoreApplication::instance());
+    return requirements;
+}
+
+BackendRequirements::BackendRequirements(QObject* parent) : QObject(parent)
+{
+    // results of the previous run, "<plugin id>=<fulfilled>", "<plugin id>Reason=<reason>"
+    // and "<plugin id>Plugin=<modification time of the plugin file>"
+    const KConfigGroup group(KSharedConfig::openConfig(), configGroup);
+    const QStringList& keys = group.keyList();
+    for (const QString& key : keys)
+    {
+        if (key.endsWith(reasonKey) || key.endsWith(pluginKey))
+            continue;
+
+        Result result;
+        result.fulfilled = group.readEntry(key, false);
+        result.reason = group.readEntry(key + reasonKey, QString());
+        result.pluginModified = group.readEntry(key + pluginKey, QDateTime());
+        m_results.insert(key, result);
+    }
+}
+
+BackendRequirements::State BackendRequirements::state(const QString& pluginId) const
+{
+    const auto it = m_results.constFind(pluginId);
+    if (it == m_results.constEnd())
+        return Unknown;
+
+    return it->fulfilled ? Fulfilled : Missing;
+}
+
+QString BackendRequirements::reason(const QString& pluginId) const
+{
+    return m_results.value(pluginId).reason;
+}
+
+bool BackendRequirements::isFulfilled(const Backend* backend, QString* const reason)
+{
+    const auto it = m_results.constFind(backend->pluginId());
+    if (it != m_results.constEnd() && it->current)
+    {
+        if (reason)
+            *reason = it->reason;
+        return it->fulfilled;
+    }
+
+    QString missing;
+    const bool fulfilled = backend->requirementsFullfilled(&missing);
+    store(backend->pluginId(), fulfilled, missing);
+    if (reason)
+        *reason = missing;
+    return fulfilled;
+}
+
+void BackendRequirements::checkAll()
+{
+    for (auto it = m_results.begin(); it != m_results.end(); ++it)
+        it->current = false;
+
+    QStringList pluginIds;
+    for (const auto& plugin : Backend::availableBackendsMetaData())
+        pluginIds << plugin.pluginId();
+    check(pluginIds);
+}
+
+void BackendRequirements::checkOutdated()
+{
+    QStringList pluginIds;
+    for (const auto& plugin : Backend::availableBackendsMetaData())
+    {
+        const auto it = m_results.constFind(plugin.pluginId());
+        if (it == m_results.constEnd() || (!it->current && (!it->fulfilled || it->pluginModified != QFileInfo(plugin.fileName()).lastModified())))
+            pluginIds << plugin.pluginId();
+    }
+
+    // the results of the plugins which aren't installed anymore are dropped when storing
+    for (auto it = m_results.begin(); it != m_results.end();)
+    {
+        if (pluginModified(it.key()).isNull())
+            it = m_results.erase(it);
+        else
+            ++it;
+    }
+
+    check(pluginIds);
+}
+
+void BackendRequirements::check(const QStringList& pluginIds)
+{
+    m_pending = pluginIds;
+
+    if (!m_checking)
+    {
+        m_checking = true;
+        QTimer::singleShot(0, this, &BackendRequirements::checkNext);
+    }
+}
+
+bool BackendRequirements::isChecking() const
+{
+    return m_checking;
+}
+
+/*!
+ * loads the plugin of the next pending backend and checks its requirements in the thread pool.
+ * The plugins are loaded one per event loop iteration, so the GUI stays responsive.
+ */
+void BackendRequirements::checkNext()
+{
+    if (m_pending.isEmpty())
+    {
+        KConfigGroup group(KSharedConfig::openConfig(), configGroup);
+        group.deleteGroup();
+        for (auto it = m_results.constBegin(); it != m_results.constEnd(); ++it)
+        {
+            group.writeEntry(it.key(), it->fulfilled);
+            if (!it->reason.isEmpty())
+                group.writeEntry(it.key() + reasonKey, it->reason);
+            if (it->pluginModified.isValid())
+                group.writeEntry(it.key() + pluginKey, it->pluginModified);
+        }
+        group.sync();
+
+        m_checking = false;
+        emit checked();
+        return;
+    }
+
+    const QString pluginId = m_pending.takeFirst();
+    const Backend* backend = Backend::getBackend(pluginId);
+    if (!backend)
+    {
+        m_results.remove(pluginId);
+        QTimer::singleShot(0, this, &BackendRequirements::checkNext);
+        return;
+    }
+
+    // the settings of the backend are read here in the GUI thread, the task only gets the path
+    QString name;
+    QString path;
+    const bool described = backend->requiredExecutable(&name, &path);
+    if (!described || name.isEmpty())
+    {
+        // no executable is needed or the backend doesn't describe its requirements by it
+        QString reason;
+        const bool fulfilled = described || backend->requirementsFullfilled(&reason);
+        store(pluginId, fulfilled, reason);
+        QTimer::singleShot(0, this, &BackendRequirements::checkNext);
+        return;
+    }
+
+    auto* task = new BackendRequirementsTask(name, path);
+    task->setAutoDelete(false);
+    connect(task, &BackendRequirementsTask::finished, this, [this, pluginId](bool fulfilled, const QString& reason) {
+        store(pluginId, fulfilled, reason);
+        checkNext();
+    });
+    QThreadPool::globalInstance()->start(task);
+}
+
+void BackendRequirements::store(const QString& pluginId, bool fulfilled, const QString& reason)
+{
+    Result& result = m_results[pluginId];
+    result.fulfilled = fulfilled;
+    result.reason = fulfilled ? QString() : reason;
+    result.current = true;
+    result.pluginModified = pluginModified(pluginId);
+}
@@ -0,0 +1,116 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#ifndef _BACKENDREQUIREMENTS_H
+#define _BACKENDREQUIREMENTS_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QHash>
+#include <QRunnable>
+#include <QStringList>
+
+#include "cantor_export.h"
+
+namespace Cantor
+{
+class Backend;
+
+/**
+ * Cache for the results of Backend::requirementsFullfilled().
+ *
+ * The checks need the plugins of the backends, loading all of them is too slow for the
+ * startup of the application. The installed backends are therefore listed with the results
+ * of the previous run, stored in the configuration. At the start checkOutdated() checks
+ * only the backends without a result, with missing requirements or with a plugin changed
+ * since their check, checkAll() checks all of them after a change of the settings.
+ * The plugins are loaded one by one in the GUI thread, where the executable required by
+ * the backend is read from its settings, and the executable is checked in the thread pool.
+ * checked() is emitted afterwards. The available backends not checked again are checked
+ * synchronously when they are used the first time, see isFulfilled().
+ *
+ * Backends without any result, e.g. at the first start, are assumed to be available.
+ */
+class CANTOR_EXPORT BackendRequirements : public QObject
+{
+  Q_OBJECT
+  public:
+    enum State {
+      Unknown,
+      Fulfilled,
+      Missing
+    };
+
+    static BackendRequirements* instance();
+
+    /**
+     * The last known state of the backend with the plugin id @p pluginId
+     */
+    State state(const QString& pluginId) const;
+    QString reason(const QString& pluginId) const;
+
+    /**
+     * Returns whether the requirements of @p backend are fulfilled. The result of the last check
+     * in the running application is used, the requirements are checked synchronously otherwise.
+     */
+    bool isFulfilled(const Backend* backend, QString* const reason = nullptr);
+
+    /**
+     * Checks the requirements of all installed backends again in the background
+     */
+    void checkAll();
+
+    /**
+     * Checks the requirements of the backends without a current result, with missing requirements
+     * or with a plugin changed since the last check in the background
+     */
+    void checkOutdated();
+    bool isChecking() const;
+
+  Q_SIGNALS:
+    void checked();
+
+  private:
+    struct Result
+    {
+      bool fulfilled{false};
+      QString reason;
+      bool current{false}; // checked in the running application
+      QDateTime pluginModified; // of the plugin file at the time of the check
+    };
+
+    explicit BackendRequirements(QObject* parent = nullptr);
+
+    void check(const QStringList& pluginIds);
+    void checkNext();
+    void store(const QString& pluginId, bool fulfilled, const QString& reason);
+
+  private:
+    QHash<QString, Result> m_results;
+    QStringList m_pending;
+    bool m_checking{false};
+};
+
+/**
+ * Checks the executable described by Backend::requiredExecutable() in the thread pool
+ */
+class BackendRequirementsTask : public QObject, public QRunnable
+{
+  Q_OBJECT
+  public:
+    BackendRequirementsTask(const QString& name, const QString& path);
+    void run() override;
+
+  Q_SIGNALS:
+    void finished(bool fulfilled, const QString& reason);
+
+  private:
+    const QString m_name;
+    const QString m_path;
+};
+
+}
+
+#endif /* _BACKENDREQUIREMENTS_H */
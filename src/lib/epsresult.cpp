@@ -9,6 +9,8 @@ using namespace Cantor;
 #include <config-cantorlib.h>
 
 #include <QDebug>
+#include <QDateTime>
+#include <QFileInfo>
 #include <QJsonValue>
 
 #include <KZip>
@@ -23,8 +25,32 @@ class Cantor::EpsResultPrivate{
     public:
         QUrl url;
         QImage image;
+        QUrl pageUrl;
+
+        QUrl ownUrl();
 };
 
+// Several typeset results share one pdf file, one page per result. For saving, the page of
+// the result is written into its own file next to the shared one, so that the worksheet
+// doesn't contain the whole file once per result. The shared file is used if that fails.
+QUrl EpsResultPrivate::ownUrl()
+{
+    if (!url.hasFragment() || Renderer::methodForUrl(url) != Renderer::PDF)
+        return url;
+
+    const QFileInfo info(url.toLocalFile());
+    if (!pageUrl.isEmpty() && pageUrl != url && QFileInfo(pageUrl.toLocalFile()).lastModified() >= info.lastModified())
+        return pageUrl;
+
+    QString page = url.fragment();
+    page.remove(QLatin1String("page="));
+    const QString& fileName = info.absolutePath() + QLatin1Char('/') + info.completeBaseName()
+        + QLatin1String("-page") + page + QLatin1String(".pdf");
+
+    pageUrl = Renderer::extractPdfPage(url, fileName) ? QUrl::fromLocalFile(fileName) : url;
+    return pageUrl;
+}
+
 
 EpsResult::EpsResult(const QUrl& url, const QImage& image) : d(new EpsResultPrivate)
 {
@@ -69,6 +95,9 @@ int EpsResult::type()
 
 QString EpsResult::mimeType()
 {
+    if (Renderer::methodForUrl(d->url) == Renderer::PDF)
+        return QStringLiteral("application/pdf");
+
     return QStringLiteral("image/x-eps");
 }
 
@@ -77,10 +106,14 @@ QDomElement EpsResult::toXml(QDomDocument& doc)
     qDebug()<<"saving imageresult "<<toHtml();
     QDomElement e=doc.createElement(QStringLiteral("Result"));
     e.setAttribute(QStringLiteral("type"), QStringLiteral("epsimage"));
-    e.setAttribute(QStringLiteral("filename"), d->url.fileName());
+    // the same file is added to the archive by saveAdditionalData()
+    const QUrl& url = d->ownUrl();
+    e.setAttribute(QStringLiteral("filename"), url.fileName());
+    if (url.hasFragment())
+        e.setAttribute(QStringLiteral("fragment"), url.fragment());
 
 #ifdef WITH_EPS
-    const QImage& image = Renderer::epsRenderToImage(d->url, 1.0, false);
+    const QImage& image = Renderer::fileRenderToImage(d->url, 1.0, false);
     qDebug() << image.size() << image.isNull();
     if (!image.isNull())
     {
@@ -117,7 +150,7 @@ QJsonValue Cantor::EpsResult::toJupyterJson()
     else
         root.insert(QLatin1String("output_type"), QLatin1String("display_data"));
 
-    const QImage& image = d->image.isNull() ? Renderer::epsRenderToImage(d->url, 1.0, false) : d->image;
+    const QImage& image = d->image.isNull() ? Renderer::fileRenderToImage(d->url, 1.0, false) : d->image;
 
     QJsonObject data;
     data = JupyterUtils::packMimeBundle(image, JupyterUtils::pngMime);
@@ -130,11 +163,16 @@ QJsonValue Cantor::EpsResult::toJupyterJson()
 
 void EpsResult::saveAdditionalData(KZip* archive)
 {
-    archive->addLocalFile(d->url.toLocalFile(), d->url.fileName());
+    const QUrl& url = d->ownUrl();
+    // the shared file could be already added for another result, if its page couldn't be extracted
+    if (!archive->directory()->entry(url.fileName()))
+        archive->addLocalFile(url.toLocalFile(), url.fileName());
 }
 
 void EpsResult::save(const QString& filename)
 {
-    //just copy over the eps file..
-    KIO::file_copy(d->url, QUrl::fromLocalFile(filename), -1, KIO::HideProgressInfo);
+    //just copy over the eps file or the page of the pdf file..
+    QUrl url = d->ownUrl();
+    url.setFragment(QString());
+    KIO::file_copy(url, QUrl::fromLocalFile(filename), -1, KIO::HideProgressInfo);
 }
@@ -13,21 +13,32 @@ using namespace Cantor;
 #include "result.h"
 #include "textresult.h"
 #include "imageresult.h"
+#include "plotresult.h"
 #include "latexresult.h"
+#include "typesettingqueue.h"
 #include "settings.h"
 
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QString>
+#include <QUrl>
 #include <QFileSystemWatcher>
 
 #include <KProcess>
 #include <KZip>
 
+#include <array>
+
 class Cantor::ExpressionPrivate
 {
 public:
-    ExpressionPrivate() : id(-1) {}
+    ExpressionPrivate() : id(-1)
+    {
+        times.fill(-1);
+    }
 
     int id{-1};
     QString command;
@@ -40,8 +51,20 @@ public:
     bool internal{false};
     bool helpRequest{false};
     QFileSystemWatcher* fileWatcher{nullptr};
+    std::array<qint64, Expression::RenderedTime + 1> times;
 };
 
+// monotonic clock shared by all expressions, so that their timestamps can be compared
+static qint64 currentTime()
+{
+    static const QElapsedTimer clock = [] {
+        QElapsedTimer timer;
+        timer.start();
+        return timer;
+    }();
+    return clock.nsecsElapsed();
+}
+
 static const QString tex=QLatin1String("\\documentclass[12pt,fleqn]{article}          \n "\
                          "\\usepackage{latexsym,amsfonts,amssymb,ulem}  \n "\
                          "\\usepackage[dvips]{graphicx}                 \n "\
@@ -59,6 +82,7 @@ Expression::Expression( Session* session, bool internal ) : QObject( session ),
 {
     d->session=session;
     d->internal = internal;
+    markTime(CreatedTime);
     if (!internal && session)
         d->id=session->nextExpressionId();
     else
@@ -70,6 +94,7 @@ Expression::Expression( Session* session, bool internal, int id ) : QObject( ses
     d->session = session;
     d->internal = internal;
     d->id = id;
+    markTime(CreatedTime);
 }
 
 Expression::~Expression()
@@ -192,9 +217,15 @@ const QVector<Result*>& Expression::results() const
 void Expression::setStatus(Expression::Status status)
 {
     d->status=status;
-    emit statusChanged(status);
 
     bool isFinished = status == Expression::Done || status == Expression::Error || status == Expression::Interrupted;
+    if (status == Expression::Computing)
+        markTime(SentTime);
+    else if (isFinished)
+        markTime(FinishedTime);
+
+    emit statusChanged(status);
+
     if (isFinished)
     {
         emit expressionFinished(status);
@@ -221,7 +252,8 @@ void Expression::renderResultAsLatex(Result* result)
     connect(renderer, &LatexRenderer::done, [=] { latexRendered(renderer, result); });
     connect(renderer, &LatexRenderer::error, [=] { latexRendered(renderer, result); });
 
-    renderer->render();
+    //results of the whole session are collected and typeset together, see TypesettingQueue
+    session()->typesettingQueue()->enqueue(renderer);
 }
 
 void Expression::latexRendered(LatexRenderer* renderer, Result* result)
@@ -234,13 +266,13 @@ void Expression::latexRendered(LatexRenderer* renderer, Result* result)
         if (result->type() == TextResult::Type)
         {
             TextResult* r = static_cast<TextResult*>(result);
-            LatexResult* latex=new LatexResult(r->data().toString().trimmed(), QUrl::fromLocalFile(renderer->imagePath()), r->plain());
+            LatexResult* latex=new LatexResult(r->data().toString().trimmed(), renderer->imageUrl(), r->plain(), renderer->image());
             addResult( latex );
         }
         else if (result->type() == LatexResult::Type)
         {
             LatexResult* previousLatexResult = static_cast<LatexResult*>(result);
-            LatexResult* latex=new LatexResult(previousLatexResult->data().toString().trimmed(), QUrl::fromLocalFile(renderer->imagePath()), previousLatexResult->plain());
+            LatexResult* latex=new LatexResult(previousLatexResult->data().toString().trimmed(), renderer->imageUrl(), previousLatexResult->plain(), renderer->image());
             addResult( latex );
         }
     }else
@@ -268,6 +300,173 @@ QString Expression::additionalLatexHeaders()
     return QString();
 }
 
+const QString Expression::PlotFileMarker = QStringLiteral("__cantor_plot__:");
+
+QVector<Expression::PlotFile> Expression::takePlotFiles(QString& output)
+{
+    QVector<PlotFile> files;
+    if (!output.contains(PlotFileMarker))
+        return files;
+
+    QStringList lines = output.split(QLatin1Char('\n'));
+    for (auto it = lines.begin(); it != lines.end();)
+    {
+        if (it->startsWith(PlotFileMarker))
+        {
+            // the mime type and the size are optional
+            const QStringList& fields = it->mid(PlotFileMarker.size()).trimmed().split(QLatin1Char('\t'));
+            PlotFile file;
+            file.path = fields.at(0);
+            if (fields.size() > 1)
+                file.mimeType = fields.at(1);
+            if (fields.size() > 2)
+            {
+                bool ok;
+                const qint64 size = fields.at(2).toLongLong(&ok);
+                if (ok)
+                    file.size = size;
+            }
+            if (!file.path.isEmpty())
+                files << file;
+            it = lines.erase(it);
+        }
+        else
+            ++it;
+    }
+    output = lines.join(QLatin1Char('\n'));
+
+    return files;
+}
+
+bool Expression::addPlotResult(const PlotFile& file)
+{
+    const QFileInfo info(file.path);
+    if (!info.exists() || info.size() == 0 || (file.size >= 0 && info.size() != file.size))
+    {
+        qDebug() << "the announced plot file is incomplete:" << file.path;
+        return false;
+    }
+
+    // the file is complete, changes of it don't need to be watched anymore
+    if (d->fileWatcher && d->fileWatcher->files().contains(file.path))
+        d->fileWatcher->removePath(file.path);
+
+    const QUrl& url = QUrl::fromLocalFile(file.path);
+    Result* result;
+    if (file.mimeType == QLatin1String("application/x-cantor-plot") || file.path.endsWith(QLatin1String(".cantorplot")))
+    {
+        // the temporary file of the backend is only needed by the result
+        auto* plot = new PlotResult(url);
+        plot->setOwnsFile(true);
+        result = plot;
+    }
+    else
+        result = new ImageResult(url);
+
+    for (int i = 0; i < d->results.size(); ++i)
+        if (d->results.at(i)->url() == url)
+        {
+            // the file was written again, it's kept for the new result
+            if (d->results.at(i)->type() == PlotResult::Type)
+                static_cast<PlotResult*>(d->results.at(i))->setOwnsFile(false);
+            replaceResult(i, result);
+            return true;
+        }
+
+    addResult(result);
+    return true;
+}
+
+void Expression::markTime(TimingPoint point)
+{
+    if (d->times[point] == -1 || point == RenderedTime)
+        d->times[point] = currentTime();
+}
+
+qint64 Expression::time(TimingPoint point) const
+{
+    return d->times[point];
+}
+
+qint64 Expression::elapsed(TimingPoint from, TimingPoint to) const
+{
+    if (d->times[from] == -1 || d->times[to] == -1)
+        return -1;
+    return d->times[to] - d->times[from];
+}
+
+QJsonArray Expression::traceEvents() const
+{
+    QJsonArray events;
+    const qint64 finished = d->times[FinishedTime];
+    if (finished == -1)
+        return events;
+
+    const qint64 queued = d->times[QueuedTime] != -1 ? d->times[QueuedTime] : d->times[CreatedTime];
+    const qint64 sent = d->times[SentTime] != -1 ? d->times[SentTime] : queued;
+    const qint64 firstOutput = d->times[FirstOutputTime];
+    const qint64 rendered = d->times[RenderedTime];
+
+    // the timestamps of the trace event format are microseconds
+    auto addEvent = [&](const QString& name, qint64 from, qint64 to, const QJsonObject& args = QJsonObject()) {
+        if (from == -1 || to < from)
+            return;
+
+        QJsonObject event;
+        event.insert(QLatin1String("name"), name);
+        event.insert(QLatin1String("cat"), QLatin1String("cantor"));
+        event.insert(QLatin1String("ph"), QLatin1String("X"));
+        event.insert(QLatin1String("ts"), from / 1000.0);
+        event.insert(QLatin1String("dur"), (to - from) / 1000.0);
+        event.insert(QLatin1String("pid"), 1);
+        event.insert(QLatin1String("tid"), d->id);
+        if (!args.isEmpty())
+            event.insert(QLatin1String("args"), args);
+        events.append(event);
+    };
+
+    QJsonObject threadName;
+    threadName.insert(QLatin1String("name"), QLatin1String("thread_name"));
+    threadName.insert(QLatin1String("ph"), QLatin1String("M"));
+    threadName.insert(QLatin1String("pid"), 1);
+    threadName.insert(QLatin1String("tid"), d->id);
+    threadName.insert(QLatin1String("args"), QJsonObject{{QLatin1String("name"), QStringLiteral("Expression %1").arg(d->id)}});
+    events.append(threadName);
+
+    static const QStringList statusNames{QLatin1String("queued"), QLatin1String("computing"), QLatin1String("done"),
+                                         QLatin1String("error"), QLatin1String("interrupted")};
+    QJsonObject args;
+    args.insert(QLatin1String("command"), d->command.left(200));
+    args.insert(QLatin1String("status"), statusNames.at(d->status));
+    addEvent(QLatin1String("expression"), queued, qMax(finished, rendered), args);
+
+    addEvent(QLatin1String("queue"), queued, sent);
+    if (firstOutput != -1 && firstOutput <= finished)
+    {
+        // the interpreter and the communication until the first output, then receiving and parsing the output
+        addEvent(QLatin1String("backend"), sent, firstOutput);
+        addEvent(QLatin1String("output"), firstOutput, finished);
+    }
+    else
+        addEvent(QLatin1String("backend"), sent, finished);
+    addEvent(QLatin1String("rendering"), finished, rendered);
+
+    return events;
+}
+
+QByteArray Expression::chromeTrace(const QVector<Expression*>& expressions)
+{
+    QJsonArray events;
+    for (auto* expression : expressions)
+        for (const auto& event : expression->traceEvents())
+            events.append(event);
+
+    QJsonObject trace;
+    trace.insert(QLatin1String("traceEvents"), events);
+    trace.insert(QLatin1String("displayTimeUnit"), QLatin1String("ms"));
+    return QJsonDocument(trace).toJson(QJsonDocument::Compact);
+}
+
 QFileSystemWatcher* Expression::fileWatcher() {
     if (!d->fileWatcher)
         d->fileWatcher = new QFileSystemWatcher();
@@ -9,6 +9,8 @@
 
 #include <QObject>
 #include <QDomElement>
+#include <QJsonArray>
+#include <QVector>
 
 #include "cantor_export.h"
 
@@ -55,6 +57,19 @@ class CANTOR_EXPORT Expression : public QObject
                           * All output/results will be dropped
                           */
     };
+    /**
+     * The points of the lifecycle of an Expression, which are timestamped to find out
+     * where the time of an evaluation goes
+     */
+    enum TimingPoint {
+        CreatedTime,      ///< The Expression object was created
+        QueuedTime,       ///< The Expression was added to the expression queue of the session
+        SentTime,         ///< The command was sent to the backend
+        FirstOutputTime,  ///< The first output of the backend for the command arrived
+        FinishedTime,     ///< The status changed to Done, Error or Interrupted
+        RenderedTime      ///< The last result was rendered in the worksheet
+    };
+
     /**
      * Expression constructor. Should only be called from Session::evaluateExpression
      * @param session the session, this Expression belongs to
@@ -211,6 +226,57 @@ class CANTOR_EXPORT Expression : public QObject
     void setIsHelpRequest(bool);
     bool isHelpRequest() const;
 
+    /**
+     * Records the current time for @p point. Only the first time is kept,
+     * except for RenderedTime, which is updated for every result rendered.
+     * CreatedTime, QueuedTime, SentTime and FinishedTime are recorded by Expression and Session,
+     * the backends record FirstOutputTime and the frontend RenderedTime.
+     */
+    void markTime(TimingPoint point);
+
+    /**
+     * Returns the time of @p point in nanoseconds on a monotonic clock
+     * common to all expressions, or -1 if the point wasn't reached yet.
+     */
+    qint64 time(TimingPoint point) const;
+
+    /**
+     * Returns the nanoseconds between @p from and @p to, or -1 if one of them wasn't reached yet
+     */
+    qint64 elapsed(TimingPoint from, TimingPoint to) const;
+
+    /**
+     * Returns the lifecycle of this Expression as events of the Chrome trace event format,
+     * a complete event for the whole evaluation containing the events for the time spent
+     * in the queue, in the backend until the first output, while receiving and parsing
+     * the output and while rendering the results. The thread id of the events is the id of the Expression.
+     */
+    QJsonArray traceEvents() const;
+
+    /**
+     * Returns a Chrome trace event JSON document with the events of @p expressions,
+     * which can be opened in chrome://tracing or Perfetto
+     */
+    static QByteArray chromeTrace(const QVector<Expression*>& expressions);
+
+    /**
+     * A plot file written by the backend. The backends announce their plot files in the output,
+     * after the file was written completely and closed, with a line consisting of PlotFileMarker,
+     * the path, the mime type and the size of the file in bytes, separated by tabs.
+     */
+    struct PlotFile
+    {
+        QString path;
+        QString mimeType;
+        qint64 size{-1};
+    };
+    static const QString PlotFileMarker;
+
+    /**
+     * Removes the plot file announcements from @p output and returns the announced files
+     */
+    static QVector<PlotFile> takePlotFiles(QString& output);
+
   Q_SIGNALS:
     /**
      * the Id of this Expression changed
@@ -275,6 +341,13 @@ class CANTOR_EXPORT Expression : public QObject
 
     QFileSystemWatcher* fileWatcher();
 
+    /**
+     * Adds the result for the announced plot @p file, a result already shown for this file
+     * is replaced. The file is not watched with fileWatcher() anymore.
+     * Returns false if the file doesn't exist or doesn't have the announced size.
+     */
+    bool addPlotResult(const PlotFile& file);
+
   private:
     void renderResultAsLatex(Result*);
     void latexRendered(LatexRenderer*, Result*);
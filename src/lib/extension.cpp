@@ -45,6 +45,22 @@ QString ScriptExtension::commentEndingSequence()
     return QLatin1String("");
 }
 
+QString VariableManagementExtension::saveSessionState(const QString& fileName)
+{
+    return saveVariables(fileName);
+}
+
+QString VariableManagementExtension::restoreSessionState(const QString& fileName)
+{
+    return loadVariables(fileName);
+}
+
+QString PlotExtension::plotData2d(const QString& x, const QString& y)
+{
+    Q_UNUSED(x)
+    Q_UNUSED(y)
+    return QString();
+}
 
 //some convenience functions, but normally backends have a special command to create
 //these matrices/vectors.
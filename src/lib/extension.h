@@ -211,6 +211,14 @@ class CANTOR_EXPORT PlotExtension : public Extension
      * @return the command for plotting
      */
     virtual QString plotFunction3d(const QString& function, const VariableParameter& var1, const VariableParameter& var2) = 0;
+    /**
+     * returns the command for plotting numeric data natively in Cantor, @see Cantor::PlotResult.
+     * The data is not rendered by the backend, so large data sets can be zoomed and panned interactively.
+     * @param x the x values
+     * @param y the y values
+     * @return the command for plotting or an empty string if the backend doesn't support it
+     */
+    virtual QString plotData2d(const QString& x, const QString& y);
 };
 
 #define PLOT_DIRECTIVE_DISPATCHING(x) QString dispatch(const Cantor::AdvancedPlotExtension::AcceptorBase& acc) const \
@@ -453,6 +461,21 @@ class CANTOR_EXPORT VariableManagementExtension : public Extension
     virtual QString saveVariables(const QString& fileName) = 0;
     virtual QString loadVariables(const QString& fileName) = 0;
     virtual QString clearVariables() = 0;
+
+    /**
+     * Saves the state of the session in the binary snapshot @p fileName, which is stored next to the worksheet.
+     * The default implementation uses saveVariables().
+     * @return the command or a null string, if the backend can't save its state
+     */
+    virtual QString saveSessionState(const QString& fileName);
+    /**
+     * Restores the state saved by saveSessionState(). Backends supporting it restore the variables lazily,
+     * they are read from the snapshot on their first use. The default implementation uses loadVariables().
+     * The snapshot may contain code which is run when restoring it, e.g. the pickles of Python,
+     * so only the snapshots of trusted worksheets are to be restored.
+     * @return the command or a null string, if the backend can't restore its state
+     */
+    virtual QString restoreSessionState(const QString& fileName);
 };
 
 /**
@@ -55,6 +55,11 @@ Expression* Cantor::GraphicPackage::isAvailable(Session* session) const
     return session->evaluateExpression(d->testPresenceCommand, Expression::FinishingBehavior::DoNotDelete, true);
 }
 
+QString Cantor::GraphicPackage::testPresenceCommand() const
+{
+    return d->testPresenceCommand;
+}
+
 QString Cantor::GraphicPackage::enableSupportCommand(QString additionalInfo) const
 {
     return d->enableSupportCommand.arg(additionalInfo);
@@ -46,6 +46,9 @@ public:
      */
     Expression* isAvailable(Session*) const;
 
+    /// The backend code evaluated by isAvailable(), see Session::testGraphicsPackages()
+    QString testPresenceCommand() const;
+
     /**
      * @brief This command should return code, which will enable capturing images.
      *
@@ -0,0 +1,267 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#include "imagecache.h"
+#include "imageresult.h"
+using namespace Cantor;
+
+#include <QDebug>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QThreadPool>
+#include <QtMath>
+
+#include <cmath>
+
+// memory budget of the decoded images in KiB
+static const int DefaultMaxCost = 256 * 1024;
+
+ImageCache::ImageCache(QObject* parent) : QObject(parent)
+{
+    m_cache.setMaxCost(DefaultMaxCost);
+}
+
+ImageCache* ImageCache::instance()
+{
+    static ImageCache cache;
+    return &cache;
+}
+
+QSize ImageCache::imageSize(const QString& path)
+{
+    const QDateTime& modified = QFileInfo(path).lastModified();
+    auto it = m_files.constFind(path);
+    if (it != m_files.constEnd() && it->modified == modified)
+        return it->size;
+
+    // the image was changed on the disk, the decoded levels are outdated
+    if (it != m_files.constEnd())
+    {
+        for (int i = minLevel(path); i <= maxLevel(path); ++i)
+            m_cache.remove(key(path, i));
+        if (m_oversizedKey.startsWith(path + QLatin1Char('|')))
+        {
+            m_oversizedKey.clear();
+            m_oversized = QImage();
+        }
+    }
+
+    FileInfo info;
+    info.modified = modified;
+    if (ImageResult::isVectorImage(path))
+        info.size = ImageResult::vectorImageSize(path);
+    else
+        info.size = QImageReader(path).size();
+    m_files.insert(path, info);
+    return info.size;
+}
+
+QImage ImageCache::image(const QString& path, const QSize& size)
+{
+    const QSize& original = imageSize(path);
+    if (!original.isValid())
+        return QImage();
+
+    const int requestedLevel = level(path, original, size);
+    const QString& requestedKey = key(path, requestedLevel);
+    if (QImage* cached = m_cache.object(requestedKey))
+        return *cached;
+    if (requestedKey == m_oversizedKey)
+        return m_oversized;
+
+    if (!m_pending.contains(requestedKey) && !m_failed.contains(requestedKey))
+    {
+        m_pending.insert(requestedKey);
+
+        auto* task = new ImageDecodeTask(path, requestedKey, levelSize(path, original, requestedLevel));
+        task->setAutoDelete(false);
+        connect(task, &ImageDecodeTask::finish, this, &ImageCache::decoded);
+        QThreadPool::globalInstance()->start(task);
+    }
+
+    // show another level until the requested one is decoded, the sharper ones first
+    for (int i = requestedLevel - 1; i >= minLevel(path); --i)
+        if (QImage* cached = m_cache.object(key(path, i)))
+            return *cached;
+    for (int i = requestedLevel + 1; i <= maxLevel(path); ++i)
+        if (QImage* cached = m_cache.object(key(path, i)))
+            return *cached;
+
+    return QImage();
+}
+
+QImage ImageCache::decodedImage(const QString& path, const QSize& size)
+{
+    const QSize& original = imageSize(path);
+    if (ImageResult::isVectorImage(path))
+        return ImageResult::renderVectorImage(path, size.isValid() ? size : original);
+
+    QImageReader reader(path);
+    if (original.isValid() && size.isValid() && size.width() < original.width() && size.height() < original.height())
+        reader.setScaledSize(size);
+    return reader.read();
+}
+
+QImage ImageCache::cachedImage(const QString& path, const QSize& size)
+{
+    const QSize& original = imageSize(path);
+    if (!original.isValid())
+        return QImage(path);
+
+    const int requestedLevel = level(path, original, size);
+    const QString& requestedKey = key(path, requestedLevel);
+    if (QImage* cached = m_cache.object(requestedKey))
+        return *cached;
+    if (requestedKey == m_oversizedKey)
+        return m_oversized;
+
+    const QImage& image = ImageDecodeTask::decode(path, levelSize(path, original, requestedLevel));
+    if (!image.isNull())
+        insert(requestedKey, image);
+    return image;
+}
+
+void ImageCache::setMaxCost(int kib)
+{
+    m_cache.setMaxCost(kib);
+}
+
+int ImageCache::maxCost() const
+{
+    return m_cache.maxCost();
+}
+
+void ImageCache::clear()
+{
+    m_cache.clear();
+    m_files.clear();
+    m_failed.clear();
+    m_oversizedKey.clear();
+    m_oversized = QImage();
+}
+
+/*!
+ * returns the smallest level which is still at least as large as @p size.
+ * For raster images level n has 1/2^n of the width and the height of the original image.
+ * Vector images are rasterized in any size, their levels are zoom buckets of a quarter
+ * of a zoom octave, level -n has 2^(n/4) times the size of the original image.
+ * For both the smaller levels are the sharper ones.
+ */
+int ImageCache::level(const QString& path, const QSize& imageSize, const QSize& size) const
+{
+    if (!size.isValid())
+        return 0;
+
+    if (ImageResult::isVectorImage(path))
+    {
+        const qreal scale = qMax(qreal(size.width()) / imageSize.width(), qreal(size.height()) / imageSize.height());
+        const int level = -qCeil(std::log2(scale) * VectorBucketsPerOctave - 0.001);
+        return qBound(minLevel(path), level, maxLevel(path));
+    }
+
+    int level = 0;
+    while (level < maxLevel(path))
+    {
+        const QSize& next = levelSize(path, imageSize, level + 1);
+        if (next.width() < size.width() || next.height() < size.height())
+            break;
+        ++level;
+    }
+    return level;
+}
+
+QSize ImageCache::levelSize(const QString& path, const QSize& imageSize, int level) const
+{
+    if (ImageResult::isVectorImage(path))
+    {
+        const qreal scale = std::exp2(qreal(-level) / VectorBucketsPerOctave);
+        return QSize(qMax(1, qCeil(imageSize.width() * scale)), qMax(1, qCeil(imageSize.height() * scale)));
+    }
+
+    return QSize(qMax(1, imageSize.width() >> level), qMax(1, imageSize.height() >> level));
+}
+
+int ImageCache::minLevel(const QString& path) const
+{
+    // vector images are rasterized up to 4 times of their original size, more is not worth the memory
+    return ImageResult::isVectorImage(path) ? -2 * VectorBucketsPerOctave : 0;
+}
+
+int ImageCache::maxLevel(const QString& path) const
+{
+    return ImageResult::isVectorImage(path) ? 2 * VectorBucketsPerOctave : MaxLevel - 1;
+}
+
+QString ImageCache::key(const QString& path, int level) const
+{
+    const auto it = m_files.constFind(path);
+    const qint64 modified = it != m_files.constEnd() ? it->modified.toMSecsSinceEpoch() : 0;
+    return path + QLatin1Char('|') + QString::number(modified) + QLatin1Char('|') + QString::number(level);
+}
+
+void ImageCache::decoded(const QString& path, const QString& key, const QImage& image)
+{
+    m_pending.remove(key);
+
+    if (image.isNull())
+    {
+        // don't try to decode the broken image again and again on every repaint
+        qDebug() << "failed to decode the image" << path;
+        m_failed.insert(key);
+        return;
+    }
+
+    insert(key, image);
+    emit imageReady(path);
+}
+
+void ImageCache::insert(const QString& key, const QImage& image)
+{
+    const int cost = qMax(1, static_cast<int>(static_cast<qint64>(image.bytesPerLine()) * image.height() / 1024));
+
+    // QCache refuses objects exceeding the budget, keep the last of them separately
+    // instead of decoding it again on every repaint
+    if (cost > m_cache.maxCost())
+    {
+        m_oversizedKey = key;
+        m_oversized = image;
+        return;
+    }
+
+    m_cache.insert(key, new QImage(image), cost);
+}
+
+ImageDecodeTask::ImageDecodeTask(const QString& path, const QString& key, const QSize& size)
+    : m_path(path), m_key(key), m_size(size)
+{
+}
+
+void ImageDecodeTask::run()
+{
+    emit finish(m_path, m_key, decode(m_path, m_size));
+    deleteLater();
+}
+
+QImage ImageDecodeTask::decode(const QString& path, const QSize& size)
+{
+    if (ImageResult::isVectorImage(path))
+    {
+        const QImage& image = ImageResult::renderVectorImage(path, size);
+        if (image.isNull())
+            qDebug() << "Rasterizing vector image failed: " << path;
+
+        return image;
+    }
+
+    QImageReader reader(path);
+    if (size.isValid() && size != reader.size())
+        reader.setScaledSize(size);
+
+    const QImage& image = reader.read();
+    if (image.isNull())
+        qDebug() << "Decoding image failed with message: " << reader.errorString();
+
+    return image;
+}
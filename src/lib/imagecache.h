@@ -0,0 +1,130 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#ifndef IMAGECACHE_H
+#define IMAGECACHE_H
+
+#include <QCache>
+#include <QDateTime>
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QRunnable>
+#include <QSet>
+
+#include "cantor_export.h"
+
+namespace Cantor
+{
+
+/**
+ * Cache for the raster images shown in the worksheet.
+ *
+ * The images are decoded in the thread pool in the resolution they are displayed in
+ * instead of their full resolution. The decoded images are kept as mip levels,
+ * level n having 1/2^n of the original width and height, so zooming in and out
+ * can reuse the decoded levels. The least recently used levels are evicted
+ * when the memory budget is exceeded.
+ *
+ * Vector images (PDF and SVG) are rasterized in the thread pool too, in the
+ * displayed size rounded up to the next zoom bucket, so they stay sharp on every zoom level.
+ *
+ * The worksheets and the image results share the instance().
+ */
+class CANTOR_EXPORT ImageCache : public QObject
+{
+  Q_OBJECT
+  public:
+    explicit ImageCache(QObject* parent = nullptr);
+    ~ImageCache() override = default;
+
+    static ImageCache* instance();
+
+    /**
+     * Size of the image in @p path, only the header of the file is read
+     */
+    QSize imageSize(const QString& path);
+
+    /**
+     * Returns the image in @p path decoded for the display in @p size pixels.
+     * If the matching level is not cached yet, its decoding is scheduled and
+     * imageReady() is emitted when it is available. Meanwhile another cached
+     * level of the image is returned, if any.
+     */
+    QImage image(const QString& path, const QSize& size);
+
+    /**
+     * Decodes the image in @p path for the display in @p size pixels right now, used for printing
+     */
+    QImage decodedImage(const QString& path, const QSize& size);
+
+    /**
+     * Returns the image in @p path decoded for the display in @p size pixels, the matching level
+     * is decoded right now if it is not cached yet. An invalid @p size requests the original size.
+     */
+    QImage cachedImage(const QString& path, const QSize& size);
+
+    /**
+     * Memory budget in KiB
+     */
+    void setMaxCost(int kib);
+    int maxCost() const;
+
+    void clear();
+
+  Q_SIGNALS:
+    void imageReady(const QString& path);
+
+  private:
+    struct FileInfo
+    {
+        QDateTime modified;
+        QSize size;
+    };
+
+    int level(const QString& path, const QSize& imageSize, const QSize& size) const;
+    QSize levelSize(const QString& path, const QSize& imageSize, int level) const;
+    int minLevel(const QString& path) const;
+    int maxLevel(const QString& path) const;
+    QString key(const QString& path, int level) const;
+    void decoded(const QString& path, const QString& key, const QImage& image);
+    void insert(const QString& key, const QImage& image);
+
+    static const int MaxLevel = 5;
+    static const int VectorBucketsPerOctave = 4;
+
+    QCache<QString, QImage> m_cache;
+    QHash<QString, FileInfo> m_files;
+    QSet<QString> m_pending;
+    QSet<QString> m_failed;
+    QString m_oversizedKey;
+    QImage m_oversized;
+};
+
+/**
+ * Decodes an image to the requested size in the thread pool
+ */
+class ImageDecodeTask : public QObject, public QRunnable
+{
+  Q_OBJECT
+  public:
+    ImageDecodeTask(const QString& path, const QString& key, const QSize& size);
+
+    void run() override;
+
+    static QImage decode(const QString& path, const QSize& size);
+
+  Q_SIGNALS:
+    void finish(const QString& path, const QString& key, const QImage& image);
+
+  private:
+    QString m_path;
+    QString m_key;
+    QSize m_size;
+};
+
+}
+
+#endif /* IMAGECACHE_H */
@@ -5,7 +5,9 @@
 */
 
 #include "imageresult.h"
+#include "imagecache.h"
 #include "jupyterutils.h"
+#include "renderer.h"
 using namespace Cantor;
 
 #include <QApplication>
@@ -20,8 +22,6 @@ using namespace Cantor;
 
 #include <KZip>
 
-#include <poppler-qt5.h>
-
 class Cantor::ImageResultPrivate
 {
   public:
@@ -36,6 +36,16 @@ class Cantor::ImageResultPrivate
 
     QString originalFormat{JupyterUtils::pngMime};
     QString svgContent; // HACK: qt can't easily render svg, so, if we load the result from Jupyter svg image, store original svg
+
+    // the images from files are only decoded or rasterized when requested, in the image cache
+    // shared with the worksheet, which decodes them in the displayed size
+    QImage image() const
+    {
+        if (!img.isNull() || !url.isLocalFile())
+            return img;
+
+        return ImageCache::instance()->cachedImage(url.toLocalFile(), QSize());
+    }
 };
 
 ImageResult::ImageResult(const QUrl &url, const QString& alt) :  d(new ImageResultPrivate)
@@ -44,63 +54,13 @@ ImageResult::ImageResult(const QUrl &url, const QString& alt) :  d(new ImageResu
     d->alt = alt;
     d->extension = url.toLocalFile().right(3).toLower();
 
-    if (d->extension == QLatin1String("pdf") || d->extension == QLatin1String("svg")) // vector formats
+    if (isVectorImage(url.toLocalFile()))
     {
+        // vector images are rasterized when needed, in the size they are displayed in
         QFile file(url.toLocalFile());
-        if (!file.open(QIODevice::ReadOnly))
-            return;
-
-        d->data = file.readAll();
-        if (d->data.isEmpty())
-            return;
-
-        if (d->extension == QLatin1String("pdf"))
-        {
-            auto* document = Poppler::Document::loadFromData(d->data);
-            if (!document) {
-                qDebug()<< "Failed to process the byte array of the PDF file " << url.toLocalFile();
-                delete document;
-                return;
-            }
-
-            auto* page = document->page(0);
-            if (!page) {
-                qDebug() << "Failed to process the first page in the PDF file.";
-                delete document;
-                return;
-            }
-
-            document->setRenderHint(Poppler::Document::TextAntialiasing);
-            document->setRenderHint(Poppler::Document::Antialiasing);
-            document->setRenderHint(Poppler::Document::TextHinting);
-            document->setRenderHint(Poppler::Document::TextSlightHinting);
-            document->setRenderHint(Poppler::Document::ThinLineSolid);
-
-            const static int dpi = QApplication::desktop()->logicalDpiX();
-            d->img = page->renderToImage(dpi, dpi);
-
-            delete page;
-            delete document;
-        }
-        else
-        {
-            QSvgRenderer renderer(d->data);
-
-            // SVG document size is in points, convert to pixels
-            const auto& size = renderer.defaultSize();
-            int w = size.width() / 72 * QApplication::desktop()->physicalDpiX();
-            int h = size.height() / 72 * QApplication::desktop()->physicalDpiX();
-            d->img = QImage(w, h, QImage::Format_ARGB32);
-
-            // render
-            QPainter painter;
-            painter.begin(&d->img);
-            renderer.render(&painter);
-            painter.end();
-        }
+        if (file.open(QIODevice::ReadOnly))
+            d->data = file.readAll();
     }
-    else // raster formats
-        d->img.load(d->url.toLocalFile());
 }
 
 Cantor::ImageResult::ImageResult(const QImage& image, const QString& alt) :  d(new ImageResultPrivate)
@@ -112,8 +72,12 @@ Cantor::ImageResult::ImageResult(const QImage& image, const QString& alt) :  d(n
     imageFile.setAutoRemove(false);
     if (imageFile.open())
     {
-        d->img.save(imageFile.fileName(), "PNG");
-        d->url = QUrl::fromLocalFile(imageFile.fileName());
+        if (d->img.save(imageFile.fileName(), "PNG"))
+        {
+            // the image can be loaded again from the file when needed
+            d->url = QUrl::fromLocalFile(imageFile.fileName());
+            d->img = QImage();
+        }
     }
 }
 
@@ -134,7 +98,7 @@ QString ImageResult::toLatex()
 
 QVariant ImageResult::data()
 {
-    return QVariant(d->img);
+    return QVariant(d->image());
 }
 
 QUrl ImageResult::url()
@@ -185,11 +149,7 @@ QJsonValue Cantor::ImageResult::toJupyterJson()
     else
         root.insert(QLatin1String("output_type"), QLatin1String("display_data"));
 
-    QImage image;
-    if (d->img.isNull())
-        image.load(d->url.toLocalFile());
-    else
-        image = d->img;
+    const QImage image = d->image();
 
     QJsonObject data;
 
@@ -197,7 +157,7 @@ QJsonValue Cantor::ImageResult::toJupyterJson()
     if (d->originalFormat == JupyterUtils::svgMime)
         data.insert(JupyterUtils::svgMime, JupyterUtils::toJupyterMultiline(d->svgContent));
     else
-        data = JupyterUtils::packMimeBundle(d->img, d->originalFormat);
+        data = JupyterUtils::packMimeBundle(image, d->originalFormat);
 
     data.insert(JupyterUtils::textMime, JupyterUtils::toJupyterMultiline(d->alt));
 
@@ -225,7 +185,7 @@ void ImageResult::saveAdditionalData(KZip* archive)
 void ImageResult::save(const QString& fileName)
 {
     bool rc = false;
-    if (d->extension == QLatin1String("pdf") || d->extension == QLatin1String("svg"))
+    if (isVectorImage(d->url.toLocalFile()))
     {
         QFile file(fileName);
         if (file.open(QIODevice::WriteOnly))
@@ -236,7 +196,7 @@ void ImageResult::save(const QString& fileName)
         }
     }
     else
-        rc = d->img.save(fileName);
+        rc = d->image().save(fileName);
 
     if (!rc)
         qDebug()<<"saving to " << fileName << " failed.";
@@ -266,3 +226,57 @@ void Cantor::ImageResult::setSvgContent(const QString& svgContent)
 {
     d->svgContent = svgContent;
 }
+
+bool Cantor::ImageResult::isVectorImage(const QString& path)
+{
+    return path.endsWith(QLatin1String(".pdf"), Qt::CaseInsensitive) || path.endsWith(QLatin1String(".svg"), Qt::CaseInsensitive);
+}
+
+QSize Cantor::ImageResult::vectorImageSize(const QString& path)
+{
+    if (path.endsWith(QLatin1String(".pdf"), Qt::CaseInsensitive))
+    {
+        // the document is loaded once and kept for the rasterization by the renderer
+        const QSizeF& pageSize = Renderer::pdfPageSize(QUrl::fromLocalFile(path));
+        if (pageSize.isEmpty())
+            return QSize();
+
+        // page size is in points
+        const static int dpi = QApplication::desktop()->logicalDpiX();
+        return (pageSize * dpi / 72).toSize();
+    }
+
+    QSvgRenderer renderer(path);
+    if (!renderer.isValid())
+        return QSize();
+
+    // SVG document size is in points, convert to pixels
+    const static int dpi = QApplication::desktop()->physicalDpiX();
+    return (QSizeF(renderer.defaultSize()) * dpi / 72).toSize();
+}
+
+QImage Cantor::ImageResult::renderVectorImage(const QString& path, const QSize& size)
+{
+    if (size.isEmpty())
+        return QImage();
+
+    if (path.endsWith(QLatin1String(".pdf"), Qt::CaseInsensitive))
+    {
+        // rendered from the thread pool, poppler is only used with the locking of the renderer
+        return Renderer::pdfRenderToSize(QUrl::fromLocalFile(path), size);
+    }
+
+    QSvgRenderer renderer(path);
+    if (!renderer.isValid())
+        return QImage();
+
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    renderer.render(&painter);
+    painter.end();
+
+    return image;
+}
@@ -47,6 +47,20 @@ class CANTOR_EXPORT ImageResult : public Result
 
     void save(const QString& filename) override;
 
+    /**
+     * Returns true if @p path is a PDF or a SVG file, these are rasterized in the displayed size
+     */
+    static bool isVectorImage(const QString& path);
+    /**
+     * Size of the vector image in @p path in pixels for the resolution of the screen
+     */
+    static QSize vectorImageSize(const QString& path);
+    /**
+     * Rasterizes the first page of the vector image in @p path into an image of @p size pixels.
+     * Can be called from other threads than the GUI thread.
+     */
+    static QImage renderVectorImage(const QString& path, const QSize& size);
+
   private:
     ImageResultPrivate* d;
 };
@@ -0,0 +1,190 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#include "largetextbuffer.h"
+using namespace Cantor;
+
+#include <QDebug>
+#include <QTemporaryFile>
+
+LargeTextBuffer::LargeTextBuffer(const QString& text) : m_data(text.toUtf8())
+{
+    m_size = m_data.size();
+    m_lineOffsets.reserve(m_size / 64 + 2);
+    m_lineOffsets.append(0);
+    indexLines(0);
+
+    if (m_size >= FileBackedThreshold)
+        map();
+}
+
+LargeTextBuffer::~LargeTextBuffer()
+{
+    if (m_file)
+    {
+        m_file->unmap(reinterpret_cast<uchar*>(const_cast<char*>(m_mapped)));
+        delete m_file;
+    }
+}
+
+void LargeTextBuffer::append(const QString& text)
+{
+    const QByteArray& bytes = text.toUtf8();
+    if (bytes.isEmpty())
+        return;
+
+    const qint64 previousSize = m_size;
+    if (m_mapped)
+    {
+        m_file->unmap(reinterpret_cast<uchar*>(const_cast<char*>(m_mapped)));
+        m_mapped = nullptr;
+        if (!m_file->seek(m_size) || m_file->write(bytes) != bytes.size() || !map())
+        {
+            // keep the text in memory if the file can't be extended
+            qDebug() << "failed to extend the mapped large text, keeping it in memory" << m_file->errorString();
+            m_file->seek(0);
+            m_data = m_file->read(m_size) + bytes;
+            delete m_file;
+            m_file = nullptr;
+        }
+    }
+    else
+        m_data += bytes;
+    m_size += bytes.size();
+
+    // the end of the text is no line start, unless the text ended with a line break
+    if (previousSize == 0 || data()[previousSize - 1] != '\n')
+        m_lineOffsets.removeLast();
+    indexLines(previousSize);
+
+    if (!m_mapped && m_size >= FileBackedThreshold)
+        map();
+}
+
+/*!
+ * indexes the lines of the text starting at @p from, the start of the line containing
+ * @p from has to be the last offset. Long lines are split without breaking UTF-8 sequences.
+ */
+void LargeTextBuffer::indexLines(qint64 from)
+{
+    const char* begin = data();
+    quint32 lineStart = m_lineOffsets.constLast();
+    for (quint32 i = static_cast<quint32>(from); i < static_cast<quint32>(m_size); ++i)
+    {
+        if (begin[i] == '\n')
+        {
+            lineStart = i + 1;
+            m_lineOffsets.append(lineStart);
+        }
+        else if (i - lineStart >= static_cast<quint32>(MaxLineLength))
+        {
+            quint32 split = i;
+            while (split > lineStart && (static_cast<uchar>(begin[split]) & 0xC0) == 0x80)
+                --split;
+            lineStart = split > lineStart ? split : i;
+            m_lineOffsets.append(lineStart);
+        }
+    }
+    if (m_lineOffsets.constLast() != static_cast<quint32>(m_size) || m_size == 0)
+        m_lineOffsets.append(m_size);
+    m_lineOffsets.squeeze();
+}
+
+/*!
+ * moves the text into a temporary file mapped into the memory, or maps the already written file
+ */
+bool LargeTextBuffer::map()
+{
+    if (!m_file)
+    {
+        m_file = new QTemporaryFile();
+        if (!m_file->open() || m_file->write(m_data) != m_size)
+        {
+            qDebug() << "failed to move the large text into a file, keeping it in memory" << m_file->errorString();
+            delete m_file;
+            m_file = nullptr;
+            return false;
+        }
+    }
+
+    uchar* mapped = m_file->map(0, m_size);
+    if (!mapped)
+    {
+        if (!m_data.isEmpty())
+        {
+            qDebug() << "failed to map the large text, keeping it in memory" << m_file->errorString();
+            delete m_file;
+            m_file = nullptr;
+        }
+        return false;
+    }
+
+    m_mapped = reinterpret_cast<const char*>(mapped);
+    m_data.clear();
+    m_data.squeeze();
+    return true;
+}
+
+const char* LargeTextBuffer::data() const
+{
+    return m_mapped ? m_mapped : m_data.constData();
+}
+
+int LargeTextBuffer::lineCount() const
+{
+    return m_lineOffsets.size() - 1;
+}
+
+QString LargeTextBuffer::line(int index) const
+{
+    if (index < 0 || index >= lineCount())
+        return QString();
+
+    const quint32 start = m_lineOffsets.at(index);
+    quint32 end = m_lineOffsets.at(index + 1);
+    if (end > start && data()[end - 1] == '\n')
+        --end;
+
+    return QString::fromUtf8(data() + start, end - start);
+}
+
+QString LargeTextBuffer::lines(int first, int count) const
+{
+    first = qBound(0, first, lineCount());
+    const int last = qBound(first, first + count, lineCount());
+    if (first == last)
+        return QString();
+
+    // the lines split because of their length are joined by a line break too
+    QString text;
+    text.reserve(m_lineOffsets.at(last) - m_lineOffsets.at(first) + count);
+    for (int i = first; i < last; ++i)
+    {
+        if (i != first)
+            text += QLatin1Char('\n');
+        text += line(i);
+    }
+    return text;
+}
+
+QString LargeTextBuffer::text() const
+{
+    return QString::fromUtf8(data(), m_size);
+}
+
+QByteArray LargeTextBuffer::utf8() const
+{
+    return QByteArray::fromRawData(data(), m_size);
+}
+
+qint64 LargeTextBuffer::size() const
+{
+    return m_size;
+}
+
+bool LargeTextBuffer::isFileBacked() const
+{
+    return m_mapped != nullptr;
+}
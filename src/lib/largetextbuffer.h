@@ -0,0 +1,78 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#ifndef _LARGETEXTBUFFER_H
+#define _LARGETEXTBUFFER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+#include "cantor_export.h"
+
+class QTemporaryFile;
+
+namespace Cantor
+{
+
+/**
+ * Storage for large texts. The text is kept UTF-8 encoded together with the offsets
+ * of the lines, so single lines can be accessed without converting the whole text.
+ * Very large texts are moved into a temporary file which is mapped into the memory,
+ * the heap only holds the line index then. Text can only be appended.
+ *
+ * Lines longer than MaxLineLength bytes are split into several lines to keep the
+ * layouting of a single line cheap.
+ */
+class CANTOR_EXPORT LargeTextBuffer
+{
+  public:
+    explicit LargeTextBuffer(const QString& text);
+    ~LargeTextBuffer();
+
+    LargeTextBuffer(const LargeTextBuffer&) = delete;
+    LargeTextBuffer& operator=(const LargeTextBuffer&) = delete;
+
+    /**
+     * Appends @p text, only the appended lines are indexed
+     */
+    void append(const QString& text);
+
+    int lineCount() const;
+    QString line(int index) const;
+    QString lines(int first, int count) const;
+
+    /**
+     * Converts the whole text, only use it when the whole text is needed
+     */
+    QString text() const;
+
+    /**
+     * The UTF-8 encoded text without a copy, valid until the buffer is changed or deleted
+     */
+    QByteArray utf8() const;
+
+    qint64 size() const;
+    bool isFileBacked() const;
+
+    static const int MaxLineLength = 4096;
+    static const qint64 FileBackedThreshold = 16 * 1024 * 1024;
+
+  private:
+    const char* data() const;
+    void indexLines(qint64 from);
+    bool map();
+
+  private:
+    QByteArray m_data;
+    QTemporaryFile* m_file{nullptr};
+    const char* m_mapped{nullptr};
+    qint64 m_size{0};
+    QVector<quint32> m_lineOffsets; // start of every line and the end of the text
+};
+
+}
+
+#endif /* _LARGETEXTBUFFER_H */
@@ -31,14 +31,17 @@ class Cantor::LatexRendererPrivate
     bool success;
     QString latexFilename;
     QString epsFilename;
+    int page;
+    LatexRenderer::ImageFormat imageFormat;
     QString uuid;
+    QImage image;
     QTemporaryFile* texFile;
 };
 
 static const QLatin1String tex("\\documentclass[fleqn]{article}"\
                          "\\usepackage{latexsym,amsfonts,amssymb,ulem}"\
                          "\\usepackage{amsmath}"\
-                         "\\usepackage[dvips]{graphicx}"\
+                         "\\usepackage{graphicx}"\
                          "\\usepackage[utf8]{inputenc}"\
                          "\\usepackage{xcolor}"\
                          "\\setlength\\textwidth{5in}"\
@@ -52,6 +55,12 @@ static const QLatin1String tex("\\documentclass[fleqn]{article}"\
                          "%9\n"\
                          "\\end{document}");
 
+// pdflatex produces full pages, the preview package crops every page to its content
+// like dvips -E does it for EPS. Every preview environment is shipped out as separate page.
+static const QLatin1String pdfHeader("\\usepackage[active,tightpage]{preview}"\
+                                     "\\setlength\\PreviewBorder{0pt}");
+static const QLatin1String pdfPage("\\begin{preview}%1\\end{preview}");
+
 static const QLatin1String eqnHeader("\\begin{eqnarray*}%1\\end{eqnarray*}");
 static const QLatin1String inlineEqnHeader("$%1$");
 
@@ -63,6 +72,8 @@ LatexRenderer::LatexRenderer(QObject* parent) : QObject(parent),
     d->equationType=InlineEquation;
     d->success=false;
     d->texFile=nullptr;
+    d->page=-1;
+    d->imageFormat=defaultImageFormat();
 }
 
 LatexRenderer::~LatexRenderer()
@@ -115,6 +126,16 @@ LatexRenderer::EquationType LatexRenderer::equationType() const
     return d->equationType;
 }
 
+void LatexRenderer::setImageFormat(LatexRenderer::ImageFormat format)
+{
+    d->imageFormat=format;
+}
+
+LatexRenderer::ImageFormat LatexRenderer::imageFormat() const
+{
+    return d->imageFormat;
+}
+
 
 void LatexRenderer::setErrorMessage(const QString& msg)
 {
@@ -147,11 +168,25 @@ QString LatexRenderer::imagePath() const
     return d->epsFilename;
 }
 
+QUrl LatexRenderer::imageUrl() const
+{
+    QUrl url = QUrl::fromLocalFile(d->epsFilename);
+    if (d->page != -1)
+        url.setFragment(QLatin1String("page=") + QString::number(d->page));
+
+    return url;
+}
+
 QString Cantor::LatexRenderer::uuid() const
 {
     return d->uuid;
 }
 
+QImage LatexRenderer::image() const
+{
+    return d->image;
+}
+
 bool LatexRenderer::render()
 {
     switch(d->method)
@@ -181,38 +216,73 @@ void LatexRenderer::renderBlocking()
         return;
 }
 
-bool LatexRenderer::renderWithLatex()
+QString LatexRenderer::document(const QString& header, const QString& body, ImageFormat format)
 {
-    qDebug()<<"rendering using latex method";
-    QString dir=QStandardPaths::writableLocation(QStandardPaths::TempLocation);
-
-    if (d->texFile)
-        delete d->texFile;
-
-    d->texFile=new QTemporaryFile(dir + QDir::separator() + QLatin1String("cantor_tex-XXXXXX.tex"));
-    d->texFile->open();
-
     KColorScheme scheme(QPalette::Active);
     const QColor backgroundColor=scheme.background().color();
     const QColor foregroundColor=scheme.foreground().color();
     QString expressionTex=tex;
-    expressionTex=expressionTex.arg(d->header)
+    expressionTex=expressionTex.arg(format == PdfImage ? pdfHeader + header : header)
                                .arg(backgroundColor.redF()).arg(backgroundColor.greenF()).arg(backgroundColor.blueF())
                                .arg(foregroundColor.redF()).arg(foregroundColor.greenF()).arg(foregroundColor.blueF());
 
     int fontPointSize = QApplication::font().pointSize();
     expressionTex=expressionTex.arg(fontPointSize);
 
+    return expressionTex.arg(body);
+}
+
+QString LatexRenderer::documentBody() const
+{
     if(isEquationOnly())
     {
         switch(equationType())
         {
-            case FullEquation: expressionTex=expressionTex.arg(eqnHeader); break;
-            case InlineEquation: expressionTex=expressionTex.arg(inlineEqnHeader); break;
-            case CustomEquation: expressionTex=expressionTex.arg(QLatin1String("%1")); break;
+            case FullEquation: return QString(eqnHeader).arg(d->latexCode);
+            case InlineEquation: return QString(inlineEqnHeader).arg(d->latexCode);
+            case CustomEquation: break;
         }
     }
-    expressionTex=expressionTex.arg(d->latexCode);
+
+    return d->latexCode;
+}
+
+QString LatexRenderer::page(const QString& body, ImageFormat format)
+{
+    if (format == PdfImage)
+        return QString(pdfPage).arg(body);
+
+    return body;
+}
+
+bool LatexRenderer::preparePreviewStyle(const QString& dir)
+{
+    // preview.sty is not part of every TeX installation, use the copy shipped with Cantor
+    if (QFile::exists(dir + QDir::separator() + QLatin1String("preview.sty")))
+        return true;
+
+    QString file = QStandardPaths::locate(QStandardPaths::AppDataLocation, QLatin1String("latex/preview.sty"));
+    if (file.isEmpty())
+        file = QStandardPaths::locate(QStandardPaths::GenericDataLocation, QLatin1String("cantor/latex/preview.sty"));
+
+    if (file.isEmpty())
+        return false;
+
+    return QFile::copy(file, dir + QDir::separator() + QLatin1String("preview.sty"));
+}
+
+bool LatexRenderer::renderWithLatex()
+{
+    qDebug()<<"rendering using latex method";
+    QString dir=QStandardPaths::writableLocation(QStandardPaths::TempLocation);
+
+    if (d->texFile)
+        delete d->texFile;
+
+    d->texFile=new QTemporaryFile(dir + QDir::separator() + QLatin1String("cantor_tex-XXXXXX.tex"));
+    d->texFile->open();
+
+    const QString& expressionTex = document(d->header, page(documentBody(), d->imageFormat), d->imageFormat);
 
     // qDebug()<<"full tex:\n"<<expressionTex;
 
@@ -227,6 +297,29 @@ bool LatexRenderer::renderWithLatex()
 
     d->uuid = genUuid();
 
+    if (d->imageFormat == PdfImage)
+    {
+        // pdflatex produces the final image directly, no conversion step is needed
+        d->epsFilename = dir + QDir::separator() + QLatin1String("cantor_") + d->uuid + QLatin1String(".pdf");
+        d->page = -1;
+
+        QFileInfo info(Settings::self()->pdflatexCommand());
+        if (info.exists() && info.isExecutable() && preparePreviewStyle(dir))
+        {
+            p->setProgram(Settings::self()->pdflatexCommand());
+            p->setArguments({QStringLiteral("-jobname=cantor_") + d->uuid, QStringLiteral("-halt-on-error"), fileName});
+
+            connect(p, SIGNAL(finished(int,QProcess::ExitStatus)), this, SLOT(convertingDone()) );
+            p->start();
+            return true;
+        }
+        else
+        {
+            setErrorMessage(QStringLiteral("failed to find pdflatex executable or preview.sty"));
+            return false;
+        }
+    }
+
     qDebug() << Settings::self()->latexCommand();
     QFileInfo info(Settings::self()->latexCommand());
     if (info.exists() && info.isExecutable())
@@ -251,6 +344,7 @@ void LatexRenderer::convertToPs()
 
     QString dviFile = dir + QDir::separator() + QStringLiteral("cantor_") + d->uuid + QStringLiteral(".dvi");
     d->epsFilename = dir + QDir::separator() + QLatin1String("cantor_")+d->uuid+QLatin1String(".eps");
+    d->page = -1;
 
     QProcess *p=new QProcess( this );
     qDebug()<<"converting to eps: "<<Settings::self()->dvipsCommand()<<"-E"<<"-o"<<d->epsFilename<<dviFile;
@@ -297,6 +391,25 @@ void LatexRenderer::convertingDone()
     }
 }
 
+void LatexRenderer::finishBatched(bool success, const QString& uuid, const QUrl& imageUrl, const QImage& image, const QString& errorMessage)
+{
+    d->uuid = uuid;
+    d->epsFilename = imageUrl.toLocalFile();
+    d->page = -1;
+    if (imageUrl.fragment().startsWith(QLatin1String("page=")))
+        d->page = imageUrl.fragment().mid(5).toInt();
+    d->image = image;
+    d->success = success;
+
+    if (success)
+        emit done();
+    else
+    {
+        setErrorMessage(errorMessage);
+        emit error();
+    }
+}
+
 bool LatexRenderer::renderWithMml()
 {
     qWarning()<<"WARNING: MML rendering not implemented yet!";
@@ -314,8 +427,27 @@ QString LatexRenderer::genUuid()
 }
 
 bool Cantor::LatexRenderer::isLatexAvailable()
+{
+    return isEpsPipelineAvailable() || isPdfLatexAvailable();
+}
+
+bool Cantor::LatexRenderer::isEpsPipelineAvailable()
 {
     QFileInfo infoLatex(Settings::self()->latexCommand());
     QFileInfo infoPs(Settings::self()->dvipsCommand());
     return infoLatex.exists() && infoLatex.isExecutable() && infoPs.exists() && infoPs.isExecutable();
 }
+
+bool Cantor::LatexRenderer::isPdfLatexAvailable()
+{
+    QFileInfo info(Settings::self()->pdflatexCommand());
+    return info.exists() && info.isExecutable();
+}
+
+LatexRenderer::ImageFormat Cantor::LatexRenderer::defaultImageFormat()
+{
+    if (Settings::self()->usePdfLatex() && isPdfLatexAvailable())
+        return PdfImage;
+
+    return EpsImage;
+}
@@ -7,10 +7,13 @@
 #define _LATEXRENDERER_H
 
 #include <QObject>
+#include <QImage>
+#include <QUrl>
 #include "cantor_export.h"
 
 namespace Cantor{
 class LatexRendererPrivate;
+class TypesettingQueue;
 
 class CANTOR_EXPORT LatexRenderer : public QObject
 {
@@ -18,6 +21,11 @@ class CANTOR_EXPORT LatexRenderer : public QObject
   public:
     enum Method{ LatexMethod = 0, MmlMethod = 1};
     enum EquationType{ InlineEquation = 0, FullEquation = 1, CustomEquation = 2};
+    /**
+     * Format of the produced image: EPS is created by latex and dvips,
+     * PDF directly by pdflatex and is rasterized by Poppler.
+     */
+    enum ImageFormat{ EpsImage = 0, PdfImage = 1};
     explicit LatexRenderer( QObject* parent = nullptr);
     ~LatexRenderer() override;
 
@@ -32,16 +40,39 @@ class CANTOR_EXPORT LatexRenderer : public QObject
     bool isEquationOnly() const;
     void setEquationType(EquationType type);
     EquationType equationType() const;
+    void setImageFormat(ImageFormat format);
+    ImageFormat imageFormat() const;
 
     QString errorMessage() const;
     bool renderingSuccessful() const;
 
     QString imagePath() const;
+    /**
+     * Url of the rendered image. Unlike imagePath() it also addresses the page
+     * (as "#page=N" fragment), if several results are stored in one PDF file.
+     */
+    QUrl imageUrl() const;
     QString uuid() const;
 
+    /**
+     * Preview of the rendered image at scale 1.0, if it was already rasterized
+     * during the rendering (e.g. by TypesettingQueue). Can be null.
+     */
+    QImage image() const;
+
     static QString genUuid();
 
+    /**
+     * Returns true, if any of the supported pipelines (latex and dvips, or pdflatex) is available
+     */
     static bool isLatexAvailable();
+    static bool isPdfLatexAvailable();
+
+    /**
+     * The image format used by default: PDF, if it is enabled in the settings and pdflatex is available,
+     * EPS otherwise.
+     */
+    static ImageFormat defaultImageFormat();
 
   Q_SIGNALS:
     void done();
@@ -53,7 +84,15 @@ class CANTOR_EXPORT LatexRenderer : public QObject
     void renderBlocking();
 
   private:
+    friend class TypesettingQueue;
+
     void setErrorMessage(const QString& msg);
+    QString documentBody() const;
+    static QString document(const QString& header, const QString& body, ImageFormat format);
+    static QString page(const QString& body, ImageFormat format);
+    static bool isEpsPipelineAvailable();
+    static bool preparePreviewStyle(const QString& dir);
+    void finishBatched(bool success, const QString& uuid, const QUrl& imageUrl, const QImage& image, const QString& errorMessage);
 
   private Q_SLOTS:
     bool renderWithLatex();
@@ -4,6 +4,7 @@
 */
 
 #include "panelplugin.h"
+#include "panelpluginhandler.h"
 using namespace Cantor;
 
 #include <KPluginMetaData>
@@ -13,6 +14,8 @@ class Cantor::PanelPluginPrivate
   public:
     QString name;
     QStringList requiredExtensions;
+    Backend::Capabilities requiredCapabilities = Backend::Nothing;
+    bool showOnStartup = true;
     Session* session = nullptr;
     QWidget* parentWidget = nullptr;
 };
@@ -41,7 +44,9 @@ QWidget* PanelPlugin::parentWidget()
 void PanelPlugin::setPluginInfo(const KPluginMetaData& info)
 {
     d->name = info.name();
-    d->requiredExtensions = info.value(QStringLiteral("RequiredExtensions")).split(QLatin1Char(','));
+    d->requiredExtensions = PanelPluginHandler::requiredExtensions(info);
+    d->requiredCapabilities = PanelPluginHandler::requiredCapabilities(info);
+    d->showOnStartup = PanelPluginHandler::showOnStartup(info);
     setObjectName(info.pluginId());
 }
 
@@ -52,7 +57,7 @@ QStringList PanelPlugin::requiredExtensions()
 
 Backend::Capabilities PanelPlugin::requiredCapabilities()
 {
-    return Backend::Nothing;
+    return d->requiredCapabilities;
 }
 
 QString PanelPlugin::name()
@@ -84,5 +89,5 @@ void Cantor::PanelPlugin::connectToShell(QObject* /* cantorShell */)
 
 bool Cantor::PanelPlugin::showOnStartup()
 {
-    return true;
+    return d->showOnStartup;
 }
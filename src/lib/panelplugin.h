@@ -61,6 +61,7 @@ class CANTOR_EXPORT PanelPlugin : public QObject
      * Returns the capabilities, the current backend
      * must provide to make this PanelPlugin work. If it doesn't
      * this PanelPlugin won't be enabled
+     * Default returns the capabilities listed in "RequiredCapabilities" of the metadata
      * @return the required capabilities
     */
     virtual Backend::Capabilities requiredCapabilities();
@@ -73,7 +74,8 @@ class CANTOR_EXPORT PanelPlugin : public QObject
     QString name();
 
     /**
-     * returns the widget, provided by this plugin
+     * returns the widget, provided by this plugin.
+     * The widget should be created on the first call, it's requested when the panel is shown the first time.
      * @return the widget, provided by this plugin
      **/
     virtual QWidget* widget() = 0;
@@ -100,7 +102,7 @@ class CANTOR_EXPORT PanelPlugin : public QObject
 
     /**
      * Show on worksheet startup or not
-     * Default returns true
+     * Default returns "ShowOnStartup" of the metadata, true if not set
      */
     virtual bool showOnStartup();
 
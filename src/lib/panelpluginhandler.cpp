@@ -9,10 +9,10 @@ using namespace Cantor;
 #include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
+#include <QJsonValue>
 
 #include <KPluginFactory>
 #include <KPluginMetaData>
-#include <KPluginFactory>
 
 #include "session.h"
 #include "backend.h"
@@ -20,7 +20,10 @@ using namespace Cantor;
 class Cantor::PanelPluginHandlerPrivate
 {
   public:
+    QVector<KPluginMetaData> metaData;
     QList<Cantor::PanelPlugin*> plugins;
+    // states of the plugins which are not instantiated yet
+    PanelPluginHandler::PanelStates pendingStates;
 };
 
 PanelPluginHandler::PanelPluginHandler( QObject* parent ) : QObject(parent) ,
@@ -36,28 +39,107 @@ PanelPluginHandler::~PanelPluginHandler()
 
 void PanelPluginHandler::loadPlugins()
 {
-    const QVector<KPluginMetaData> plugins = KPluginMetaData::findPlugins(QStringLiteral("cantor/panels"));
+    d->metaData = KPluginMetaData::findPlugins(QStringLiteral("cantor/panels"));
+
+    for (const KPluginMetaData& plugin : qAsConst(d->metaData))
+        if (loadOnStartup(plugin))
+            this->plugin(plugin.name());
+}
+
+QList<Cantor::PanelPlugin *> Cantor::PanelPluginHandler::allPlugins()
+{
+    return d->plugins;
+}
+
+QVector<KPluginMetaData> PanelPluginHandler::allPluginsMetaData() const
+{
+    return d->metaData;
+}
+
+PanelPlugin* PanelPluginHandler::plugin(const QString& name)
+{
+    for (auto* plugin : qAsConst(d->plugins))
+        if (plugin->name() == name)
+            return plugin;
 
-    for (const KPluginMetaData &plugin : plugins) {
+    for (const KPluginMetaData& plugin : qAsConst(d->metaData))
+    {
+        if (plugin.name() != name)
+            continue;
 
         const auto result = KPluginFactory::instantiatePlugin<PanelPlugin>(plugin, QCoreApplication::instance());
 
         if (!result) {
             qDebug() << "Error while loading panel: " << result.errorText;
-            continue;
+            return nullptr;
         }
 
         PanelPlugin *panel = result.plugin;
 
         panel->setPluginInfo(plugin);
         d->plugins.append(panel);
+        emit pluginLoaded(panel);
 
+        if (d->pendingStates.contains(name))
+            panel->restoreState(d->pendingStates.take(name));
+
+        return panel;
     }
+
+    return nullptr;
 }
 
-QList<Cantor::PanelPlugin *> Cantor::PanelPluginHandler::allPlugins()
+QStringList PanelPluginHandler::requiredExtensions(const KPluginMetaData& plugin)
 {
-    return d->plugins;
+    return plugin.value(QStringLiteral("RequiredExtensions")).split(QLatin1Char(','));
+}
+
+Backend::Capabilities PanelPluginHandler::requiredCapabilities(const KPluginMetaData& plugin)
+{
+    static const QMap<QString, Backend::Capability> names = {
+        {QLatin1String("LaTexOutput"), Backend::LaTexOutput},
+        {QLatin1String("InteractiveMode"), Backend::InteractiveMode},
+        {QLatin1String("SyntaxHighlighting"), Backend::SyntaxHighlighting},
+        {QLatin1String("Completion"), Backend::Completion},
+        {QLatin1String("SyntaxHelp"), Backend::SyntaxHelp},
+        {QLatin1String("VariableManagement"), Backend::VariableManagement},
+        {QLatin1String("VariableDimension"), Backend::VariableDimension},
+        {QLatin1String("IntegratedPlots"), Backend::IntegratedPlots},
+        {QLatin1String("PipelinedEvaluation"), Backend::PipelinedEvaluation}
+    };
+
+    Backend::Capabilities capabilities = Backend::Nothing;
+    const QStringList& required = plugin.value(QStringLiteral("RequiredCapabilities")).split(QLatin1Char(','), QString::SkipEmptyParts);
+    for (const QString& name : required)
+        capabilities |= names.value(name.trimmed(), Backend::Nothing);
+
+    return capabilities;
+}
+
+bool PanelPluginHandler::showOnStartup(const KPluginMetaData& plugin)
+{
+    return plugin.rawData().value(QLatin1String("ShowOnStartup")).toBool(true);
+}
+
+bool PanelPluginHandler::loadOnStartup(const KPluginMetaData& plugin)
+{
+    return plugin.rawData().value(QLatin1String("LoadOnStartup")).toBool(false);
+}
+
+bool PanelPluginHandler::isSupported(const KPluginMetaData& plugin, Session* session) const
+{
+    const auto capabilities = session->backend()->capabilities();
+    const QStringList& extensions = session->backend()->extensions();
+
+    bool supported=true;
+    for (const QString& req : requiredExtensions(plugin)){
+        // FIXME: That req.isEmpty() is there just because Help Panel has req
+        // empty, returning FALSE when the comparison must to return TRUE.
+        supported = supported && (extensions.contains(req) || req.isEmpty());
+    }
+
+    const auto required = requiredCapabilities(plugin);
+    return supported && ( (capabilities & required) == required);
 }
 
 QList<PanelPlugin*> PanelPluginHandler::plugins(Session* session)
@@ -67,22 +149,21 @@ QList<PanelPlugin*> PanelPluginHandler::plugins(Session* session)
     if (session == nullptr)
         return pluginsForSession;
 
-    const auto capabilities = session->backend()->capabilities();
-    const QStringList& extensions = session->backend()->extensions();
-
     qDebug()<<"loading panel plugins for session of type "<<session->backend()->name();
-    for (auto* plugin : d->plugins)
+    for (const KPluginMetaData& metaData : qAsConst(d->metaData))
     {
-        bool supported=true;
-        for (const QString& req : plugin->requiredExtensions()){
-            // FIXME: That req.isEmpty() is there just because Help Panel has req
-            // empty, returning FALSE when the comparison must to return TRUE.
-            supported = supported && (extensions.contains(req) || req.isEmpty());
-        }
-
-        supported = supported && ( (capabilities & plugin->requiredCapabilities()) == plugin->requiredCapabilities());
+        PanelPlugin* plugin = nullptr;
+        for (auto* loaded : qAsConst(d->plugins))
+            if (loaded->name() == metaData.name())
+            {
+                plugin = loaded;
+                break;
+            }
+
+        if (!plugin)
+            continue;
 
-        if(supported)
+        if(isSupported(metaData, session))
         {
             qDebug() << "plugin " << plugin->name()<<" is supported, requires extensions " << plugin->requiredExtensions();
             pluginsForSession.append(plugin);
@@ -94,25 +175,57 @@ QList<PanelPlugin*> PanelPluginHandler::plugins(Session* session)
     return pluginsForSession;
 }
 
+QVector<KPluginMetaData> PanelPluginHandler::preparePluginsForSession(Session* session, const PanelStates& previousPluginStates)
+{
+    QVector<KPluginMetaData> supported;
+    d->pendingStates.clear();
+
+    if (session == nullptr)
+        return supported;
+
+    for (const KPluginMetaData& metaData : qAsConst(d->metaData))
+    {
+        if (!isSupported(metaData, session))
+            continue;
+
+        supported.append(metaData);
+
+        const QString& name = metaData.name();
+        Cantor::PanelPlugin::State state;
+        if (previousPluginStates.contains(name))
+            state = previousPluginStates[name];
+        else
+            state.session = session;
+
+        PanelPlugin* plugin = nullptr;
+        for (auto* loaded : qAsConst(d->plugins))
+            if (loaded->name() == name)
+            {
+                plugin = loaded;
+                break;
+            }
+
+        if (plugin)
+            plugin->restoreState(state);
+        else
+            d->pendingStates.insert(name, state);
+    }
+
+    return supported;
+}
+
 QList<PanelPlugin*> PanelPluginHandler::activePluginsForSession(Session* session, const PanelStates& previousPluginStates)
 {
-    const auto& plugins = this->plugins(session);
-    for (auto* plugin : plugins)
+    QList<PanelPlugin*> plugins;
+    for (const KPluginMetaData& metaData : preparePluginsForSession(session, previousPluginStates))
     {
+        auto* plugin = this->plugin(metaData.name());
         if(!plugin)
         {
             qDebug()<<"somethings wrong with plugin inside PanelPluginHandler";
             continue;
         }
-
-        if (previousPluginStates.contains(plugin->name()))
-            plugin->restoreState(previousPluginStates[plugin->name()]);
-        else
-        {
-            Cantor::PanelPlugin::State initState;
-            initState.session = session;
-            plugin->restoreState(initState);
-        }
+        plugins.append(plugin);
     }
     return plugins;
 }
@@ -7,6 +7,8 @@
 #define _PANELPLUGINHANDLER_H
 
 #include <QObject>
+#include <QVector>
+#include <KPluginMetaData>
 #include "panelplugin.h"
 #include "cantor_export.h"
 
@@ -18,6 +20,13 @@ class Session;
 /**
  * Simple interface that exports a list of known PanelPlugins.
  * Needed as the Panel must be handled by the Shell
+ *
+ * The plugins are registered by their metadata and instantiated on the first
+ * call of plugin(), usually when the panel is shown for the first time.
+ * Plugins with "LoadOnStartup" in their metadata, because they have to follow
+ * the signals of the shell while being hidden, are instantiated by loadPlugins().
+ * The metadata keys "ShowOnStartup" and "RequiredCapabilities" allow to decide
+ * about the plugins without instantiating them.
  */
 
 class CANTOR_EXPORT PanelPluginHandler : public QObject
@@ -27,14 +36,49 @@ class CANTOR_EXPORT PanelPluginHandler : public QObject
     explicit PanelPluginHandler(QObject* parent);
     ~PanelPluginHandler() override;
 
+    /**
+     * Returns the instantiated plugins
+     */
     QList<PanelPlugin*> allPlugins();
+    /**
+     * Returns the instantiated plugins supported by @p session
+     */
     QList<PanelPlugin*> plugins(Session*);
 
+    /**
+     * Returns the metadata of all installed plugins
+     */
+    QVector<KPluginMetaData> allPluginsMetaData() const;
+
+    /**
+     * Returns the plugin with the name @p name, the plugin is instantiated on the first call.
+     * pluginLoaded() is emitted for new instances before the deferred state is restored.
+     */
+    PanelPlugin* plugin(const QString& name);
+
     using PanelStates = QMap<QString, Cantor::PanelPlugin::State>;
     QList<PanelPlugin*> activePluginsForSession(Session*, const PanelStates&);
 
+    /**
+     * Like activePluginsForSession(), but without instantiating the plugins.
+     * The states of the plugins not instantiated yet are restored in plugin().
+     * @return the metadata of the plugins supported by the session
+     */
+    QVector<KPluginMetaData> preparePluginsForSession(Session*, const PanelStates&);
+
     void loadPlugins();
 
+    static QStringList requiredExtensions(const KPluginMetaData&);
+    static Backend::Capabilities requiredCapabilities(const KPluginMetaData&);
+    static bool showOnStartup(const KPluginMetaData&);
+    static bool loadOnStartup(const KPluginMetaData&);
+
+  Q_SIGNALS:
+    void pluginLoaded(Cantor::PanelPlugin*);
+
+  private:
+    bool isSupported(const KPluginMetaData&, Session*) const;
+
   private:
     PanelPluginHandlerPrivate* d;
 
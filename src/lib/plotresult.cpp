@@ -0,0 +1,591 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#include "plotresult.h"
+#include "jupyterutils.h"
+using namespace Cantor;
+
+#include <QBuffer>
+#include <QDebug>
+#include <QFile>
+#include <QFontMetricsF>
+#include <QImage>
+#include <QPainter>
+#include <QtEndian>
+#include <QtMath>
+
+#include <KZip>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+static const char Magic[] = "CANTPLT1";
+static const int HeaderSize = 16;
+static const QSize DefaultImageSize(640, 400);
+
+class Cantor::PlotResultPrivate
+{
+  public:
+    PlotResultPrivate() = default;
+
+    bool load();
+    void updateRange();
+
+    QUrl url;
+    QString alt;
+    QFile file;
+    QByteArray storage; // the content of the file if it couldn't be mapped
+    QVector<QVector<double>> swapped; // the values converted on big-endian systems
+    QVector<PlotResult::Series> series;
+    double xMin{0};
+    double xMax{0};
+    bool ownsFile{false};
+
+    // the last decimation of every series, repaints of the same view don't decimate again
+    struct Decimation
+    {
+        double xMin{0};
+        double xMax{0};
+        int columns{0};
+        QPolygonF points;
+    };
+    mutable QVector<Decimation> decimations;
+};
+
+bool PlotResultPrivate::load()
+{
+    file.setFileName(url.toLocalFile());
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    const qint64 size = file.size();
+    if (size < HeaderSize)
+        return false;
+
+    const char* data = reinterpret_cast<const char*>(file.map(0, size));
+    if (!data)
+    {
+        storage = file.readAll();
+        data = storage.constData();
+    }
+
+    if (std::memcmp(data, Magic, 8) != 0)
+        return false;
+
+    const quint32 count = qFromLittleEndian<quint32>(data + 8);
+    qint64 offset = HeaderSize;
+    for (quint32 i = 0; i < count; ++i)
+    {
+        if (offset + 16 > size)
+            return false;
+
+        const quint32 nameLength = qFromLittleEndian<quint32>(data + offset);
+        const quint64 points = qFromLittleEndian<quint64>(data + offset + 8);
+        offset += 16;
+
+        const qint64 paddedName = (static_cast<qint64>(nameLength) + 7) / 8 * 8;
+        if (points > static_cast<quint64>(size) / 16 || offset + paddedName + static_cast<qint64>(points) * 16 > size)
+            return false;
+
+        PlotResult::Series s;
+        s.name = QString::fromUtf8(data + offset, nameLength);
+        offset += paddedName;
+        s.count = points;
+
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+        s.x = reinterpret_cast<const double*>(data + offset);
+        s.y = s.x + points;
+#else
+        QVector<double> values(points * 2);
+        for (qint64 k = 0; k < values.size(); ++k)
+        {
+            const quint64 bits = qFromLittleEndian<quint64>(data + offset + k * 8);
+            std::memcpy(&values[k], &bits, 8);
+        }
+        swapped << values;
+        s.x = swapped.last().constData();
+        s.y = s.x + points;
+#endif
+        offset += points * 16;
+
+        s.sorted = std::is_sorted(s.x, s.x + s.count);
+        series << s;
+    }
+
+    decimations.resize(series.size());
+    updateRange();
+    return true;
+}
+
+void PlotResultPrivate::updateRange()
+{
+    xMin = qInf();
+    xMax = -qInf();
+    for (const auto& s : series)
+    {
+        if (s.count == 0)
+            continue;
+
+        if (s.sorted)
+        {
+            xMin = qMin(xMin, s.x[0]);
+            xMax = qMax(xMax, s.x[s.count - 1]);
+        }
+        else
+        {
+            const auto minMax = std::minmax_element(s.x, s.x + s.count);
+            xMin = qMin(xMin, *minMax.first);
+            xMax = qMax(xMax, *minMax.second);
+        }
+    }
+
+    if (!qIsFinite(xMin) || !qIsFinite(xMax))
+    {
+        xMin = 0;
+        xMax = 1;
+    }
+    else if (xMin == xMax)
+    {
+        xMin -= 0.5;
+        xMax += 0.5;
+    }
+}
+
+PlotResult::PlotResult(const QUrl& url, const QString& alt) : d(new PlotResultPrivate)
+{
+    d->url = url;
+    d->alt = alt;
+
+    if (!d->load())
+    {
+        qDebug() << "failed to load the plot data" << url.toLocalFile();
+        d->series.clear();
+        d->decimations.clear();
+    }
+}
+
+PlotResult::~PlotResult()
+{
+    const QString& path = d->ownsFile ? d->file.fileName() : QString();
+    delete d;
+
+    // removed after it was unmapped and closed
+    if (!path.isEmpty())
+        QFile::remove(path);
+}
+
+QString PlotResult::toHtml()
+{
+    QByteArray bytes;
+    QBuffer buffer(&bytes);
+    toImage(DefaultImageSize).save(&buffer, "PNG");
+    return QStringLiteral("<img src=\"data:image/png;base64,%1\" alt=\"%2\"/>").arg(QString::fromLatin1(bytes.toBase64()), d->alt);
+}
+
+QVariant PlotResult::data()
+{
+    return QVariant(toImage(DefaultImageSize));
+}
+
+QUrl PlotResult::url()
+{
+    return d->url;
+}
+
+int PlotResult::type()
+{
+    return PlotResult::Type;
+}
+
+QString PlotResult::mimeType()
+{
+    return QStringLiteral("application/x-cantor-plot");
+}
+
+QDomElement PlotResult::toXml(QDomDocument& doc)
+{
+    QDomElement e = doc.createElement(QStringLiteral("Result"));
+    e.setAttribute(QStringLiteral("type"), QStringLiteral("plot"));
+    e.setAttribute(QStringLiteral("filename"), d->url.fileName());
+    if (!d->alt.isEmpty())
+        e.appendChild(doc.createTextNode(d->alt));
+
+    return e;
+}
+
+QJsonValue PlotResult::toJupyterJson()
+{
+    QJsonObject root;
+
+    if (executionIndex() != -1)
+    {
+        root.insert(QLatin1String("output_type"), QLatin1String("execute_result"));
+        root.insert(QLatin1String("execution_count"), executionIndex());
+    }
+    else
+        root.insert(QLatin1String("output_type"), QLatin1String("display_data"));
+
+    // Jupyter doesn't know the format, the plot is exported as image
+    QJsonObject data = JupyterUtils::packMimeBundle(toImage(DefaultImageSize), JupyterUtils::pngMime);
+    data.insert(JupyterUtils::textMime, JupyterUtils::toJupyterMultiline(d->alt));
+
+    root.insert(QLatin1String("data"), data);
+    root.insert(QLatin1String("metadata"), jupyterMetadata());
+
+    return root;
+}
+
+void PlotResult::saveAdditionalData(KZip* archive)
+{
+    archive->addLocalFile(d->url.toLocalFile(), d->url.fileName());
+}
+
+void PlotResult::save(const QString& filename)
+{
+    // the image formats get the rendered plot, everything else the data
+    bool rc;
+    if (filename.endsWith(QLatin1String(".png"), Qt::CaseInsensitive) || filename.endsWith(QLatin1String(".jpg"), Qt::CaseInsensitive))
+        rc = toImage(DefaultImageSize).save(filename);
+    else
+    {
+        QFile::remove(filename);
+        rc = QFile::copy(d->url.toLocalFile(), filename);
+    }
+
+    if (!rc)
+        qDebug() << "saving to " << filename << " failed.";
+}
+
+void PlotResult::setOwnsFile(bool ownsFile)
+{
+    d->ownsFile = ownsFile;
+}
+
+bool PlotResult::isValid() const
+{
+    return !d->series.isEmpty();
+}
+
+int PlotResult::seriesCount() const
+{
+    return d->series.size();
+}
+
+const PlotResult::Series& PlotResult::series(int index) const
+{
+    return d->series.at(index);
+}
+
+double PlotResult::xMinimum() const
+{
+    return d->xMin;
+}
+
+double PlotResult::xMaximum() const
+{
+    return d->xMax;
+}
+
+QPolygonF PlotResult::decimate(int index, double xMin, double xMax, int columns) const
+{
+    auto& cached = d->decimations[index];
+    if (cached.xMin == xMin && cached.xMax == xMax && cached.columns == columns && !cached.points.isEmpty())
+        return cached.points;
+
+    const Series& s = d->series.at(index);
+
+    // there are no columns to decimate into
+    if (!(xMax > xMin))
+    {
+        QPolygonF points;
+        points.reserve(s.count);
+        for (qint64 i = 0; i < s.count; ++i)
+            if (!std::isnan(s.y[i]))
+                points << QPointF(s.x[i], s.y[i]);
+        return points;
+    }
+
+    columns = qMax(1, columns);
+    const double columnWidth = (xMax - xMin) / columns;
+    QPolygonF points;
+
+    if (s.sorted)
+    {
+        // one point on each side of the range, so the lines leave the view at the right angle
+        qint64 first = std::lower_bound(s.x, s.x + s.count, xMin) - s.x;
+        qint64 last = std::upper_bound(s.x, s.x + s.count, xMax) - s.x;
+        first = qMax(qint64(0), first - 1);
+        last = qMin(s.count, last + 1);
+
+        if (last - first <= 4 * columns)
+        {
+            points.reserve(last - first);
+            for (qint64 i = first; i < last; ++i)
+                if (!std::isnan(s.y[i]))
+                    points << QPointF(s.x[i], s.y[i]);
+        }
+        else
+        {
+            // first, minimum, maximum and last point of every column in their order
+            points.reserve(4 * columns + 2);
+            qint64 i = first;
+            while (i < last)
+            {
+                const int column = qBound(0, static_cast<int>((s.x[i] - xMin) / columnWidth), columns - 1);
+                const double columnEnd = s.x[i] < xMin ? xMin : (s.x[i] > xMax ? qInf() : xMin + (column + 1) * columnWidth);
+
+                qint64 minIndex = -1;
+                qint64 maxIndex = -1;
+                const qint64 start = i;
+                for (; i < last && (s.x[i] < columnEnd || i == start); ++i)
+                {
+                    if (std::isnan(s.y[i]))
+                        continue;
+                    if (minIndex == -1 || s.y[i] < s.y[minIndex])
+                        minIndex = i;
+                    if (maxIndex == -1 || s.y[i] > s.y[maxIndex])
+                        maxIndex = i;
+                }
+                if (minIndex == -1)
+                    continue;
+
+                qint64 indices[4] = {start, qMin(minIndex, maxIndex), qMax(minIndex, maxIndex), i - 1};
+                qint64 previous = -1;
+                for (qint64 index : indices)
+                    if (index != previous && !std::isnan(s.y[index]))
+                    {
+                        points << QPointF(s.x[index], s.y[index]);
+                        previous = index;
+                    }
+            }
+        }
+    }
+    else
+    {
+        // scattered points, only the extremes of every column are kept
+        QVector<QPair<double, double>> extremes(columns, qMakePair(qInf(), -qInf()));
+        for (qint64 i = 0; i < s.count; ++i)
+        {
+            if (s.x[i] < xMin || s.x[i] > xMax || std::isnan(s.y[i]))
+                continue;
+
+            auto& column = extremes[qMin(columns - 1, static_cast<int>((s.x[i] - xMin) / columnWidth))];
+            column.first = qMin(column.first, s.y[i]);
+            column.second = qMax(column.second, s.y[i]);
+        }
+        for (int c = 0; c < columns; ++c)
+        {
+            if (extremes.at(c).first > extremes.at(c).second)
+                continue;
+            const double x = xMin + (c + 0.5) * columnWidth;
+            points << QPointF(x, extremes.at(c).first);
+            if (extremes.at(c).second != extremes.at(c).first)
+                points << QPointF(x, extremes.at(c).second);
+        }
+    }
+
+    cached.xMin = xMin;
+    cached.xMax = xMax;
+    cached.columns = columns;
+    cached.points = points;
+    return points;
+}
+
+// more ticks are never drawn, even if the step is too small for the precision of the range
+static const int maximumTicks = 100;
+
+static double tickStep(double range, int ticks)
+{
+    const double raw = range / qMax(1, ticks);
+    const double magnitude = std::pow(10.0, std::floor(std::log10(raw)));
+    const double normalized = raw / magnitude;
+    if (normalized < 1.5)
+        return magnitude;
+    else if (normalized < 3)
+        return 2 * magnitude;
+    else if (normalized < 7)
+        return 5 * magnitude;
+    return 10 * magnitude;
+}
+
+void PlotResult::paint(QPainter* painter, const QRectF& rect, double xMin, double xMax) const
+{
+    static const QColor colors[] = {QColor(31, 119, 180), QColor(255, 127, 14), QColor(44, 160, 44),
+                                    QColor(214, 39, 40), QColor(148, 103, 189), QColor(140, 86, 75)};
+
+    const QFontMetricsF metrics(painter->font());
+    const QRectF area = rect.adjusted(metrics.horizontalAdvance(QStringLiteral("-0.000e+00")) + 8, metrics.height(),
+                                      -metrics.height(), -metrics.height() - 8);
+    if (area.width() < 10 || area.height() < 10 || xMax <= xMin)
+        return;
+
+    // the y range fits to the visible points
+    QVector<QPolygonF> visible;
+    double yMin = qInf();
+    double yMax = -qInf();
+    for (int i = 0; i < d->series.size(); ++i)
+    {
+        const QPolygonF& points = decimate(i, xMin, xMax, static_cast<int>(area.width()));
+        for (const QPointF& p : points)
+        {
+            if (p.x() < xMin || p.x() > xMax || !qIsFinite(p.y()))
+                continue;
+            yMin = qMin(yMin, p.y());
+            yMax = qMax(yMax, p.y());
+        }
+        visible << points;
+    }
+    if (!qIsFinite(yMin) || !qIsFinite(yMax))
+    {
+        yMin = 0;
+        yMax = 1;
+    }
+    else if (yMin == yMax)
+    {
+        const double margin = yMin != 0 ? qAbs(yMin) * 0.1 : 0.5;
+        yMin -= margin;
+        yMax += margin;
+    }
+    else
+    {
+        const double margin = (yMax - yMin) * 0.05;
+        yMin -= margin;
+        yMax += margin;
+    }
+
+    // the values too close to each other for the precision are shown in the smallest distinguishable range
+    const double yMinimumRange = qMax(qMax(qAbs(yMin), qAbs(yMax)) * 1e-12, std::numeric_limits<double>::min());
+    if (yMax - yMin < yMinimumRange)
+    {
+        const double center = yMin / 2 + yMax / 2;
+        yMin = center - yMinimumRange / 2;
+        yMax = center + yMinimumRange / 2;
+    }
+
+    auto map = [&](const QPointF& p) {
+        return QPointF(area.left() + (p.x() - xMin) / (xMax - xMin) * area.width(),
+                       area.bottom() - (p.y() - yMin) / (yMax - yMin) * area.height());
+    };
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing, false);
+
+    // grid and tick labels
+    const QColor gridColor(220, 220, 220);
+    const double xStep = tickStep(xMax - xMin, qMax(2, static_cast<int>(area.width() / 100)));
+    const double xFirst = std::ceil(xMin / xStep) * xStep;
+    for (int i = 0; i < maximumTicks; ++i)
+    {
+        const double x = xFirst + i * xStep;
+        if (!qIsFinite(x) || x > xMax)
+            break;
+        const double px = map(QPointF(x, yMin)).x();
+        painter->setPen(gridColor);
+        painter->drawLine(QPointF(px, area.top()), QPointF(px, area.bottom()));
+        painter->setPen(Qt::black);
+        const QString& label = QString::number(qAbs(x) < xStep * 1e-9 ? 0 : x, 'g', 6);
+        painter->drawText(QRectF(px - 50, area.bottom() + 4, 100, metrics.height()), Qt::AlignHCenter | Qt::AlignTop, label);
+    }
+    const double yStep = tickStep(yMax - yMin, qMax(2, static_cast<int>(area.height() / 50)));
+    const double yFirst = std::ceil(yMin / yStep) * yStep;
+    for (int i = 0; i < maximumTicks; ++i)
+    {
+        const double y = yFirst + i * yStep;
+        if (!qIsFinite(y) || y > yMax)
+            break;
+        const double py = map(QPointF(xMin, y)).y();
+        painter->setPen(gridColor);
+        painter->drawLine(QPointF(area.left(), py), QPointF(area.right(), py));
+        painter->setPen(Qt::black);
+        const QString& label = QString::number(qAbs(y) < yStep * 1e-9 ? 0 : y, 'g', 6);
+        painter->drawText(QRectF(rect.left(), py - metrics.height() / 2, area.left() - rect.left() - 4, metrics.height()), Qt::AlignRight | Qt::AlignVCenter, label);
+    }
+    painter->setPen(Qt::black);
+    painter->drawRect(area);
+
+    // the series
+    painter->setClipRect(area);
+    painter->setRenderHint(QPainter::Antialiasing, true);
+    QStringList legend;
+    for (int i = 0; i < visible.size(); ++i)
+    {
+        QPolygonF mapped;
+        mapped.reserve(visible.at(i).size());
+        for (const QPointF& p : visible.at(i))
+            mapped << map(p);
+
+        const QColor& color = colors[i % (sizeof(colors) / sizeof(colors[0]))];
+        painter->setPen(QPen(color, 1.2));
+        if (d->series.at(i).sorted)
+            painter->drawPolyline(mapped);
+        else
+            painter->drawPoints(mapped);
+
+        legend << d->series.at(i).name;
+    }
+    painter->setClipping(false);
+
+    // legend in the upper right corner
+    double y = area.top() + 4;
+    for (int i = 0; i < legend.size(); ++i)
+    {
+        if (legend.at(i).isEmpty())
+            continue;
+        const double width = metrics.horizontalAdvance(legend.at(i));
+        const QRectF textRect(area.right() - width - 8, y, width, metrics.height());
+        painter->setPen(colors[i % (sizeof(colors) / sizeof(colors[0]))]);
+        painter->drawLine(QPointF(textRect.left() - 16, textRect.center().y()), QPointF(textRect.left() - 4, textRect.center().y()));
+        painter->setPen(Qt::black);
+        painter->drawText(textRect, Qt::AlignLeft | Qt::AlignVCenter, legend.at(i));
+        y += metrics.height();
+    }
+
+    painter->restore();
+}
+
+QImage PlotResult::toImage(const QSize& size) const
+{
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::white);
+
+    QPainter painter(&image);
+    paint(&painter, QRectF(QPointF(0, 0), size), d->xMin, d->xMax);
+    painter.end();
+
+    return image;
+}
+
+bool PlotResult::writeData(const QString& fileName, const QString& name, const QVector<double>& x, const QVector<double>& y)
+{
+    if (x.size() != y.size())
+        return false;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    const QByteArray& nameData = name.toUtf8();
+    QByteArray header(HeaderSize + 16, '\0');
+    std::memcpy(header.data(), Magic, 8);
+    qToLittleEndian<quint32>(1, header.data() + 8);
+    qToLittleEndian<quint32>(nameData.size(), header.data() + HeaderSize);
+    qToLittleEndian<quint64>(x.size(), header.data() + HeaderSize + 8);
+    header += nameData;
+    header += QByteArray((8 - nameData.size() % 8) % 8, '\0');
+
+    QByteArray values(x.size() * 16, '\0');
+    for (int i = 0; i < x.size(); ++i)
+    {
+        quint64 bits;
+        std::memcpy(&bits, &x[i], 8);
+        qToLittleEndian<quint64>(bits, values.data() + i * 8);
+        std::memcpy(&bits, &y[i], 8);
+        qToLittleEndian<quint64>(bits, values.data() + (x.size() + i) * 8);
+    }
+
+    return file.write(header) == header.size() && file.write(values) == values.size();
+}
@@ -0,0 +1,111 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#ifndef _PLOTRESULT_H
+#define _PLOTRESULT_H
+
+#include "result.h"
+
+#include <QPolygonF>
+#include <QRectF>
+#include <QStringList>
+#include <QUrl>
+#include <QVector>
+
+class QImage;
+class QPainter;
+
+namespace Cantor
+{
+class PlotResultPrivate;
+
+/**
+ * Result for numeric 2D plots. The data of the plot is not rendered by the backend
+ * but passed as raw arrays in a binary file, which is mapped into the memory.
+ * Cantor renders the plot itself, only the points visible in the current view are
+ * rendered and they are decimated to the minimum and the maximum of every pixel column,
+ * so even plots with millions of points can be zoomed and panned interactively.
+ *
+ * The file consists of a 16 bytes header, the magic "CANTPLT1", the number of series
+ * as unsigned 32 bit integer and 4 reserved bytes. Every series follows with the length
+ * of its UTF-8 encoded name as unsigned 32 bit integer, 4 reserved bytes, the number of points
+ * as unsigned 64 bit integer, the name padded to a multiple of 8 bytes, the x values and the y values
+ * as 64 bit IEEE 754 floating point numbers. All numbers are stored little-endian.
+ */
+class CANTOR_EXPORT PlotResult : public Result
+{
+  public:
+    enum { Type = 9 };
+
+    /**
+     * The values of one series of the plot. The pointers are valid as long as the result exists.
+     */
+    struct Series
+    {
+        QString name;
+        const double* x{nullptr};
+        const double* y{nullptr};
+        qint64 count{0};
+        bool sorted{true}; // true if the x values are ascending
+    };
+
+    explicit PlotResult(const QUrl& url, const QString& alt = QString());
+    ~PlotResult() override;
+
+    QString toHtml() override;
+    QVariant data() override;
+    QUrl url() override;
+
+    int type() override;
+    QString mimeType() override;
+
+    QDomElement toXml(QDomDocument& doc) override;
+    QJsonValue toJupyterJson() override;
+    void saveAdditionalData(KZip* archive) override;
+
+    void save(const QString& filename) override;
+
+    /**
+     * The file written by the backend for this result only is removed together with the result
+     */
+    void setOwnsFile(bool ownsFile);
+
+    bool isValid() const;
+    int seriesCount() const;
+    const Series& series(int index) const;
+
+    /**
+     * the range of the x values of all series
+     */
+    double xMinimum() const;
+    double xMaximum() const;
+
+    /**
+     * Returns the points of the series @p index in the x range from @p xMin to @p xMax.
+     * If there are more points than @p columns pixel columns can show, only the first, the last,
+     * the smallest and the largest value of every column are returned.
+     * All the points are returned if the range is empty.
+     */
+    QPolygonF decimate(int index, double xMin, double xMax, int columns) const;
+
+    /**
+     * Paints the plot of the x range from @p xMin to @p xMax into @p rect,
+     * the y range is adjusted to the visible values.
+     */
+    void paint(QPainter* painter, const QRectF& rect, double xMin, double xMax) const;
+    QImage toImage(const QSize& size) const;
+
+    /**
+     * Writes a file with a single series in the format read by this class
+     */
+    static bool writeData(const QString& fileName, const QString& name, const QVector<double>& x, const QVector<double>& y);
+
+  private:
+    PlotResultPrivate* d;
+};
+
+}
+
+#endif /* _PLOTRESULT_H */
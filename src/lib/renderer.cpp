@@ -7,7 +7,16 @@
 
 #include <QUuid>
 #include <QDebug>
+#include <QCache>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
 #include <QMutex>
+#include <QPageSize>
+#include <QPainter>
+#include <QPdfWriter>
+#include <QSharedPointer>
 
 #include <config-cantorlib.h>
 
@@ -23,6 +32,122 @@ using namespace Cantor;
 // and not common widespread in repositories
 static QMutex popplerMutex;
 
+// Ghostscript, used by libspectre, doesn't support several instances running in parallel
+// in all versions, so EPS files rendered from the thread pool have to be serialized
+static QMutex spectreMutex;
+
+// Loaded pdf documents are kept in a small LRU list, so that rendering several pages of
+// the same file or rendering the same file again for another zoom level doesn't reparse it.
+// A document and its pages are not reentrant, the entry's mutex serializes their usage.
+struct PopplerDocumentEntry
+{
+    ~PopplerDocumentEntry()
+    {
+        qDeleteAll(pages);
+        QMutexLocker locker(&popplerMutex);
+        delete document;
+    }
+
+    QString path;
+    QDateTime modified;
+    qint64 fileSize{0};
+    QMutex mutex;
+    Poppler::Document* document{nullptr};
+    QHash<int, Poppler::Page*> pages;
+};
+
+static const int maxCachedDocuments = 16;
+// guarded by popplerMutex, the most recently used document first
+static QList<QSharedPointer<PopplerDocumentEntry>> documentCache;
+
+// Rasterized images per file, page and scale bucket. The key contains the modification
+// time of the file, so the images of regenerated files are never reused.
+struct RasterEntry
+{
+    QImage image;
+    QSizeF size;
+};
+
+static QMutex rasterMutex;
+static QCache<QString, RasterEntry> rasterCache(64 * 1024); // cost in KiB
+
+static QSharedPointer<PopplerDocumentEntry> popplerDocument(const QString& path)
+{
+    const QFileInfo info(path);
+
+    // evicted entries are destroyed after the mutex is released, their destructor locks it
+    QList<QSharedPointer<PopplerDocumentEntry>> evicted;
+    QMutexLocker locker(&popplerMutex);
+
+    for (int i = 0; i < documentCache.size(); ++i)
+    {
+        if (documentCache.at(i)->path != path)
+            continue;
+
+        if (documentCache.at(i)->modified == info.lastModified() && documentCache.at(i)->fileSize == info.size())
+        {
+            documentCache.move(i, 0);
+            return documentCache.first();
+        }
+
+        evicted << documentCache.takeAt(i);
+        break;
+    }
+
+    Poppler::Document* document = Poppler::Document::load(path);
+    if (document == nullptr)
+        return QSharedPointer<PopplerDocumentEntry>();
+
+    auto entry = QSharedPointer<PopplerDocumentEntry>::create();
+    entry->path = path;
+    entry->modified = info.lastModified();
+    entry->fileSize = info.size();
+    entry->document = document;
+
+    documentCache.prepend(entry);
+    while (documentCache.size() > maxCachedDocuments)
+        evicted << documentCache.takeLast();
+
+    return entry;
+}
+
+// Zooming produces arbitrary scale factors, images differing by less than a percent are shared
+static double scaleBucket(double scale)
+{
+    return qRound(scale * 100) / 100.0;
+}
+
+static QString rasterKey(const QUrl& url, double scale, bool useHighRes)
+{
+    const QFileInfo info(url.toLocalFile());
+    return info.absoluteFilePath() + QLatin1Char('#') + url.fragment()
+        + QLatin1Char('|') + QString::number(info.lastModified().toMSecsSinceEpoch())
+        + QLatin1Char('|') + QString::number(info.size())
+        + QLatin1Char('|') + (useHighRes ? QStringLiteral("high") : QString::number(scaleBucket(scale)));
+}
+
+static bool cachedRaster(const QString& key, QImage& image, QSizeF* size)
+{
+    QMutexLocker locker(&rasterMutex);
+    const RasterEntry* entry = rasterCache.object(key);
+    if (!entry)
+        return false;
+
+    image = entry->image;
+    if (size)
+        *size = entry->size;
+    return true;
+}
+
+static void storeRaster(const QString& key, const QImage& image, const QSizeF& size)
+{
+    if (image.isNull())
+        return;
+
+    QMutexLocker locker(&rasterMutex);
+    rasterCache.insert(key, new RasterEntry{image, size}, qMax(1, image.bytesPerLine() * image.height() / 1024));
+}
+
 class Cantor::RendererPrivate{
   public:
     double scale{1};
@@ -75,7 +200,8 @@ QTextImageFormat Renderer::render(QTextDocument *document, Method method, const
 
 QTextImageFormat Renderer::render(QTextDocument *document, const Cantor::LatexRenderer* latex)
 {
-    QTextImageFormat format = render(document, Method::EPS, QUrl::fromLocalFile(latex->imagePath()), latex->uuid());
+    const QUrl& url = latex->imageUrl();
+    QTextImageFormat format = render(document, methodForUrl(url), url, latex->uuid());
 
     if (!format.name().isEmpty()) {
         format.setProperty(CantorFormula, latex->method());
@@ -99,6 +225,16 @@ QSizeF Renderer::renderToResource(QTextDocument *document, Method method, const
 QImage Renderer::epsRenderToImage(const QUrl& url, double scale, bool useHighRes, QSizeF* size, QString* errorReason)
 {
 #ifdef LIBSPECTRE_FOUND
+    if (!useHighRes)
+        scale = scaleBucket(scale);
+
+    const QString& key = rasterKey(url, scale, useHighRes);
+    QImage cached;
+    if (cachedRaster(key, cached, size))
+        return cached;
+
+    QMutexLocker locker(&spectreMutex);
+
     SpectreDocument* doc = spectre_document_new();
     SpectreRenderContext* rc = spectre_render_context_new();
 
@@ -111,6 +247,8 @@ QImage Renderer::epsRenderToImage(const QUrl& url, double scale, bool useHighRes
     {
         if (errorReason)
             *errorReason = QString::fromLatin1("Error: spectre document is not eps! It means, that url is invalid");
+        spectre_document_free(doc);
+        spectre_render_context_free(rc);
         return QImage();
     }
 
@@ -142,6 +280,8 @@ QImage Renderer::epsRenderToImage(const QUrl& url, double scale, bool useHighRes
     spectre_render_context_free(rc);
     img = img.convertToFormat(QImage::Format_ARGB32);
 
+    storeRaster(key, img, QSizeF(w, h));
+
     if (size)
         *size = QSizeF(w,h);
     return img;
@@ -157,24 +297,55 @@ QImage Renderer::epsRenderToImage(const QUrl& url, double scale, bool useHighRes
 #endif
 }
 
+static int pdfPageIndex(const QUrl& url)
+{
+    const QString& fragment = url.fragment();
+    if (fragment.startsWith(QLatin1String("page=")))
+        return qMax(0, fragment.mid(5).toInt() - 1);
+
+    return 0;
+}
+
+// the pages are kept with the document, the entry's mutex has to be locked
+static Poppler::Page* documentPage(PopplerDocumentEntry* document, int pageIndex)
+{
+    Poppler::Page* pdfPage = document->pages.value(pageIndex);
+    if (pdfPage == nullptr)
+    {
+        pdfPage = document->document->page(pageIndex);
+        if (pdfPage != nullptr)
+            document->pages.insert(pageIndex, pdfPage);
+    }
+    return pdfPage;
+}
+
 QImage Renderer::pdfRenderToImage(const QUrl& url, double scale, bool highResolution, QSizeF* size, QString* errorReason)
 {
-    popplerMutex.lock();
-    Poppler::Document* document = Poppler::Document::load(url.toLocalFile());
-    popplerMutex.unlock();
-    if (document == nullptr)
+    if (!highResolution)
+        scale = scaleBucket(scale);
+
+    const QString& key = rasterKey(url, scale, highResolution);
+    QImage cached;
+    if (cachedRaster(key, cached, size))
+        return cached;
+
+    const QSharedPointer<PopplerDocumentEntry>& document = popplerDocument(url.toLocalFile());
+    if (!document)
     {
         if (errorReason)
-            *errorReason = QString::fromLatin1("Poppler library have failed to open file % as pdf").arg(url.toLocalFile());
+            *errorReason = QString::fromLatin1("Poppler library have failed to open file %1 as pdf").arg(url.toLocalFile());
         return QImage();
     }
 
-    Poppler::Page* pdfPage = document->page(0);
-    if (pdfPage == nullptr) {
+    QMutexLocker locker(&document->mutex);
+
+    const int pageIndex = pdfPageIndex(url);
+    Poppler::Page* pdfPage = documentPage(document.data(), pageIndex);
+    if (pdfPage == nullptr)
+    {
         if (errorReason)
-            *errorReason = QString::fromLatin1("Poppler library failed to access first page of %1 document").arg(url.toLocalFile());
+            *errorReason = QString::fromLatin1("Poppler library failed to access page %1 of %2 document").arg(pageIndex + 1).arg(url.toLocalFile());
 
-        delete document;
         return QImage();
     }
 
@@ -190,11 +361,7 @@ QImage Renderer::pdfRenderToImage(const QUrl& url, double scale, bool highResolu
 
 
     QImage image = pdfPage->renderToImage(72.0*realScale, 72.0*realScale);
-
-    delete pdfPage;
-    popplerMutex.lock();
-    delete document;
-    popplerMutex.unlock();
+    locker.unlock();
 
     if (image.isNull())
     {
@@ -207,6 +374,8 @@ QImage Renderer::pdfRenderToImage(const QUrl& url, double scale, bool highResolu
     // Resize with smooth transformation for more beautiful result
     image = image.convertToFormat(QImage::Format_ARGB32).scaled(image.size()/1.8, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
 
+    storeRaster(key, image, QSizeF(w, h));
+
     if (size)
         *size = QSizeF(w, h);
     return image;
@@ -227,3 +396,123 @@ QImage Renderer::renderToImage(const QUrl& url, Method method, QSizeF* size)
             return QImage();
     }
 }
+
+QImage Renderer::fileRenderToImage(const QUrl& url, double scale, bool useHighRes, QSizeF* size, QString* errorReason)
+{
+    switch(methodForUrl(url))
+    {
+        case Method::PDF:
+            return pdfRenderToImage(url, scale, useHighRes, size, errorReason);
+
+        case Method::EPS:
+        default:
+            return epsRenderToImage(url, scale, useHighRes, size, errorReason);
+    }
+}
+
+Renderer::Method Renderer::methodForUrl(const QUrl& url)
+{
+    if (url.fileName().endsWith(QLatin1String(".pdf"), Qt::CaseInsensitive))
+        return Method::PDF;
+
+    return Method::EPS;
+}
+
+int Renderer::pdfPageCount(const QUrl& url)
+{
+    const QSharedPointer<PopplerDocumentEntry>& document = popplerDocument(url.toLocalFile());
+    if (!document)
+        return 0;
+
+    QMutexLocker locker(&document->mutex);
+    return document->document->numPages();
+}
+
+QSizeF Renderer::pdfPageSize(const QUrl& url)
+{
+    const QSharedPointer<PopplerDocumentEntry>& document = popplerDocument(url.toLocalFile());
+    if (!document)
+        return QSizeF();
+
+    QMutexLocker locker(&document->mutex);
+    Poppler::Page* pdfPage = documentPage(document.data(), pdfPageIndex(url));
+    return pdfPage ? pdfPage->pageSizeF() : QSizeF();
+}
+
+QImage Renderer::pdfRenderToSize(const QUrl& url, const QSize& size)
+{
+    const QSharedPointer<PopplerDocumentEntry>& document = popplerDocument(url.toLocalFile());
+    if (!document)
+    {
+        qDebug()<< "Failed to process the PDF file " << url.toLocalFile();
+        return QImage();
+    }
+
+    QMutexLocker locker(&document->mutex);
+
+    Poppler::Page* pdfPage = documentPage(document.data(), pdfPageIndex(url));
+    if (pdfPage == nullptr)
+    {
+        qDebug() << "Failed to process the page" << pdfPageIndex(url) + 1 << "in the PDF file.";
+        return QImage();
+    }
+
+    // the hints are restored for the other renderings of the shared document
+    const Poppler::Document::RenderHints hints = document->document->renderHints();
+    document->document->setRenderHint(Poppler::Document::TextAntialiasing);
+    document->document->setRenderHint(Poppler::Document::Antialiasing);
+    document->document->setRenderHint(Poppler::Document::TextHinting);
+    document->document->setRenderHint(Poppler::Document::TextSlightHinting);
+    document->document->setRenderHint(Poppler::Document::ThinLineSolid);
+
+    const QSizeF& pageSize = pdfPage->pageSizeF();
+    const QImage& image = pdfPage->renderToImage(72.0 * size.width() / pageSize.width(), 72.0 * size.height() / pageSize.height());
+    document->document->setRenderHints(hints);
+
+    return image;
+}
+
+bool Renderer::extractPdfPage(const QUrl& url, const QString& fileName)
+{
+    const QSharedPointer<PopplerDocumentEntry>& document = popplerDocument(url.toLocalFile());
+    if (!document)
+        return false;
+
+    QMutexLocker locker(&document->mutex);
+
+    Poppler::Page* pdfPage = documentPage(document.data(), pdfPageIndex(url));
+    if (pdfPage == nullptr)
+        return false;
+
+    // one point per device pixel, so the page is painted with its own size in points
+    QPdfWriter writer(fileName);
+    writer.setResolution(72);
+    writer.setPageSize(QPageSize(pdfPage->pageSizeF(), QPageSize::Point));
+    writer.setPageMargins(QMarginsF());
+
+    QPainter painter;
+    if (!painter.begin(&writer))
+        return false;
+
+    // only the QPainter backend keeps the page as vector graphics,
+    // the document is shared with the rasterization which uses the Splash backend
+    document->document->setRenderBackend(Poppler::Document::ArthurBackend);
+    const bool rendered = pdfPage->renderToPainter(&painter, 72.0, 72.0);
+    document->document->setRenderBackend(Poppler::Document::SplashBackend);
+    painter.end();
+
+    if (!rendered)
+        QFile::remove(fileName);
+    return rendered;
+}
+
+void Renderer::clearCache()
+{
+    QList<QSharedPointer<PopplerDocumentEntry>> documents;
+    popplerMutex.lock();
+    documents.swap(documentCache);
+    popplerMutex.unlock();
+
+    QMutexLocker locker(&rasterMutex);
+    rasterCache.clear();
+}
@@ -41,7 +41,38 @@ class CANTOR_EXPORT Renderer
 
     QImage renderToImage(const QUrl& url, Method method, QSizeF* size = nullptr);
     static QImage epsRenderToImage(const QUrl& url, double scale, bool useHighRes, QSizeF* size = nullptr, QString* errorReason = nullptr);
+    /**
+     * Renders the first page of the pdf file or the page specified by "#page=N" fragment of @p url.
+     */
     static QImage pdfRenderToImage(const QUrl& url, double scale, bool useHighRes, QSizeF* size = nullptr, QString* errorReason = nullptr);
+    /**
+     * Renders the file with the method matching the file type, @see methodForUrl()
+     */
+    static QImage fileRenderToImage(const QUrl& url, double scale, bool useHighRes, QSizeF* size = nullptr, QString* errorReason = nullptr);
+
+    static Method methodForUrl(const QUrl& url);
+    static int pdfPageCount(const QUrl& url);
+    /**
+     * Size in points of the page specified by the "#page=N" fragment of @p url, the first page by default.
+     */
+    static QSizeF pdfPageSize(const QUrl& url);
+    /**
+     * Renders the page specified by the "#page=N" fragment of @p url, the first page by default,
+     * stretched to @p size pixels. The document is shared with the other renderings of the file.
+     */
+    static QImage pdfRenderToSize(const QUrl& url, const QSize& size);
+    /**
+     * Writes the page specified by the "#page=N" fragment of @p url as a single page pdf file.
+     * Returns false if the page couldn't be extracted.
+     */
+    static bool extractPdfPage(const QUrl& url, const QString& fileName);
+
+    /**
+     * The loaded pdf documents and the rasterized images are cached, so that rendering
+     * the same file again, e.g. on zoom changes, doesn't reparse or rerasterize it.
+     * The cache entries are invalidated when the file is modified. This function drops all of them.
+     */
+    static void clearCache();
 
   private:
     RendererPrivate* d;
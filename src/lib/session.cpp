@@ -7,18 +7,23 @@
 #include "session.h"
 using namespace Cantor;
 
-#include <map>
+#include <memory>
 
 #include "backend.h"
 #include "textresult.h"
+#include "typesettingqueue.h"
 
+#include <QDateTime>
 #include <QDebug>
-#include <QEventLoop>
+#include <QHash>
+#include <QPointer>
 #include <QQueue>
 #include <QTimer>
 
+#include <KConfigGroup>
 #include <KMessageBox>
 #include <KLocalizedString>
+#include <KSharedConfig>
 
 class Cantor::SessionPrivate
 {
@@ -34,7 +39,19 @@ class Cantor::SessionPrivate
     QList<GraphicPackage> usableGraphicPackages;
     QList<GraphicPackage> enabledGraphicPackages;
     QList<QString> ignorableGraphicPackageIds;
+    QList<GraphicPackage> requestedGraphicPackages; // packages of the running updateEnabledGraphicPackages()
+    QString graphicPackagesAdditionalInfo;
+    bool graphicPackagesUpdatePending{false};
+    int graphicPackagesProbe{0}; // number of the last test, the results of older tests are not reported
     bool needUpdate{false};
+    TypesettingQueue* typesettingQueue{nullptr};
+    int pipelineCount{0};
+    int currentPipeline{0};
+    bool pipelining{false};
+    QHash<Cantor::Expression*, int> pipelines;
+    bool holdingExpressions{false};
+    // enqueued while the backend was starting or the graphic packages were tested
+    QList<QPointer<Cantor::Expression>> heldExpressions;
 };
 
 Session::Session(Backend* backend ) : QObject(backend), d(new SessionPrivate)
@@ -63,51 +80,195 @@ Session::~Session()
     delete d;
 }
 
+// prefix of the labels separating the outputs of the presence commands in the batched test
+static const QLatin1String probeLabel("__cantor_graphic_package__:");
+
+// the missing packages might be installed meanwhile, they are tested again after this time
+static const qint64 missingGraphicPackagesExpiry = 24 * 60 * 60;
+
+// packages found available or missing before, "Interpreter=<interpreter id>", "Available=<package ids>",
+// "Missing=<package ids>" and "MissingTime=<time of the test>" per backend
+static KConfigGroup graphicPackagesCache(const Backend* backend)
+{
+    return KConfigGroup(KSharedConfig::openConfig(), QLatin1String("GraphicPackages")).group(backend->id());
+}
+
 void Cantor::Session::testGraphicsPackages(QList<GraphicPackage> packages)
 {
-    std::map<QString, bool> handlingStatus;
+    const int probe = ++d->graphicPackagesProbe;
+
+    QStringList cached;
+    QStringList missing;
+    const QString& interpreter = interpreterId();
+    if (!interpreter.isEmpty())
+    {
+        const KConfigGroup& group = graphicPackagesCache(d->backend);
+        if (group.readEntry("Interpreter", QString()) == interpreter)
+        {
+            cached = group.readEntry("Available", QStringList());
+            if (group.readEntry("MissingTime", QDateTime()).secsTo(QDateTime::currentDateTime()) < missingGraphicPackagesExpiry)
+                missing = group.readEntry("Missing", QStringList());
+        }
+    }
 
-    QEventLoop loop;
-    for (GraphicPackage& package : packages)
+    QMap<QString, bool> availability;
+    QList<GraphicPackage> untested;
+    for (const GraphicPackage& package : packages)
     {
         if (GraphicPackage::findById(package, d->usableGraphicPackages) != -1)
-            continue;
+            availability[package.id()] = true;
+        else if (cached.contains(package.id()))
+        {
+            d->usableGraphicPackages.append(package);
+            availability[package.id()] = true;
+        }
+        else if (missing.contains(package.id()))
+            availability[package.id()] = false;
+        else
+            untested.append(package);
+    }
 
-        handlingStatus[package.id()] = false;
-        Expression* expr = package.isAvailable(this);
+    if (untested.isEmpty())
+    {
+        finishGraphicPackagesTest(probe, availability);
+        return;
+    }
 
-        connect(expr, &Expression::expressionFinished, [this, expr, &package, &loop, &handlingStatus](Expression::Status status) {
+    QString script;
+    for (const GraphicPackage& package : untested)
+    {
+        const QString& label = graphicPackageProbeLabelCommand(probeLabel + package.id());
+        if (label.isEmpty())
+        {
+            script.clear();
+            break;
+        }
+        script += label + QLatin1Char('\n') + package.testPresenceCommand() + QLatin1Char('\n');
+    }
+
+    if (!script.isEmpty())
+    {
+        Expression* expr = evaluateExpression(script, Expression::DoNotDelete, true);
+        connect(expr, &Expression::expressionFinished, this, [this, expr, probe, untested, availability](Expression::Status status) mutable {
+            if (status != Expression::Done)
+            {
+                qDebug() << "test presence command for graphic packages finished because of" << (status == Expression::Error ? "error" : "interrupt");
+                if (status == Expression::Error)
+                    qDebug() << "error message:" << expr->errorMessage();
+            }
+
+            QString output;
+            for (auto* result : expr->results())
+                if (result->type() == TextResult::Type)
+                    output += result->data().toString() + QLatin1Char('\n');
+
+            // the output of each presence command follows the label of its package,
+            // the packages without output, e.g. after an error, are not available
+            QMap<QString, bool> found;
+            const QStringList& parts = output.split(probeLabel);
+            for (int i = 1; i < parts.size(); ++i)
+            {
+                const QString& part = parts.at(i);
+                const int end = part.indexOf(QLatin1Char('\n'));
+                if (end != -1)
+                    found[part.left(end).trimmed()] = part.mid(end + 1).trimmed() == QLatin1String("1");
+            }
+
+            for (const GraphicPackage& package : untested)
+            {
+                const bool available = found.value(package.id(), false);
+                if (available && GraphicPackage::findById(package, d->usableGraphicPackages) == -1)
+                    d->usableGraphicPackages.append(package);
+                availability[package.id()] = available;
+            }
+
+            // the packages are only known to be missing if the test was not stopped before
+            expr->deleteLater();
+            finishGraphicPackagesTest(probe, availability, status == Expression::Done);
+        });
+        return;
+    }
+
+    // no batching possible, all the presence commands are queued at once and the results are collected
+    auto remaining = std::make_shared<int>(untested.size());
+    auto results = std::make_shared<QMap<QString, bool>>(availability);
+    auto complete = std::make_shared<bool>(true);
+    for (const GraphicPackage& package : untested)
+    {
+        Expression* expr = package.isAvailable(this);
+        connect(expr, &Expression::expressionFinished, this, [this, expr, package, probe, remaining, results, complete](Expression::Status status) {
+            bool available = false;
             if (status == Expression::Status::Done) {
-                if (expr->result() != nullptr
+                available = expr->result() != nullptr
                     && expr->result()->type() == TextResult::Type
-                    && expr->result()->data().toString() == QLatin1String("1")) {
-                    this->d->usableGraphicPackages.push_back(package);
-                }
+                    && expr->result()->data().toString() == QLatin1String("1");
             } else {
+                *complete = false;
                 qDebug() << "test presence command for" << package.id() << "finished because of" << (status == Expression::Error ? "error" : "interrupt");
-                if (status == Expression::Error && expr)
+                if (status == Expression::Error)
                     qDebug() << "error message:" << expr->errorMessage();
             }
 
-            handlingStatus[package.id()] = true;
+            if (available && GraphicPackage::findById(package, d->usableGraphicPackages) == -1)
+                d->usableGraphicPackages.append(package);
+            (*results)[package.id()] = available;
 
-            bool allExpersionsFinished = true;
-            for (auto& iter : handlingStatus)
+            expr->deleteLater();
+            if (--(*remaining) == 0)
+                finishGraphicPackagesTest(probe, *results, *complete);
+        });
+    }
+}
+
+void Cantor::Session::finishGraphicPackagesTest(int probe, const QMap<QString, bool>& availability, bool cacheMissing)
+{
+    const QString& interpreter = interpreterId();
+    if (!interpreter.isEmpty())
+    {
+        QStringList available;
+        for (const GraphicPackage& package : qAsConst(d->usableGraphicPackages))
+            available << package.id();
+
+        KConfigGroup group = graphicPackagesCache(d->backend);
+        QStringList missing;
+        if (group.readEntry("Interpreter", QString()) == interpreter)
+            missing = group.readEntry("Missing", QStringList());
+
+        // the time of the first found missing package is kept, so they are all tested again after the expiry
+        bool foundMissing = false;
+        for (auto it = availability.constBegin(); cacheMissing && it != availability.constEnd(); ++it)
+            if (!it.value() && !missing.contains(it.key()))
             {
-                if (iter.second == false)
-                {
-                    allExpersionsFinished = false;
-                    break;
-                }
+                missing << it.key();
+                foundMissing = true;
             }
+        for (const QString& id : qAsConst(available))
+            missing.removeAll(id);
+
+        group.writeEntry("Interpreter", interpreter);
+        group.writeEntry("Available", available);
+        group.writeEntry("Missing", missing);
+        if (missing.isEmpty())
+            group.deleteEntry("MissingTime");
+        else if (foundMissing && !group.hasKey("MissingTime"))
+            group.writeEntry("MissingTime", QDateTime::currentDateTime());
+        group.sync();
+    }
 
-            if (allExpersionsFinished)
-                loop.exit();
-        });
+    // superseded by a later test
+    if (probe != d->graphicPackagesProbe)
+        return;
+
+    if (d->graphicPackagesUpdatePending)
+    {
+        d->graphicPackagesUpdatePending = false;
+        applyGraphicPackages(availability);
+
+        // the commands enabling the packages are enqueued, the held expressions of the user follow them
+        enqueueHeldExpressions();
     }
-    // If handlingStatus size is empty (it means, that no connections have been done), then we will stay in the 'loop' event loop forever
-    if (handlingStatus.size() != 0)
-        loop.exec();
+
+    emit graphicPackagesTested(availability);
 }
 
 void Session::logout()
@@ -122,6 +283,12 @@ void Session::logout()
     }
 
     d->expressionCount = 0;
+    d->holdingExpressions = false;
+    d->graphicPackagesUpdatePending = false;
+    for (auto& expr : d->heldExpressions)
+        if (expr)
+            expr->setStatus(Expression::Interrupted);
+    d->heldExpressions.clear();
     changeStatus(Status::Disable);
 
     // Clean graphic package state
@@ -137,8 +304,25 @@ QList<Expression*>& Cantor::Session::expressionQueue() const
 
 void Session::enqueueExpression(Expression* expr)
 {
+    expr->markTime(Expression::QueuedTime);
     d->expressionQueue.append(expr);
 
+    // interrupted expressions are removed from the queue without being finished, don't
+    // keep their pipeline for a new expression allocated at the same address
+    d->pipelines.remove(expr);
+    if (d->currentPipeline != 0 && !expr->isInternal())
+        d->pipelines.insert(expr, d->currentPipeline);
+
+    // the backend is still starting, the expression is enqueued after its initialization,
+    // or the graphic packages are tested, the expressions of the user are enqueued after enabling them
+    if (d->holdingExpressions || (d->graphicPackagesUpdatePending && !expr->isInternal()))
+    {
+        d->expressionQueue.removeOne(expr);
+        d->heldExpressions.append(expr);
+        expr->setStatus(Cantor::Expression::Queued);
+        return;
+    }
+
     //run the newly added expression immediately if it's the only one in the queue
     if (d->expressionQueue.size() == 1)
     {
@@ -146,7 +330,34 @@ void Session::enqueueExpression(Expression* expr)
         runFirstExpression();
     }
     else
+    {
         expr->setStatus(Cantor::Expression::Queued);
+
+        // don't wait for the previous expressions of the pipeline if the backend can handle it
+        if (d->pipelining && pipeline(expr) != 0 && pipeline(d->expressionQueue.first()) == pipeline(expr))
+            runPipelinedExpressions();
+    }
+}
+
+void Session::beginPipeline()
+{
+    d->currentPipeline = ++d->pipelineCount;
+    d->pipelining = supportsPipelining();
+}
+
+void Session::endPipeline()
+{
+    d->currentPipeline = 0;
+}
+
+bool Session::supportsPipelining() const
+{
+    return d->backend->capabilities().testFlag(Backend::PipelinedEvaluation);
+}
+
+int Session::pipeline(Expression* expression) const
+{
+    return d->pipelines.value(expression, 0);
 }
 
 void Session::runFirstExpression()
@@ -154,12 +365,35 @@ void Session::runFirstExpression()
 
 }
 
+void Session::runPipelinedExpressions()
+{
+
+}
+
 void Session::finishFirstExpression(bool setDoneAfterUpdate)
 {
     if (!d->expressionQueue.isEmpty())
     {
         auto first = d->expressionQueue.takeFirst();
         d->needUpdate |= !first->isInternal() && !first->isHelpRequest();
+
+        // the following expressions of a failed pipeline depend on it and are not evaluated anymore
+        const int firstPipeline = d->pipelines.take(first);
+        if (firstPipeline != 0 && first->status() == Expression::Error)
+        {
+            for (auto it = d->expressionQueue.begin(); it != d->expressionQueue.end();)
+            {
+                if (d->pipelines.value(*it) == firstPipeline)
+                {
+                    auto* skipped = *it;
+                    d->pipelines.remove(skipped);
+                    it = d->expressionQueue.erase(it);
+                    skipped->setStatus(Expression::Interrupted);
+                }
+                else
+                    ++it;
+            }
+        }
     }
 
     if (d->expressionQueue.isEmpty())
@@ -227,6 +461,14 @@ bool Session::isTypesettingEnabled()
     return d->typesettingEnabled;
 }
 
+TypesettingQueue* Session::typesettingQueue()
+{
+    if (!d->typesettingQueue)
+        d->typesettingQueue = new TypesettingQueue(this);
+
+    return d->typesettingQueue;
+}
+
 void Session::setWorksheetPath(const QString&) { }
 
 CompletionObject* Session::completionFor(const QString&, int)
@@ -336,6 +578,12 @@ void Cantor::Session::updateEnabledGraphicPackages(const QList<Cantor::GraphicPa
 {
     if (newEnabledPackages.isEmpty())
     {
+        // drop the result of a running test
+        ++d->graphicPackagesProbe;
+        d->graphicPackagesUpdatePending = false;
+        d->requestedGraphicPackages.clear();
+        enqueueHeldExpressions();
+
         if (!d->enabledGraphicPackages.isEmpty())
         {
             for (const GraphicPackage& package : d->enabledGraphicPackages)
@@ -350,41 +598,106 @@ void Cantor::Session::updateEnabledGraphicPackages(const QList<Cantor::GraphicPa
             if (d->ignorableGraphicPackageIds.contains(package.id()) == false)
                 packagesExceptIgnored.append(package);
 
+        // the packages are enabled in applyGraphicPackages() when the test is finished,
+        // the expressions of the user are held back until then, so they already use the packages
+        d->requestedGraphicPackages = packagesExceptIgnored;
+        d->graphicPackagesAdditionalInfo = additionalInfo;
+        d->graphicPackagesUpdatePending = true;
         testGraphicsPackages(packagesExceptIgnored);
+    }
+}
+
+void Cantor::Session::applyGraphicPackages(const QMap<QString, bool>& availability)
+{
+    if (d->status == Session::Disable)
+        return;
+
+    QList<GraphicPackage> unavailablePackages;
+    QList<GraphicPackage> willEnabledPackages;
+
+    for (const GraphicPackage& package : d->requestedGraphicPackages)
+    {
+        if (availability.value(package.id(), false))
+            willEnabledPackages.append(package);
+        else
+            unavailablePackages.append(package);
+    }
+
+    for (const GraphicPackage& package : d->enabledGraphicPackages)
+        if (GraphicPackage::findById(package, willEnabledPackages) == -1)
+            evaluateExpression(package.disableSupportCommand(), Cantor::Expression::DeleteOnFinish, true);
 
-        QList<GraphicPackage> unavailablePackages;
-        QList<GraphicPackage> willEnabledPackages;
+    for (const GraphicPackage& newPackage : willEnabledPackages)
+        if (GraphicPackage::findById(newPackage, d->enabledGraphicPackages) == -1)
+            evaluateExpression(newPackage.enableSupportCommand(d->graphicPackagesAdditionalInfo), Cantor::Expression::DeleteOnFinish, true);
 
-        for (const GraphicPackage& package : packagesExceptIgnored)
+    d->enabledGraphicPackages = willEnabledPackages;
+
+    for (const Cantor::GraphicPackage& notEnabledPackage : unavailablePackages)
+    {
+        if (d->ignorableGraphicPackageIds.contains(notEnabledPackage.id()) == false)
         {
-            if (GraphicPackage::findById(package, usableGraphicPackages()) != -1)
-                willEnabledPackages.append(package);
-            else
-                unavailablePackages.append(package);
+            KMessageBox::information(nullptr, i18n(
+                "You choose support for %1 graphic package, but the support can't be "\
+                "activated due to the missing requirements, so integration for this package will be disabled. %2",
+                notEnabledPackage.name(), graphicPackageErrorMessage(notEnabledPackage.id())), i18n("Cantor")
+            );
+
+            d->ignorableGraphicPackageIds.append(notEnabledPackage.id());
         }
+    }
+}
 
-        for (const GraphicPackage& package : d->enabledGraphicPackages)
-            if (GraphicPackage::findById(package, willEnabledPackages) == -1)
-                evaluateExpression(package.disableSupportCommand(), Cantor::Expression::DeleteOnFinish, true);
+QString Cantor::Session::graphicPackageProbeLabelCommand(const QString& label) const
+{
+    Q_UNUSED(label);
+    return QString();
+}
+
+QString Cantor::Session::interpreterId() const
+{
+    return QString();
+}
+
+void Session::holdExpressions()
+{
+    d->holdingExpressions = true;
+}
 
-        for (const GraphicPackage& newPackage : willEnabledPackages)
-            if (GraphicPackage::findById(newPackage, d->enabledGraphicPackages) == -1)
-                evaluateExpression(newPackage.enableSupportCommand(additionalInfo), Cantor::Expression::DeleteOnFinish, true);
+bool Session::isHoldingExpressions() const
+{
+    return d->holdingExpressions;
+}
 
-        d->enabledGraphicPackages = willEnabledPackages;
+void Session::releaseExpressions()
+{
+    if (!d->holdingExpressions)
+        return;
 
-        for (const Cantor::GraphicPackage& notEnabledPackage : unavailablePackages)
-        {
-            if (d->ignorableGraphicPackageIds.contains(notEnabledPackage.id()) == false)
-            {
-                KMessageBox::information(nullptr, i18n(
-                    "You choose support for %1 graphic package, but the support can't be "\
-                    "activated due to the missing requirements, so integration for this package will be disabled. %2",
-                    notEnabledPackage.name(), graphicPackageErrorMessage(notEnabledPackage.id())), i18n("Cantor")
-                );
+    d->holdingExpressions = false;
+    QTimer::singleShot(0, this, &Session::enqueueHeldExpressions);
+}
 
-                d->ignorableGraphicPackageIds.append(notEnabledPackage.id());
-            }
+void Session::enqueueHeldExpressions()
+{
+    if (d->holdingExpressions || d->graphicPackagesUpdatePending)
+        return;
+
+    const auto held = d->heldExpressions;
+    d->heldExpressions.clear();
+    for (const auto& expr : held)
+    {
+        // skip the expressions interrupted or deleted meanwhile
+        if (!expr || expr->status() != Expression::Queued)
+            continue;
+
+        d->expressionQueue.append(expr);
+        if (d->expressionQueue.size() == 1)
+        {
+            changeStatus(Cantor::Session::Running);
+            runFirstExpression();
         }
+        else if (d->pipelining && pipeline(expr) != 0 && pipeline(d->expressionQueue.first()) == pipeline(expr))
+            runPipelinedExpressions();
     }
 }
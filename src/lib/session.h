@@ -7,6 +7,7 @@
 #define _SESSION_H
 
 #include <QObject>
+#include <QMap>
 #include <QStandardPaths>
 
 #include "cantor_export.h"
@@ -29,6 +30,7 @@ class SessionPrivate;
 class CompletionObject;
 class SyntaxHelpObject;
 class DefaultVariableModel;
+class TypesettingQueue;
 
 /**
  * The Session object is the main class used to interact with a Backend.
@@ -81,7 +83,11 @@ class CANTOR_EXPORT Session : public QObject
     /**
     * This method run precense test for available graphic packages. The packages, which will sucessfuly pass the test
     * will go to @c usableGraphicPackages list
-    * @param targetPackage If set, precense test will run only for this package. If empty string, then all available packages will be tested
+    *
+    * The test is asynchronous, graphicPackagesTested() is emitted with the result. The presence commands of all packages
+    * are sent in one expression, if the backend provides graphicPackageProbeLabelCommand(), and the packages found
+    * available are cached for the interpreter returned by interpreterId(), so they are not tested again in later sessions.
+    * @param packages the packages to test
     */
     void testGraphicsPackages(QList<GraphicPackage> packages);
 
@@ -103,6 +109,23 @@ class CANTOR_EXPORT Session : public QObject
      */
     void enqueueExpression(Expression*);
 
+    /**
+     * The expressions enqueued between beginPipeline() and endPipeline() form a pipeline.
+     * If the backend supports pipelined evaluation, the expressions of a pipeline are sent to
+     * the backend without waiting for the results of the previous ones. If an expression
+     * of the pipeline fails, the following expressions of it are not evaluated and
+     * get the status Expression::Interrupted.
+     * @see supportsPipelining()
+     */
+    void beginPipeline();
+    void endPipeline();
+
+    /**
+     * Returns true if the backend of this session accepts further expressions
+     * while the previous ones are still running
+     */
+    bool supportsPipelining() const;
+
     /**
      * Interrupts all the running calculations in this session
      * After this function expression queue must be clean
@@ -161,6 +184,13 @@ class CANTOR_EXPORT Session : public QObject
      */
     virtual void setTypesettingEnabled(bool);
 
+    /**
+     * Returns the queue used for typesetting the LaTeX results of the expressions of this session.
+     * The queue is created on the first call.
+     * @see TypesettingQueue
+     */
+    TypesettingQueue* typesettingQueue();
+
     /**
     * Updates the worksheet path in the session.
     * This can be useful to set the path of the currently opened
@@ -236,6 +266,18 @@ public Q_SLOTS:
      */
     virtual void finishFirstExpression(bool setDoneAfterUpdate = false);
 
+    /**
+     * Returns the pipeline @p expression was enqueued in, 0 if it is not part of a pipeline
+     * @see beginPipeline()
+     */
+    int pipeline(Expression* expression) const;
+
+    /**
+     * Called when expressions of the pipeline of the first expression were enqueued while
+     * it is running. Backends supporting pipelined evaluation send them to the backend here.
+     */
+    virtual void runPipelinedExpressions();
+
     /**
      * Starts variable update immedeatly, useful for subclasses, which run internal command
      * which could change variables listen
@@ -261,11 +303,33 @@ public Q_SLOTS:
      */
     void reportSessionCrash(const QString& additionalInfo = QString());
 
+    /**
+     * Backends starting their process asynchronously call this at the beginning of login().
+     * The expressions enqueued until releaseExpressions() are not run but held back,
+     * so they are not sent to the backend before it's ready.
+     */
+    void holdExpressions();
+
+    /**
+     * Called when the backend is ready, right before it enqueues the expressions of its initialization.
+     * The held expressions are enqueued when the control returns to the event loop, i.e. after them.
+     */
+    void releaseExpressions();
+
+    /**
+     * True from holdExpressions() until releaseExpressions(), i.e. while the backend is starting
+     */
+    bool isHoldingExpressions() const;
+
     /**
      * Contains list of usable (which available and can be enabled in current session) graphic packages
      */
     QList<GraphicPackage> usableGraphicPackages();
 
+    /**
+     * Enables the integration of the available packages from @p newEnabledPackages and disables the other ones.
+     * The packages are tested with testGraphicsPackages() first, so the change is applied asynchronously.
+     */
     void updateEnabledGraphicPackages(const QList<GraphicPackage>& newEnabledPackages, const QString& additionalInfo = QString());
 
     /**
@@ -278,11 +342,35 @@ public Q_SLOTS:
      */
     virtual QString graphicPackageErrorMessage(QString packageId) const;
 
+    /**
+     * Returns the backend code printing @p label on a line of its own. The code is put in front of the presence
+     * command of each package, so all packages can be tested in one expression and the output can be assigned
+     * to the packages afterwards.
+     * The default implementation returns an empty string, the packages are tested in separate expressions then.
+     */
+    virtual QString graphicPackageProbeLabelCommand(const QString& label) const;
+
+    /**
+     * Identifies the interpreter used by the session, e.g. by the path and the version of its executable.
+     * The results of testGraphicsPackages() are cached for this id, the default implementation returns
+     * an empty string and disables the cache.
+     */
+    virtual QString interpreterId() const;
+
 Q_SIGNALS:
     void statusChanged(Cantor::Session::Status);
     void loginStarted();
     void loginDone();
     void error(const QString&);
+    /**
+     * Emitted by testGraphicsPackages() with the availability of the tested packages, mapped by their ids
+     */
+    void graphicPackagesTested(const QMap<QString, bool>& availability);
+
+  private:
+    void finishGraphicPackagesTest(int probe, const QMap<QString, bool>& availability, bool cacheMissing = true);
+    void applyGraphicPackages(const QMap<QString, bool>& availability);
+    void enqueueHeldExpressions();
 
   private:
     SessionPrivate* d;
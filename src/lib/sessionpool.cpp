@@ -0,0 +1,234 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#include "sessionpool.h"
+using namespace Cantor;
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+
+#include <KConfigSkeleton>
+
+#include "backend.h"
+#include "session.h"
+
+// Maximal number of recently used backends with prepared sessions
+static const int MaxBackends = 3;
+
+SessionPool* SessionPool::instance()
+{
+    static SessionPool* pool = nullptr;
+    if (!pool)
+    {
+        pool = new SessionPool(QCoreApplication::instance());
+        connect(qApp, &QCoreApplication::aboutToQuit, pool, &SessionPool::clear);
+    }
+    return pool;
+}
+
+SessionPool::SessionPool(QObject* parent) : QObject(parent)
+{
+    // The logins are started with a delay and one by one, so the worksheet
+    // which triggered the refill gets the resources for its own startup first
+    m_refillTimer.setSingleShot(true);
+    m_refillTimer.setInterval(2000);
+    connect(&m_refillTimer, &QTimer::timeout, this, &SessionPool::refill);
+}
+
+SessionPool::~SessionPool()
+{
+    clear();
+}
+
+void SessionPool::setSize(int size)
+{
+    if (size == m_size)
+        return;
+
+    m_size = qMax(0, size);
+    if (m_size == 0)
+    {
+        clear();
+        return;
+    }
+
+    for (auto* backend : m_backends)
+    {
+        QList<Session*>& sessions = m_sessions[backend];
+        while (sessions.size() > m_size)
+            discard(sessions.last());
+    }
+    scheduleRefill();
+}
+
+int SessionPool::size() const
+{
+    return m_size;
+}
+
+void SessionPool::setMinimumAvailableMemory(int megabytes)
+{
+    m_minAvailableMemory = qMax(0, megabytes);
+}
+
+int SessionPool::minimumAvailableMemory() const
+{
+    return m_minAvailableMemory;
+}
+
+void SessionPool::addBackend(Backend* backend)
+{
+    if (!backend || m_size == 0 || !backend->isEnabled())
+        return;
+
+    if (!m_backends.removeOne(backend) && backend->config())
+    {
+        // the prepared sessions were logged in with the previous settings of the backend
+        connect(backend->config(), &KCoreConfigSkeleton::configChanged, this, [this, backend]() {
+            for (auto* session : m_sessions.value(backend))
+                discard(session);
+            scheduleRefill();
+        });
+    }
+    m_backends.prepend(backend);
+
+    while (m_backends.size() > MaxBackends)
+    {
+        Backend* dropped = m_backends.takeLast();
+        if (dropped->config())
+            disconnect(dropped->config(), nullptr, this, nullptr);
+        for (auto* session : m_sessions.value(dropped))
+            discard(session);
+        m_sessions.remove(dropped);
+    }
+
+    scheduleRefill();
+}
+
+Session* SessionPool::takeSession(Backend* backend)
+{
+    if (!backend || m_size == 0)
+        return nullptr;
+
+    addBackend(backend);
+
+    QList<Session*>& sessions = m_sessions[backend];
+    for (int i = 0; i < sessions.size(); ++i)
+    {
+        Session* session = sessions.at(i);
+        if (session->status() == Session::Done)
+        {
+            sessions.removeAt(i);
+            disconnect(session, nullptr, this, nullptr);
+            qDebug() << "taking a prepared session of" << backend->id();
+            return session;
+        }
+    }
+
+    return nullptr;
+}
+
+void SessionPool::clear()
+{
+    m_refillTimer.stop();
+
+    for (const auto& sessions : qAsConst(m_sessions))
+        for (auto* session : sessions)
+        {
+            disconnect(session, nullptr, this, nullptr);
+            if (session->status() != Session::Disable)
+                session->logout();
+            delete session;
+        }
+    m_sessions.clear();
+}
+
+qint64 SessionPool::availableMemory()
+{
+    QFile file(QLatin1String("/proc/meminfo"));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return -1;
+
+    // the value is given in kB, e.g. "MemAvailable:    8123456 kB"
+    while (!file.atEnd())
+    {
+        const QByteArray& line = file.readLine();
+        if (line.startsWith("MemAvailable:"))
+        {
+            bool ok;
+            const qint64 kilobytes = line.mid(13).trimmed().split(' ').first().toLongLong(&ok);
+            return ok ? kilobytes * 1024 : -1;
+        }
+    }
+
+    return -1;
+}
+
+void SessionPool::scheduleRefill()
+{
+    if (m_size > 0 && !m_refillTimer.isActive())
+        m_refillTimer.start();
+}
+
+/*!
+ * logs in one session for the most recently used backend missing sessions
+ * and schedules the next login, if further sessions are missing
+ */
+void SessionPool::refill()
+{
+    Backend* backend = nullptr;
+    for (auto* candidate : qAsConst(m_backends))
+        if (m_sessions.value(candidate).size() < m_size)
+        {
+            backend = candidate;
+            break;
+        }
+
+    if (!backend)
+        return;
+
+    const qint64 available = availableMemory();
+    if (available != -1 && available < static_cast<qint64>(m_minAvailableMemory) * 1024 * 1024)
+    {
+        qDebug() << "not enough memory available for preparing a session:" << available / (1024 * 1024) << "MiB";
+        return;
+    }
+
+    qDebug() << "preparing a session of" << backend->id();
+    Session* session = backend->createSession();
+    m_sessions[backend].append(session);
+
+    connect(session, &Session::error, this, [this, session]() {
+        discard(session);
+    });
+    connect(session, &Session::loginDone, this, [this, session]() {
+        // the process of the idle session died
+        connect(session, &Session::statusChanged, this, [this, session](Session::Status status) {
+            if (status == Session::Disable)
+                discard(session);
+        });
+    });
+
+    session->login();
+
+    scheduleRefill();
+}
+
+/*!
+ * removes @p session from the pool and deletes it. The session might be emitting
+ * a signal at this moment, so the deletion is deferred.
+ */
+void SessionPool::discard(Session* session)
+{
+    for (auto it = m_sessions.begin(); it != m_sessions.end(); ++it)
+        if (it.value().removeOne(session))
+            break;
+
+    disconnect(session, nullptr, this, nullptr);
+    if (session->status() != Session::Disable)
+        session->logout();
+    session->deleteLater();
+}
@@ -0,0 +1,92 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#ifndef _SESSIONPOOL_H
+#define _SESSIONPOOL_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QTimer>
+
+#include "cantor_export.h"
+
+namespace Cantor
+{
+class Backend;
+class Session;
+
+/**
+ * Application wide pool of sessions which are logged in in the background.
+ *
+ * The login of a backend starts the interpreter and loads its startup scripts,
+ * which takes up to several seconds. The pool keeps size() logged in sessions
+ * for each of the recently used backends, so that a new or opened worksheet
+ * takes a ready session with takeSession() instead of waiting for the login.
+ *
+ * The pool is refilled in the background, one login at a time, and only as long
+ * as the available memory of the system doesn't drop below minimumAvailableMemory().
+ * The sessions of a backend are logged in again when the settings of the backend change.
+ * The pool is disabled by default, i.e. with the size 0.
+ */
+class CANTOR_EXPORT SessionPool : public QObject
+{
+  Q_OBJECT
+  public:
+    static SessionPool* instance();
+    ~SessionPool() override;
+
+    /**
+     * Number of sessions kept for each backend, 0 disables the pool and discards all sessions
+     */
+    void setSize(int size);
+    int size() const;
+
+    /**
+     * Available memory of the system in MiB below which no new sessions are logged in
+     */
+    void setMinimumAvailableMemory(int megabytes);
+    int minimumAvailableMemory() const;
+
+    /**
+     * Marks @p backend as recently used, its sessions are prepared in the background
+     */
+    void addBackend(Backend* backend);
+
+    /**
+     * Returns a logged in and idle session of @p backend, or nullptr if there is none ready yet.
+     * The caller takes the ownership of the session like for Backend::createSession().
+     */
+    Session* takeSession(Backend* backend);
+
+    /**
+     * Logs out and deletes all the prepared sessions
+     */
+    void clear();
+
+    /**
+     * Currently available memory of the system in bytes or -1 if unknown
+     */
+    static qint64 availableMemory();
+
+  private:
+    explicit SessionPool(QObject* parent = nullptr);
+
+    void scheduleRefill();
+    void refill();
+    void discard(Session* session);
+
+  private:
+    // Backends in the order of their last usage, the most recent first
+    QList<Backend*> m_backends;
+    QHash<Backend*, QList<Session*>> m_sessions;
+    QTimer m_refillTimer;
+    int m_size{0};
+    int m_minAvailableMemory{0};
+};
+
+}
+
+#endif /* _SESSIONPOOL_H */
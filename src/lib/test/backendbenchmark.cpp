@@ -0,0 +1,350 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#include "backendbenchmark.h"
+
+#include "backend.h"
+#include "completionobject.h"
+#include "expression.h"
+#include "session.h"
+#include "../../config-cantor.h"
+
+#include <QApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSignalSpy>
+
+#include <algorithm>
+#include <cmath>
+
+static const int LatencySamples = 200;
+static const int ThroughputExpressions = 1000;
+static const int CompletionSamples = 50;
+static const int LoginSamples = 3;
+static const int Variables = 1000;
+
+BackendBenchmark::BackendBenchmark(const QString& backend) : m_backend(backend)
+{
+}
+
+QString BackendBenchmark::backendName()
+{
+    return m_backend;
+}
+
+QJsonObject BackendBenchmark::results() const
+{
+    return m_results;
+}
+
+BackendBenchmark::Commands BackendBenchmark::commands() const
+{
+    if (m_backend == QLatin1String("python") || m_backend == QLatin1String("sage"))
+        return {QLatin1String("1+1"), QLatin1String("v%1 = %1"), QLatin1String("print('x' * %1)"), QLatin1String("pri")};
+    else if (m_backend == QLatin1String("octave"))
+        return {QLatin1String("1+1"), QLatin1String("v%1 = %1;"), QLatin1String("disp(repmat('x', 1, %1))"), QLatin1String("dis")};
+    else if (m_backend == QLatin1String("julia"))
+        return {QLatin1String("1+1"), QLatin1String("v%1 = %1"), QLatin1String("print(repeat(\"x\", %1))"), QLatin1String("prin")};
+    else if (m_backend == QLatin1String("r"))
+        return {QLatin1String("1+1"), QLatin1String("v%1 <- %1"), QLatin1String("cat(strrep(formatC('', width = %1), ' ', 'x'))"), QLatin1String("pri")};
+    else if (m_backend == QLatin1String("maxima"))
+        return {QLatin1String("1+1;"), QLatin1String("v%1 : %1;"), QString(), QLatin1String("integ")};
+    else if (m_backend == QLatin1String("scilab"))
+        return {QLatin1String("1+1"), QLatin1String("v%1 = %1;"), QLatin1String("disp(strcat(repmat('x', 1, %1)))"), QLatin1String("dis")};
+    else if (m_backend == QLatin1String("lua"))
+        return {QLatin1String("print(1+1)"), QLatin1String("v%1 = %1"), QLatin1String("print(string.rep('x', %1))"), QLatin1String("pri")};
+    else if (m_backend == QLatin1String("kalgebra"))
+        return {QLatin1String("1+1"), QLatin1String("v%1 := %1"), QString(), QString()};
+
+    return {QLatin1String("1+1"), QString(), QString(), QString()};
+}
+
+/*!
+ * waits until @p expression is finished, returns true if it was evaluated successfully
+ */
+bool BackendBenchmark::evaluate(Cantor::Expression* expression)
+{
+    const auto status = expression->status();
+    if (status == Cantor::Expression::Queued || status == Cantor::Expression::Computing)
+        waitForSignal(expression, SIGNAL(expressionFinished(Cantor::Expression::Status)));
+
+    return expression->status() == Cantor::Expression::Done;
+}
+
+/*!
+ * waits until the internal expressions, like the update of the variable model, are finished
+ */
+void BackendBenchmark::waitForIdle()
+{
+    while (session()->status() == Cantor::Session::Running)
+        waitForSignal(session(), SIGNAL(statusChanged(Cantor::Session::Status)));
+}
+
+/*!
+ * returns the median, the 99th percentile, the minimum and the maximum of @p nanoseconds in milliseconds
+ */
+QJsonObject BackendBenchmark::statistics(QVector<qint64> nanoseconds)
+{
+    QJsonObject result;
+    if (nanoseconds.isEmpty())
+        return result;
+
+    std::sort(nanoseconds.begin(), nanoseconds.end());
+    auto percentile = [&nanoseconds](double p) {
+        const int index = qBound(0, static_cast<int>(std::ceil(p * nanoseconds.size())) - 1, nanoseconds.size() - 1);
+        return nanoseconds.at(index) / 1e6;
+    };
+
+    result.insert(QLatin1String("samples"), nanoseconds.size());
+    result.insert(QLatin1String("p50_ms"), percentile(0.5));
+    result.insert(QLatin1String("p99_ms"), percentile(0.99));
+    result.insert(QLatin1String("min_ms"), nanoseconds.first() / 1e6);
+    result.insert(QLatin1String("max_ms"), nanoseconds.last() / 1e6);
+    return result;
+}
+
+void BackendBenchmark::benchmarkLogin()
+{
+    auto* backend = Cantor::Backend::getBackend(m_backend);
+    QVERIFY(backend);
+
+    QVector<qint64> times;
+    for (int i = 0; i < LoginSamples; ++i)
+    {
+        auto* session = backend->createSession();
+        QSignalSpy spy(session, SIGNAL(loginDone()));
+
+        QElapsedTimer timer;
+        timer.start();
+        session->login();
+        if (spy.isEmpty())
+            waitForSignal(session, SIGNAL(loginDone()));
+        times << timer.nsecsElapsed();
+
+        QVERIFY(!spy.isEmpty());
+        session->logout();
+        delete session;
+    }
+
+    m_results.insert(QLatin1String("login"), statistics(times));
+}
+
+void BackendBenchmark::benchmarkLatency()
+{
+    const QString& command = commands().trivial;
+
+    QVector<qint64> times;
+    for (int i = 0; i < LatencySamples; ++i)
+    {
+        // the update of the variable model following the expression isn't measured
+        waitForIdle();
+
+        QElapsedTimer timer;
+        timer.start();
+        auto* expression = session()->evaluateExpression(command);
+        const bool done = evaluate(expression);
+        times << timer.nsecsElapsed();
+        delete expression;
+        QVERIFY(done);
+    }
+
+    m_results.insert(QLatin1String("latency"), statistics(times));
+}
+
+void BackendBenchmark::benchmarkThroughput()
+{
+    const QString& command = commands().trivial;
+    QJsonObject result;
+    result.insert(QLatin1String("expressions"), ThroughputExpressions);
+
+    auto run = [&](bool pipelined) -> double {
+        waitForIdle();
+
+        QElapsedTimer timer;
+        timer.start();
+        if (pipelined)
+            session()->beginPipeline();
+        QVector<Cantor::Expression*> expressions;
+        for (int i = 0; i < ThroughputExpressions; ++i)
+            expressions << session()->evaluateExpression(command);
+        if (pipelined)
+            session()->endPipeline();
+
+        const bool done = evaluate(expressions.last());
+        const qint64 elapsed = timer.nsecsElapsed();
+        qDeleteAll(expressions);
+        return done ? ThroughputExpressions / (elapsed / 1e9) : -1;
+    };
+
+    const double sequential = run(false);
+    QVERIFY(sequential > 0);
+    result.insert(QLatin1String("expressions_per_s"), sequential);
+
+    if (session()->supportsPipelining())
+    {
+        const double pipelined = run(true);
+        QVERIFY(pipelined > 0);
+        result.insert(QLatin1String("pipelined_expressions_per_s"), pipelined);
+    }
+
+    m_results.insert(QLatin1String("throughput"), result);
+}
+
+void BackendBenchmark::benchmarkLargeOutput()
+{
+    const QString& command = commands().largeOutput;
+    if (command.isEmpty())
+        QSKIP("The backend has no command for large outputs");
+
+    QJsonArray results;
+    for (int megabytes : {1, 10})
+    {
+        waitForIdle();
+
+        const int bytes = megabytes * 1024 * 1024;
+        QElapsedTimer timer;
+        timer.start();
+        auto* expression = session()->evaluateExpression(command.arg(bytes));
+        const bool done = evaluate(expression) && expression->result();
+        const qint64 elapsed = timer.nsecsElapsed();
+        delete expression;
+        QVERIFY(done);
+
+        QJsonObject result;
+        result.insert(QLatin1String("bytes"), bytes);
+        result.insert(QLatin1String("ms"), elapsed / 1e6);
+        result.insert(QLatin1String("mb_per_s"), megabytes / (elapsed / 1e9));
+        results.append(result);
+    }
+
+    m_results.insert(QLatin1String("large_output"), results);
+}
+
+void BackendBenchmark::benchmarkCompletion()
+{
+    const QString& prefix = commands().completion;
+    if (prefix.isEmpty())
+        QSKIP("The backend has no completion");
+
+    QVector<qint64> times;
+    for (int i = 0; i < CompletionSamples; ++i)
+    {
+        waitForIdle();
+
+        QElapsedTimer timer;
+        timer.start();
+        auto* completion = session()->completionFor(prefix, prefix.size());
+        if (!completion)
+            QSKIP("The backend has no completion");
+
+        // CompletionObject::setLine() starts the fetching delayed, so the spy is in place
+        // before it; a backend fetching synchronously has the completions already
+        QSignalSpy spy(completion, SIGNAL(fetchingDone()));
+        if (spy.isEmpty() && completion->completions().isEmpty())
+            waitForSignal(completion, SIGNAL(fetchingDone()));
+        times << timer.nsecsElapsed();
+
+        QVERIFY(!spy.isEmpty() || !completion->completions().isEmpty());
+        completion->deleteLater();
+    }
+
+    m_results.insert(QLatin1String("completion"), statistics(times));
+}
+
+void BackendBenchmark::benchmarkVariableModel()
+{
+    const QString& assignment = commands().assignment;
+    if (assignment.isEmpty() || !session()->variableModel())
+        QSKIP("The backend has no variable model");
+
+    // all variables are created by one command, so that the model is updated only once meanwhile
+    QStringList lines;
+    for (int i = 0; i < Variables; ++i)
+        lines << assignment.arg(i);
+    auto* expression = session()->evaluateExpression(lines.join(QLatin1Char('\n')));
+    const bool done = evaluate(expression);
+    delete expression;
+    QVERIFY(done);
+    waitForIdle();
+
+    QVector<qint64> times;
+    for (int i = 0; i < LoginSamples; ++i)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        session()->variableModel()->update();
+        waitForIdle();
+        times << timer.nsecsElapsed();
+    }
+
+    QJsonObject result = statistics(times);
+    result.insert(QLatin1String("variables"), Variables);
+    m_results.insert(QLatin1String("variable_model"), result);
+}
+
+/*
+ * Runs the benchmarks for all installed backends or the backends given with --backend
+ * and writes the results to the file given with --json, cantor_backend_benchmarks.json by default.
+ * The other arguments are passed to QTest.
+ */
+int main(int argc, char* argv[])
+{
+    QApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QLatin1String("cantor"));
+
+    const QString& path = QString::fromLocal8Bit(PATH_TO_CANTOR_PLUGINS);
+    if (!QCoreApplication::libraryPaths().contains(path))
+        QCoreApplication::addLibraryPath(path);
+
+    QStringList arguments = app.arguments();
+    QString output = QLatin1String("cantor_backend_benchmarks.json");
+    QStringList backends;
+    for (int i = 1; i < arguments.size() - 1;)
+    {
+        if (arguments.at(i) == QLatin1String("--json"))
+            output = arguments.at(i + 1);
+        else if (arguments.at(i) == QLatin1String("--backend"))
+            backends << arguments.at(i + 1).toLower();
+        else
+        {
+            ++i;
+            continue;
+        }
+        arguments.erase(arguments.begin() + i, arguments.begin() + i + 2);
+    }
+
+    int status = 0;
+    QJsonObject results;
+    for (auto* backend : Cantor::Backend::availableBackends())
+    {
+        if (!backend->isEnabled() || (!backends.isEmpty() && !backends.contains(backend->id())))
+            continue;
+
+        BackendBenchmark benchmark(backend->id());
+        status |= QTest::qExec(&benchmark, arguments);
+        if (!benchmark.results().isEmpty())
+            results.insert(backend->id(), benchmark.results());
+    }
+
+    QJsonObject root;
+    root.insert(QLatin1String("date"), QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    root.insert(QLatin1String("qt"), QLatin1String(qVersion()));
+    root.insert(QLatin1String("backends"), results);
+
+    QFile file(output);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qWarning() << "couldn't write the results to" << output;
+        return 1;
+    }
+    file.write(QJsonDocument(root).toJson());
+    qDebug() << "results written to" << output;
+
+    return status;
+}
@@ -0,0 +1,60 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#ifndef BACKENDBENCHMARK_H
+#define BACKENDBENCHMARK_H
+
+#include "backendtest.h"
+
+#include <QJsonObject>
+#include <QVector>
+
+/**
+ * Measures the round trips to a backend: the login, the latency of trivial expressions,
+ * the throughput of many small expressions and of large outputs, the update of the variable
+ * model and the latency of the completion. The measurements are collected in results(),
+ * which cantor_backend_benchmarks writes as JSON for all installed backends.
+ */
+class BackendBenchmark : public BackendTest
+{
+  Q_OBJECT
+
+  public:
+    explicit BackendBenchmark(const QString& backend);
+
+    QJsonObject results() const;
+
+  private Q_SLOTS:
+    void benchmarkLogin();
+    void benchmarkLatency();
+    void benchmarkThroughput();
+    void benchmarkLargeOutput();
+    void benchmarkCompletion();
+    void benchmarkVariableModel();
+
+  private:
+    /**
+     * The commands of the backend language used for the measurements,
+     * %1 is replaced by a number. Empty commands aren't supported by the backend.
+     */
+    struct Commands
+    {
+        QString trivial;
+        QString assignment;
+        QString largeOutput;
+        QString completion;
+    };
+
+    QString backendName() override;
+    Commands commands() const;
+    bool evaluate(Cantor::Expression*);
+    void waitForIdle();
+    static QJsonObject statistics(QVector<qint64> nanoseconds);
+
+    QString m_backend;
+    QJsonObject m_results;
+};
+
+#endif // BACKENDBENCHMARK_H
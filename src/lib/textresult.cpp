@@ -5,12 +5,14 @@
 */
 
 #include "textresult.h"
+#include "largetextbuffer.h"
 using namespace Cantor;
 
 #include <QFile>
 #include <QTextStream>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QScopedPointer>
 
 QString rtrim(const QString& s)
 {
@@ -21,11 +23,30 @@ QString rtrim(const QString& s)
     return result;
 }
 
+static qint64 largeThreshold = 512 * 1024;
+
 class Cantor::TextResultPrivate
 {
 public:
+    QString text() const
+    {
+        return buffer ? buffer->text() : data;
+    }
+
+    void moveLargeText()
+    {
+        if (separatePlain || data.size() <= largeThreshold)
+            return;
+
+        buffer.reset(new LargeTextBuffer(data));
+        data.clear();
+        plain.clear();
+    }
+
     QString data;
     QString plain;
+    bool separatePlain{false};
+    QScopedPointer<LargeTextBuffer> buffer; // the text of the large results instead of data and plain
     TextResult::Format format{TextResult::PlainTextFormat};
     bool isStderr{false};
     bool isWarning{false};
@@ -35,12 +56,14 @@ TextResult::TextResult(const QString& data) : d(new TextResultPrivate)
 {
     d->data = rtrim(data);
     d->plain = d->data;
+    d->moveLargeText();
 }
 
 TextResult::TextResult(const QString& data, const QString& plain) : d(new TextResultPrivate)
 {
     d->data = rtrim(data);
     d->plain = rtrim(plain);
+    d->separatePlain = true;
 }
 
 TextResult::~TextResult()
@@ -48,6 +71,39 @@ TextResult::~TextResult()
     delete d;
 }
 
+bool TextResult::isLarge() const
+{
+    return !d->buffer.isNull();
+}
+
+const LargeTextBuffer* TextResult::textBuffer() const
+{
+    return d->buffer.data();
+}
+
+void TextResult::append(const QString& text)
+{
+    if (d->buffer)
+    {
+        d->buffer->append(text);
+        return;
+    }
+
+    d->data += text;
+    d->plain = d->separatePlain ? d->plain + text : d->data;
+    d->moveLargeText();
+}
+
+qint64 TextResult::largeTextThreshold()
+{
+    return largeThreshold;
+}
+
+void TextResult::setLargeTextThreshold(qint64 characters)
+{
+    largeThreshold = characters;
+}
+
 void TextResult::setIsWarning(bool value)
 {
     d->isWarning = value;
@@ -60,7 +116,7 @@ bool TextResult::isWarning() const
 
 QString TextResult::toHtml()
 {
-    QString s = d->data.toHtmlEscaped();
+    QString s = d->text().toHtmlEscaped();
     s.replace(QLatin1Char('\n'), QLatin1String("<br/>\n"));
     s.replace(QLatin1Char(' '), QLatin1String("&nbsp;"));
     return s;
@@ -68,12 +124,12 @@ QString TextResult::toHtml()
 
 QVariant TextResult::data()
 {
-    return QVariant(d->data);
+    return QVariant(d->text());
 }
 
 QString TextResult::plain()
 {
-    return d->plain;
+    return d->buffer ? d->buffer->text() : d->plain;
 }
 
 int TextResult::type()
@@ -133,7 +189,7 @@ QJsonValue Cantor::TextResult::toJupyterJson()
                 root.insert(QLatin1String("execution_count"), executionIndex());
 
                 QJsonObject data;
-                data.insert(QLatin1String("text/plain"), jupyterText(d->data));
+                data.insert(QLatin1String("text/plain"), jupyterText(d->text()));
                 root.insert(QLatin1String("data"), data);
 
                 root.insert(QLatin1String("metadata"), jupyterMetadata());
@@ -149,7 +205,7 @@ QJsonValue Cantor::TextResult::toJupyterJson()
                 // Jupyter don't support a few text result (it merges them into one text),
                 // so add additional \n to end
                 // See https://github.com/jupyter/notebook/issues/4699
-                root.insert(QLatin1String("text"), jupyterText(d->data, true));
+                root.insert(QLatin1String("text"), jupyterText(d->text(), true));
             }
             break;
         }
@@ -165,8 +221,8 @@ QJsonValue Cantor::TextResult::toJupyterJson()
                 root.insert(QLatin1String("output_type"), QLatin1String("display_data"));
 
             QJsonObject data;
-            data.insert(QLatin1String("text/latex"), jupyterText(d->data));
-            data.insert(QLatin1String("text/plain"), jupyterText(d->plain));
+            data.insert(QLatin1String("text/latex"), jupyterText(d->text()));
+            data.insert(QLatin1String("text/plain"), jupyterText(plain()));
             root.insert(QLatin1String("data"), data);
 
             root.insert(QLatin1String("metadata"), jupyterMetadata());
@@ -184,6 +240,13 @@ void TextResult::save(const QString& filename)
     if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
         return;
 
+    // the large texts are written without converting them
+    if (d->buffer)
+    {
+        file.write(d->buffer->utf8());
+        return;
+    }
+
     QTextStream stream(&file);
 
     stream<<d->data;
@@ -14,6 +14,7 @@
 namespace Cantor
 {
 
+class LargeTextBuffer;
 class TextResultPrivate;
 class CANTOR_EXPORT TextResult : public Result
 {
@@ -33,6 +34,23 @@ class CANTOR_EXPORT TextResult : public Result
 
     QString plain();
 
+    /**
+     * Plain text results longer than largeTextThreshold() characters are only kept in a
+     * LargeTextBuffer, data() and plain() convert the whole text on every call then.
+     * Use textBuffer() to access parts of the text.
+     */
+    bool isLarge() const;
+    const LargeTextBuffer* textBuffer() const;
+
+    /**
+     * Appends @p text to the text of the result, e.g. for output arriving in parts.
+     * The result is moved into a LargeTextBuffer when it exceeds largeTextThreshold().
+     */
+    void append(const QString& text);
+
+    static qint64 largeTextThreshold();
+    static void setLargeTextThreshold(qint64 characters);
+
     int type() override;
     QString mimeType() override;
 
@@ -0,0 +1,451 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#include "typesettingqueue.h"
+using namespace Cantor;
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QProcess>
+#include <QStandardPaths>
+#include <QTemporaryFile>
+#include <QThreadPool>
+#include <QUrl>
+
+#include "latexrenderer.h"
+#include "renderer.h"
+#include "settings.h"
+
+static const QLatin1String pageSeparator("\n\\newpage\n");
+
+TypesettingRasterizeTask::TypesettingRasterizeTask(const QString& key, const QUrl& url) : m_key(key), m_url(url)
+{
+}
+
+void TypesettingRasterizeTask::run()
+{
+    const QImage& image = Renderer::fileRenderToImage(m_url, 1.0, false);
+    emit finished(m_key, image);
+    deleteLater();
+}
+
+TypesettingQueue::TypesettingQueue(QObject* parent) : QObject(parent),
+    m_imageFormat(LatexRenderer::defaultImageFormat()),
+    m_batchFormat(m_imageFormat)
+{
+    // Small delay for collecting the results of consecutive expressions into one batch
+    m_batchTimer.setSingleShot(true);
+    m_batchTimer.setInterval(20);
+    connect(&m_batchTimer, &QTimer::timeout, this, &TypesettingQueue::startBatch);
+
+    // Cost is measured in KiB of the rasterized images
+    m_cache.setMaxCost(32 * 1024);
+}
+
+TypesettingQueue::~TypesettingQueue()
+{
+    if (m_process)
+    {
+        m_process->disconnect(this);
+        m_process->kill();
+        m_process->waitForFinished(1000);
+    }
+    cleanupBatchFiles();
+
+    qDeleteAll(m_pending);
+    qDeleteAll(m_batch);
+    for (const auto& batch : m_forcedBatches)
+        qDeleteAll(batch);
+}
+
+void TypesettingQueue::setMaximalBatchSize(int size)
+{
+    m_maxBatchSize = qMax(1, size);
+}
+
+int TypesettingQueue::maximalBatchSize() const
+{
+    return m_maxBatchSize;
+}
+
+void TypesettingQueue::setImageFormat(LatexRenderer::ImageFormat format)
+{
+    m_imageFormat = format;
+}
+
+LatexRenderer::ImageFormat TypesettingQueue::imageFormat() const
+{
+    return m_imageFormat;
+}
+
+void TypesettingQueue::clearCache()
+{
+    m_cache.clear();
+}
+
+QString TypesettingQueue::cacheKey(const QString& header, const QString& body) const
+{
+    // The full document also contains the colors, the font size and the format specific
+    // preamble, so changing them invalidates the cache
+    return LatexRenderer::document(header, body, m_imageFormat);
+}
+
+void TypesettingQueue::enqueue(LatexRenderer* renderer)
+{
+    const QString& header = renderer->header();
+    const QString& body = renderer->documentBody();
+    const QString& key = cacheKey(header, body);
+
+    CacheEntry* cached = m_cache.object(key);
+    if (cached && QFile::exists(cached->url.toLocalFile()))
+    {
+        const QString uuid = cached->uuid;
+        const QUrl url = cached->url;
+        const QImage image = cached->image;
+        QTimer::singleShot(0, renderer, [=]() {
+            renderer->finishBatched(true, uuid, url, image, QString());
+        });
+        return;
+    }
+
+    connect(renderer, &QObject::destroyed, this, &TypesettingQueue::removeRenderer);
+
+    // The same code is already waiting for typesetting, don't render it twice
+    Job* job = findJob(key);
+    if (job)
+    {
+        job->renderers.append(renderer);
+        return;
+    }
+
+    job = new Job;
+    job->key = key;
+    job->header = header;
+    job->body = body;
+    job->renderers.append(renderer);
+    m_pending.append(job);
+
+    scheduleBatch();
+}
+
+TypesettingQueue::Job* TypesettingQueue::findJob(const QString& key) const
+{
+    for (Job* job : m_pending)
+        if (job->key == key)
+            return job;
+
+    for (Job* job : m_batch)
+        if (job->key == key)
+            return job;
+
+    for (const auto& batch : m_forcedBatches)
+        for (Job* job : batch)
+            if (job->key == key)
+                return job;
+
+    return nullptr;
+}
+
+void TypesettingQueue::scheduleBatch()
+{
+    // The results arriving while a batch is processed are collected and typeset together afterwards
+    if (m_batch.isEmpty() && !m_batchTimer.isActive())
+        m_batchTimer.start();
+}
+
+void TypesettingQueue::startBatch()
+{
+    if (!m_batch.isEmpty())
+        return;
+
+    if (!m_forcedBatches.isEmpty())
+        m_batch = m_forcedBatches.takeFirst();
+    else if (!m_pending.isEmpty())
+    {
+        // All results in one document have to share the same preamble
+        const QString header = m_pending.first()->header;
+        for (auto iter = m_pending.begin(); iter != m_pending.end() && m_batch.size() < m_maxBatchSize;)
+        {
+            if ((*iter)->header == header)
+            {
+                m_batch.append(*iter);
+                iter = m_pending.erase(iter);
+            }
+            else
+                ++iter;
+        }
+    }
+
+    if (m_batch.isEmpty())
+        return;
+
+    const QString& dir = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
+
+    m_batchFormat = m_imageFormat;
+    if (m_batchFormat == LatexRenderer::PdfImage && (!LatexRenderer::isPdfLatexAvailable() || !LatexRenderer::preparePreviewStyle(dir)))
+        m_batchFormat = LatexRenderer::EpsImage;
+
+    if (m_batchFormat == LatexRenderer::EpsImage && !LatexRenderer::isEpsPipelineAvailable())
+    {
+        for (Job* job : m_batch)
+            finishJob(job, false, QStringLiteral("failed to find latex or dvips executable"));
+        finishBatch();
+        return;
+    }
+
+    m_batchName = QLatin1String("cantor_batch_") + LatexRenderer::genUuid();
+
+    // Every preview environment is a separate page in the pdf, the dvi pages have to be separated explicitly
+    QStringList pages;
+    for (Job* job : m_batch)
+        pages.append(LatexRenderer::page(job->body, m_batchFormat));
+    const QString& separator = m_batchFormat == LatexRenderer::PdfImage ? QLatin1String("\n") : pageSeparator;
+
+    m_texFile = new QTemporaryFile(dir + QDir::separator() + QLatin1String("cantor_tex-XXXXXX.tex"));
+    m_texFile->open();
+    m_texFile->write(LatexRenderer::document(m_batch.first()->header, pages.join(separator), m_batchFormat).toUtf8());
+    m_texFile->flush();
+
+    qDebug() << "typesetting" << m_batch.size() << "results in" << m_texFile->fileName();
+
+    m_process = new QProcess(this);
+    m_process->setWorkingDirectory(dir);
+    if (m_batchFormat == LatexRenderer::PdfImage)
+        m_process->setProgram(Settings::self()->pdflatexCommand());
+    else
+        m_process->setProgram(Settings::self()->latexCommand());
+    m_process->setArguments({QStringLiteral("-jobname=") + m_batchName, QStringLiteral("-halt-on-error"), m_texFile->fileName()});
+
+    connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, &TypesettingQueue::latexFinished);
+    m_process->start();
+}
+
+void TypesettingQueue::latexFinished()
+{
+    const QString& dir = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
+    const QString& outputFile = dir + QDir::separator() + m_batchName
+                                + (m_batchFormat == LatexRenderer::PdfImage ? QLatin1String(".pdf") : QLatin1String(".dvi"));
+
+    const bool failed = m_process->exitStatus() != QProcess::NormalExit || m_process->exitCode() != 0;
+    m_process->deleteLater();
+    m_process = nullptr;
+
+    if (failed || !QFile::exists(outputFile))
+    {
+        splitBatch(QStringLiteral("failed to create the latex preview image"));
+        return;
+    }
+
+    if (m_batchFormat == LatexRenderer::PdfImage)
+    {
+        // The pdf is used by the results directly, no conversion is needed
+        const QUrl& pdfUrl = QUrl::fromLocalFile(outputFile);
+        const int pageCount = Renderer::pdfPageCount(pdfUrl);
+        if (pageCount != m_batch.size())
+        {
+            QFile::remove(outputFile);
+            splitBatch(QStringLiteral("failed to create the latex preview image"));
+            return;
+        }
+
+        QList<QUrl> pages;
+        for (int i = 0; i < pageCount; ++i)
+        {
+            QUrl url = pdfUrl;
+            if (pageCount > 1)
+                url.setFragment(QLatin1String("page=") + QString::number(i + 1));
+            pages.append(url);
+        }
+
+        rasterizePages(pages);
+        return;
+    }
+
+    // -i -S 1 produces a separate EPS file with its own bounding box for every page
+    m_process = new QProcess(this);
+    m_process->setProgram(Settings::self()->dvipsCommand());
+    m_process->setArguments({QStringLiteral("-E"), QStringLiteral("-i"), QStringLiteral("-S"), QStringLiteral("1"), QStringLiteral("-q"),
+                             QStringLiteral("-o"), dir + QDir::separator() + m_batchName + QLatin1String(".eps"), outputFile});
+
+    connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, &TypesettingQueue::dvipsFinished);
+    m_process->start();
+}
+
+void TypesettingQueue::dvipsFinished()
+{
+    m_process->deleteLater();
+    m_process = nullptr;
+
+    const QString& dir = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
+    const QString& pagePrefix = dir + QDir::separator() + m_batchName + QLatin1Char('.');
+
+    int pageCount = 0;
+    while (QFile::exists(pagePrefix + QString::number(pageCount + 1).rightJustified(3, QLatin1Char('0'))))
+        ++pageCount;
+
+    // Results not fitting into one page (or not producing any output at all) shift the pages,
+    // so the mapping between the pages and the results is only valid if the numbers match.
+    // A single result spanning several pages is shown by its first page, like before.
+    if (pageCount == 0 || (pageCount != m_batch.size() && m_batch.size() != 1))
+    {
+        splitBatch(QStringLiteral("failed to create the latex preview image"));
+        return;
+    }
+
+    QList<QUrl> pages;
+    for (int i = 0; i < m_batch.size(); ++i)
+    {
+        const QString& epsFilename = dir + QDir::separator() + QLatin1String("cantor_") + LatexRenderer::genUuid() + QLatin1String(".eps");
+        QFile::rename(pagePrefix + QString::number(i + 1).rightJustified(3, QLatin1Char('0')), epsFilename);
+        pages.append(QUrl::fromLocalFile(epsFilename));
+    }
+
+    rasterizePages(pages);
+}
+
+void TypesettingQueue::rasterizePages(const QList<QUrl>& pages)
+{
+    for (int i = 0; i < m_batch.size(); ++i)
+    {
+        Job* job = m_batch[i];
+        job->url = pages[i];
+        job->uuid = LatexRenderer::genUuid();
+
+        auto* task = new TypesettingRasterizeTask(job->key, job->url);
+        task->setAutoDelete(false);
+        connect(task, &TypesettingRasterizeTask::finished, this, &TypesettingQueue::rasterized);
+        ++m_rasterizingCount;
+        QThreadPool::globalInstance()->start(task);
+    }
+
+    cleanupBatchFiles();
+}
+
+void TypesettingQueue::rasterized(const QString& key, const QImage& image)
+{
+    --m_rasterizingCount;
+
+    Job* job = nullptr;
+    for (Job* batchJob : m_batch)
+        if (batchJob->key == key)
+        {
+            job = batchJob;
+            break;
+        }
+
+    if (job)
+    {
+        job->image = image;
+
+        auto* entry = new CacheEntry;
+        entry->uuid = job->uuid;
+        entry->url = job->url;
+        entry->image = image;
+        m_cache.insert(key, entry, qMax(1, image.bytesPerLine() * image.height() / 1024));
+
+        m_batch.removeOne(job);
+        finishJob(job, true);
+        delete job;
+    }
+
+    if (m_rasterizingCount == 0)
+        finishBatch();
+}
+
+void TypesettingQueue::splitBatch(const QString& reason)
+{
+    cleanupBatchFiles();
+
+    if (m_batch.size() == 1)
+    {
+        finishJob(m_batch.first(), false, reason);
+        finishBatch();
+        return;
+    }
+
+    // Some result in the batch can't be typeset, bisect the batch to isolate it
+    // without losing the results typeset fine.
+    qDebug() << "typesetting of" << m_batch.size() << "results failed, splitting the batch";
+    const int half = m_batch.size() / 2;
+    m_forcedBatches.prepend(m_batch.mid(half));
+    m_forcedBatches.prepend(m_batch.mid(0, half));
+    m_batch.clear();
+
+    m_batchTimer.start();
+}
+
+void TypesettingQueue::finishJob(Job* job, bool success, const QString& errorMessage)
+{
+    const auto renderers = job->renderers;
+    job->renderers.clear();
+
+    for (LatexRenderer* renderer : renderers)
+    {
+        disconnect(renderer, &QObject::destroyed, this, &TypesettingQueue::removeRenderer);
+        renderer->finishBatched(success, job->uuid, job->url, job->image, errorMessage);
+    }
+}
+
+void TypesettingQueue::finishBatch()
+{
+    cleanupBatchFiles();
+    qDeleteAll(m_batch);
+    m_batch.clear();
+
+    if (!m_pending.isEmpty() || !m_forcedBatches.isEmpty())
+        m_batchTimer.start();
+}
+
+void TypesettingQueue::removeRenderer(QObject* object)
+{
+    // Only the pointer value is used here, the object is already being destroyed
+    auto* renderer = static_cast<LatexRenderer*>(object);
+
+    for (auto iter = m_pending.begin(); iter != m_pending.end();)
+    {
+        (*iter)->renderers.removeAll(renderer);
+        if ((*iter)->renderers.isEmpty())
+        {
+            delete *iter;
+            iter = m_pending.erase(iter);
+        }
+        else
+            ++iter;
+    }
+
+    // Jobs of the running batches are kept, their results still go to the cache
+    for (Job* job : m_batch)
+        job->renderers.removeAll(renderer);
+
+    for (const auto& batch : m_forcedBatches)
+        for (Job* job : batch)
+            job->renderers.removeAll(renderer);
+}
+
+void TypesettingQueue::cleanupBatchFiles()
+{
+    if (m_batchName.isEmpty())
+        return;
+
+    const QString& pathWithoutExtension = QStandardPaths::writableLocation(QStandardPaths::TempLocation) + QDir::separator() + m_batchName;
+    QFile::remove(pathWithoutExtension + QLatin1String(".log"));
+    QFile::remove(pathWithoutExtension + QLatin1String(".aux"));
+    QFile::remove(pathWithoutExtension + QLatin1String(".dvi"));
+
+    // pages which weren't renamed for the results
+    int page = 1;
+    QString pageFile = pathWithoutExtension + QLatin1String(".001");
+    while (QFile::exists(pageFile) || page <= m_batch.size())
+    {
+        QFile::remove(pageFile);
+        ++page;
+        pageFile = pathWithoutExtension + QLatin1Char('.') + QString::number(page).rightJustified(3, QLatin1Char('0'));
+    }
+
+    delete m_texFile;
+    m_texFile = nullptr;
+    m_batchName.clear();
+}
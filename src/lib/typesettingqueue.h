@@ -0,0 +1,143 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#ifndef _TYPESETTINGQUEUE_H
+#define _TYPESETTINGQUEUE_H
+
+#include <QObject>
+#include <QCache>
+#include <QImage>
+#include <QList>
+#include <QRunnable>
+#include <QTimer>
+#include <QUrl>
+
+#include "cantor_export.h"
+#include "latexrenderer.h"
+
+class QProcess;
+class QTemporaryFile;
+
+namespace Cantor
+{
+
+/**
+ * Per-session queue for typesetting the LaTeX results of the expressions.
+ *
+ * Instead of running latex and dvips for every single result, all the results
+ * pending at the moment the queue gets idle are collected into one document
+ * (one page per result). With the PDF image format the document is compiled by
+ * one pdflatex run and the results refer to the pages of the produced PDF file.
+ * With the EPS format the document is compiled with one latex run and split into
+ * separate EPS files with one dvips run. The pages are rasterized in the thread pool,
+ * so the rendered results are available without blocking the GUI thread.
+ *
+ * Rendered results are cached by their LaTeX source, so the re-evaluation of an
+ * expression producing the same output doesn't start any process at all.
+ *
+ * The queue doesn't take the ownership of the enqueued renderers, but it handles
+ * their destruction before the rendering is finished.
+ */
+class CANTOR_EXPORT TypesettingQueue : public QObject
+{
+  Q_OBJECT
+  public:
+    explicit TypesettingQueue(QObject* parent = nullptr);
+    ~TypesettingQueue() override;
+
+    /**
+     * Schedules the rendering of the LaTeX code of @p renderer.
+     * The done() or error() signal of the renderer is emitted when the rendering is finished,
+     * but never before the control returns to the event loop.
+     */
+    void enqueue(LatexRenderer* renderer);
+
+    /**
+     * Maximal amount of results combined in one latex run
+     */
+    void setMaximalBatchSize(int size);
+    int maximalBatchSize() const;
+
+    /**
+     * Image format used for the following batches, LatexRenderer::defaultImageFormat() by default
+     */
+    void setImageFormat(LatexRenderer::ImageFormat format);
+    LatexRenderer::ImageFormat imageFormat() const;
+
+    /**
+     * Drops all cached rendering results
+     */
+    void clearCache();
+
+  private:
+    struct Job
+    {
+        QString key;
+        QString header;
+        QString body;
+        QString uuid;
+        QUrl url;
+        QImage image;
+        QList<LatexRenderer*> renderers;
+    };
+
+    struct CacheEntry
+    {
+        QString uuid;
+        QUrl url;
+        QImage image;
+    };
+
+    void scheduleBatch();
+    void startBatch();
+    void latexFinished();
+    void dvipsFinished();
+    void rasterizePages(const QList<QUrl>& pages);
+    void rasterized(const QString& key, const QImage& image);
+    void splitBatch(const QString& reason);
+    void finishJob(Job* job, bool success, const QString& errorMessage = QString());
+    void finishBatch();
+    void removeRenderer(QObject* renderer);
+    void cleanupBatchFiles();
+    Job* findJob(const QString& key) const;
+
+    QString cacheKey(const QString& header, const QString& body) const;
+
+  private:
+    QList<Job*> m_pending;
+    QList<QList<Job*>> m_forcedBatches;
+    QList<Job*> m_batch;
+    QString m_batchName;
+    QTemporaryFile* m_texFile{nullptr};
+    QProcess* m_process{nullptr};
+    int m_rasterizingCount{0};
+    int m_maxBatchSize{64};
+    LatexRenderer::ImageFormat m_imageFormat;
+    LatexRenderer::ImageFormat m_batchFormat;
+    QTimer m_batchTimer;
+    QCache<QString, CacheEntry> m_cache;
+};
+
+/**
+ * Rasterizes one page produced by the typesetting queue in the thread pool
+ */
+class TypesettingRasterizeTask : public QObject, public QRunnable
+{
+  Q_OBJECT
+  public:
+    TypesettingRasterizeTask(const QString& key, const QUrl& url);
+    void run() override;
+
+  Q_SIGNALS:
+    void finished(const QString& key, const QImage& image);
+
+  private:
+    QString m_key;
+    QUrl m_url;
+};
+
+}
+
+#endif /* _TYPESETTINGQUEUE_H */
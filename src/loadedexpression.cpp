@@ -11,6 +11,7 @@
 #include "lib/textresult.h"
 #include "lib/latexresult.h"
 #include "lib/animationresult.h"
+#include "lib/plotresult.h"
 #include "lib/latexrenderer.h"
 #include "lib/mimeresult.h"
 #include "lib/htmlresult.h"
@@ -107,7 +108,7 @@ void LoadedExpression::loadFromXml(const QDomElement& xml, const KZip& file)
 
             addResult(result);
         }
-        else if (type == QLatin1String("image") || type == QLatin1String("latex") || type == QLatin1String("animation") || type == QLatin1String("epsimage"))
+        else if (type == QLatin1String("image") || type == QLatin1String("latex") || type == QLatin1String("animation") || type == QLatin1String("epsimage") || type == QLatin1String("plot"))
         {
             const KArchiveEntry* imageEntry=file.directory()->entry(resultElement.attribute(QLatin1String("filename")));
             if (imageEntry&&imageEntry->isFile())
@@ -116,6 +117,8 @@ void LoadedExpression::loadFromXml(const QDomElement& xml, const KZip& file)
                 QString dir=QStandardPaths::writableLocation(QStandardPaths::TempLocation);
                 imageFile->copyTo(dir);
                 QUrl imageUrl = QUrl::fromLocalFile(QDir(dir).absoluteFilePath(imageFile->name()));
+                if (resultElement.hasAttribute(QLatin1String("fragment")))
+                    imageUrl.setFragment(resultElement.attribute(QLatin1String("fragment")));
                 if(type==QLatin1String("latex"))
                 {
                     const QByteArray& ba = QByteArray::fromBase64(resultElement.attribute(QLatin1String("image")).toLatin1());
@@ -127,6 +130,10 @@ void LoadedExpression::loadFromXml(const QDomElement& xml, const KZip& file)
                 {
                     addResult(new Cantor::AnimationResult(imageUrl));
                 }
+                else if(type==QLatin1String("plot"))
+                {
+                    addResult(new Cantor::PlotResult(imageUrl, resultElement.text()));
+                }
                 else if(type==QLatin1String("epsimage"))
                 {
                     const QByteArray& ba = QByteArray::fromBase64(resultElement.attribute(QLatin1String("image")).toLatin1());
@@ -256,7 +263,7 @@ void LoadedExpression::loadFromJupyter(const QJsonObject& cell)
                 renderer->setMethod(Cantor::LatexRenderer::LatexMethod);
                 renderer->renderBlocking();
 
-                result = new Cantor::LatexResult(latex, QUrl::fromLocalFile(renderer->imagePath()), text, image);
+                result = new Cantor::LatexResult(latex, renderer->imageUrl(), text, image);
 
                 // If we have failed to render LaTeX i think Cantor should show the latex code at least
                 if (!renderer->renderingSuccessful())
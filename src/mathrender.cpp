@@ -10,9 +10,12 @@
 #include <QStandardPaths>
 #include <QFile>
 #include <QFileInfo>
+#include <QPointer>
+#include <QTextDocument>
 
 #include "mathrendertask.h"
 #include "lib/renderer.h"
+#include "settings.h"
 
 MathRenderer::MathRenderer(): m_scale(1.0), m_useHighRes(false)
 {
@@ -21,6 +24,13 @@ MathRenderer::MathRenderer(): m_scale(1.0), m_useHighRes(false)
 
 MathRenderer::~MathRenderer()
 {
+    // don't wait for the pdflatex runs, nobody needs their results anymore
+    for (auto* job : m_jobs)
+        if (job->task)
+            job->task->cancel();
+
+    m_pool.waitForDone();
+    qDeleteAll(m_jobs);
 }
 
 bool MathRenderer::mathRenderAvailable()
@@ -46,32 +56,174 @@ void MathRenderer::useHighResolution(bool b)
 
 void MathRenderer::renderExpression(int jobId, const QString& mathExpression, Cantor::LatexRenderer::EquationType type, const QObject* receiver, const char* resultHandler)
 {
-    MathRenderTask* task = new MathRenderTask(jobId, mathExpression, type, m_scale, m_useHighRes);
-    task->setHandler(receiver, resultHandler);
-    task->setAutoDelete(false);
+    // the new request supersedes the previous one of the receiver with the same id
+    for (auto* job : m_jobs)
+        for (int i = job->requests.size() - 1; i >= 0; --i)
+            if (job->requests.at(i).receiver == receiver && job->requests.at(i).jobId == jobId)
+                job->requests.removeAt(i);
+    cancelUnusedJobs();
+
+    Request request;
+    request.receiver = const_cast<QObject*>(receiver);
+    request.jobId = jobId;
+
+    // SLOT() prefixes the signature with a code, QMetaObject::invokeMethod() needs the plain method name
+    request.handler = QByteArray(resultHandler + 1);
+    request.handler.truncate(request.handler.indexOf('('));
+
+    // the same expression is rendered already, share the result
+    for (auto* job : m_jobs)
+    {
+        if (!job->cancelled && job->code == mathExpression && job->type == type
+            && job->scale == m_scale && job->highResolution == m_useHighRes)
+        {
+            job->requests << request;
+            return;
+        }
+    }
 
-    QThreadPool::globalInstance()->start(task);
+    auto* job = new Job();
+    job->code = mathExpression;
+    job->type = type;
+    job->scale = m_scale;
+    job->highResolution = m_useHighRes;
+    job->requests << request;
+    m_jobs << job;
+
+    startJobs();
 }
 
-void MathRenderer::rerender(QTextDocument* document, const QTextImageFormat& math)
+void MathRenderer::cancelUnusedJobs()
 {
-    const QString& filename = math.property(Cantor::Renderer::ImagePath).toString();
-    if (!QFile::exists(filename))
+    for (int i = m_jobs.size() - 1; i >= 0; --i)
+    {
+        Job* job = m_jobs.at(i);
+        for (int j = job->requests.size() - 1; j >= 0; --j)
+            if (!job->requests.at(j).receiver)
+                job->requests.removeAt(j);
+
+        if (!job->requests.isEmpty() || job->cancelled)
+            continue;
+
+        if (job->task)
+        {
+            // the job is removed when the task reports back
+            job->cancelled = true;
+            job->task->cancel();
+        }
+        else
+        {
+            m_jobs.removeAt(i);
+            delete job;
+        }
+    }
+}
+
+void MathRenderer::startJobs()
+{
+    const int maxCount = qMax(1, Settings::self()->mathRenderThreads());
+    m_pool.setMaxThreadCount(maxCount);
+
+    for (auto* job : m_jobs)
+    {
+        if (m_runningCount >= maxCount)
+            break;
+
+        if (job->task)
+            continue;
+
+        auto* task = new MathRenderTask(0, job->code, job->type, job->scale, job->highResolution);
+        task->setAutoDelete(false);
+        connect(task, &MathRenderTask::finish, this, [this, task](QSharedPointer<MathRenderResult> result) {
+            jobFinished(task, result);
+        });
+
+        job->task = task;
+        ++m_runningCount;
+        m_pool.start(task);
+    }
+}
+
+void MathRenderer::jobFinished(MathRenderTask* task, QSharedPointer<MathRenderResult> result)
+{
+    Job* job = nullptr;
+    for (auto* j : m_jobs)
+        if (j->task == task)
+        {
+            job = j;
+            break;
+        }
+
+    if (!job)
         return;
 
-    QString errorMessage;
-    QImage img = Cantor::Renderer::pdfRenderToImage(QUrl::fromLocalFile(filename), m_scale, m_useHighRes, nullptr, &errorMessage);
-    bool success = img.isNull() == false;
+    m_jobs.removeOne(job);
+    --m_runningCount;
+
+    // the handlers can request new jobs, don't touch the job afterwards
+    const QList<Request> requests = job->requests;
+    delete job;
 
-    if (success)
+    for (const auto& request : requests)
     {
-        QUrl internal(math.name());
-        document->addResource(QTextDocument::ImageResource, internal, QVariant(img));
+        if (!request.receiver)
+            continue;
+
+        QSharedPointer<MathRenderResult> receiverResult(new MathRenderResult(*result));
+        receiverResult->jobId = request.jobId;
+        QMetaObject::invokeMethod(request.receiver, request.handler.constData(), Qt::DirectConnection,
+                                  Q_ARG(QSharedPointer<MathRenderResult>, receiverResult));
     }
-    else
+
+    startJobs();
+}
+
+void MathRenderer::rerender(QTextDocument* document, const QTextImageFormat& math)
+{
+    const QString& filename = math.property(Cantor::Renderer::ImagePath).toString();
+    rerender(document, QUrl::fromLocalFile(filename), QUrl(math.name()));
+}
+
+void MathRenderer::rerender(QTextDocument* document, const QUrl& url, const QUrl& internal)
+{
+    if (!QFile::exists(url.toLocalFile()))
+        return;
+
+    // printing needs the images in the final resolution right now
+    if (m_useHighRes)
     {
-        qDebug() << "Rerender embedded math failed with message: " << errorMessage;
+        QString errorMessage;
+        const QImage& img = Cantor::Renderer::fileRenderToImage(url, m_scale, m_useHighRes, nullptr, &errorMessage);
+        if (!img.isNull())
+            document->addResource(QTextDocument::ImageResource, internal, QVariant(img));
+        else
+            qDebug() << "Rerender embedded math failed with message: " << errorMessage;
+        return;
     }
+
+    auto* task = new MathRerenderTask(url, internal, m_scale, m_useHighRes);
+    task->setAutoDelete(false);
+
+    QPointer<QTextDocument> doc(document);
+    const double scale = m_scale;
+    ++m_pendingRerenders;
+    connect(task, &MathRerenderTask::finish, this, [this, doc, scale](const QUrl& internal, const QImage& image) {
+        --m_pendingRerenders;
+
+        // the zoom level was changed in the meantime, the image is outdated already
+        if (!doc || image.isNull() || scale != m_scale)
+            return;
+
+        doc->addResource(QTextDocument::ImageResource, internal, QVariant(image));
+        doc->markContentsDirty(0, doc->characterCount());
+    });
+
+    QThreadPool::globalInstance()->start(task);
+}
+
+int MathRenderer::pendingRerenders() const
+{
+    return m_pendingRerenders;
 }
 
 std::pair<QTextImageFormat, QImage> MathRenderer::renderExpressionFromPdf(const QString& filename, const QString& uuid, const QString& code, Cantor::LatexRenderer::EquationType type, bool* outSuccess)
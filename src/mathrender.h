@@ -8,9 +8,16 @@
 #include <QObject>
 #include <QTextImageFormat>
 #include <QMutex>
+#include <QList>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QThreadPool>
 
 #include "lib/latexrenderer.h"
 
+class MathRenderTask;
+struct MathRenderResult;
+
 /**
  * Special class for rendering embedded math in MarkdownEntry and TextEntry
  * Instead of LatexRenderer+EpsRenderer provide all needed functianality in one class
@@ -31,9 +38,14 @@ class MathRenderer : public QObject {
     void useHighResolution(bool b);
 
     /**
-     * This function will run render task in Qt thread pool and
+     * This function will run render task in the thread pool of the renderer and
      * call resultHandler SLOT with MathRenderResult* argument on finish
      * receiver will be managed about pointer, task only create it
+     *
+     * A new request with the same @p jobId and @p receiver supersedes the previous one,
+     * the result of the superseded request is not delivered anymore.
+     * Identical expressions requested at the same time are rendered only once.
+     * The number of parallel pdflatex runs is limited by Settings::mathRenderThreads().
      */
     void renderExpression(
         int jobId,
@@ -44,12 +56,22 @@ class MathRenderer : public QObject {
 
 
     /**
-     * Rerender renderer math expression in document
-     * Unlike MathRender::renderExpression this method isn't async, because
-     * rerender already rendered math is not long operation
+     * Rerender renderer math expression in document in the current resolution
+     * The rasterization runs in Qt thread pool, the document shows the old image until it's finished.
+     * In the high resolution mode (used for printing) the method is blocking.
      */
     void rerender(QTextDocument* document, const QTextImageFormat& math);
 
+    /**
+     * Rerender the image resource @p internal of @p document from the pdf or eps file @p url,
+     * like MathRenderer::rerender(QTextDocument*, const QTextImageFormat&)
+     */
+    void rerender(QTextDocument* document, const QUrl& url, const QUrl& internal);
+    /**
+     * Number of the rerendering tasks started by rerender() and not finished yet
+     */
+    int pendingRerenders() const;
+
     /**
      * Render math expression from existing .pdf
      * Like MathRenderer::rerender is blocking
@@ -58,9 +80,36 @@ class MathRenderer : public QObject {
         const QString& filename, const QString& uuid, const QString& code, Cantor::LatexRenderer::EquationType type, bool* success
     );
 
+  private:
+    struct Request
+    {
+        QPointer<QObject> receiver;
+        QByteArray handler;
+        int jobId;
+    };
+
+    struct Job
+    {
+        QString code;
+        Cantor::LatexRenderer::EquationType type;
+        double scale;
+        bool highResolution;
+        MathRenderTask* task{nullptr}; // nullptr while the job is waiting
+        bool cancelled{false};
+        QList<Request> requests;
+    };
+
+    void startJobs();
+    void jobFinished(MathRenderTask* task, QSharedPointer<MathRenderResult> result);
+    void cancelUnusedJobs();
+
   private:
     double m_scale;
     bool m_useHighRes;
+    QList<Job*> m_jobs; // waiting and running jobs in the order of the requests
+    int m_runningCount{0};
+    int m_pendingRerenders{0};
+    QThreadPool m_pool;
 };
 
 #endif /* MATHRENDER_H */
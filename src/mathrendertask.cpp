@@ -58,11 +58,24 @@ void MathRenderTask::setHandler(const QObject* receiver, const char* resultHandl
     connect(this, SIGNAL(finish(QSharedPointer<MathRenderResult>)), receiver, resultHandler);
 }
 
+void MathRenderTask::cancel()
+{
+    m_cancelled = true;
+}
+
 void MathRenderTask::run()
 {
     qDebug()<<"MathRenderTask::run " << m_jobId;
     QSharedPointer<MathRenderResult> result(new MathRenderResult());
 
+    if (m_cancelled)
+    {
+        result->successful = false;
+        result->errorMessage = QString::fromLatin1("Rendering was cancelled.");
+        finalize(result);
+        return;
+    }
+
     const QString& tempDir=QStandardPaths::writableLocation(QStandardPaths::TempLocation);
 
     QTemporaryFile texFile(tempDir + QDir::separator() + QLatin1String("cantor_tex-XXXXXX.tex"));
@@ -136,7 +149,21 @@ void MathRenderTask::run()
     p.setArguments({QStringLiteral("-jobname=cantor_") + uuid, QStringLiteral("-halt-on-error"), texFile.fileName()});
 
     p.start();
-    p.waitForFinished();
+
+    // don't block the thread until the end of a superseded pdflatex run
+    while (!p.waitForFinished(100) && p.state() != QProcess::NotRunning)
+    {
+        if (m_cancelled)
+        {
+            p.kill();
+            p.waitForFinished();
+
+            result->successful = false;
+            result->errorMessage = QString::fromLatin1("Rendering was cancelled.");
+            finalize(result);
+            return;
+        }
+    }
 
     if (p.exitCode() != 0)
     {
@@ -232,3 +259,19 @@ std::pair<QTextImageFormat, QImage> MathRenderTask::renderPdfToFormat(const QStr
 
     return std::make_pair(std::move(format), std::move(image));
 }
+
+MathRerenderTask::MathRerenderTask(const QUrl& url, const QUrl& internal, double scale, bool highResolution)
+    : m_url(url), m_internal(internal), m_scale(scale), m_highResolution(highResolution)
+{
+}
+
+void MathRerenderTask::run()
+{
+    QString errorMessage;
+    const QImage& image = Cantor::Renderer::fileRenderToImage(m_url, m_scale, m_highResolution, nullptr, &errorMessage);
+    if (image.isNull())
+        qDebug() << "Rerender embedded math failed with message: " << errorMessage;
+
+    emit finish(m_internal, image);
+    deleteLater();
+}
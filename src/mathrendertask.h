@@ -13,6 +13,8 @@
 #include <QRunnable>
 #include <QSharedPointer>
 
+#include <atomic>
+
 #include "lib/latexrenderer.h"
 
 class QMutex;
@@ -43,6 +45,12 @@ class MathRenderTask : public QObject, public QRunnable
 
     void setHandler(const QObject *receiver, const char *resultHandler);
 
+    /**
+     * Stops the rendering, the task finishes with an unsuccessful result as soon as possible.
+     * Can be called from any thread.
+     */
+    void cancel();
+
     void run() override;
 
     static std::pair<QTextImageFormat, QImage> renderPdfToFormat(
@@ -72,7 +80,28 @@ class MathRenderTask : public QObject, public QRunnable
     bool m_highResolution;
     QColor m_backgroundColor;
     QColor m_foregroundColor;
+    std::atomic<bool> m_cancelled{false};
+};
+
+/**
+ * Rasterizes an already rendered math expression again, e.g. in a new resolution after zooming
+ */
+class MathRerenderTask : public QObject, public QRunnable
+{
+  Q_OBJECT
+  public:
+    MathRerenderTask(const QUrl& url, const QUrl& internal, double scale, bool highResolution);
 
+    void run() override;
+
+  Q_SIGNALS:
+    void finish(const QUrl& internal, const QImage& image);
+
+  private:
+    QUrl m_url;
+    QUrl m_internal;
+    double m_scale;
+    bool m_highResolution;
 };
 
 #endif /* MATHRENDERTASK_H */
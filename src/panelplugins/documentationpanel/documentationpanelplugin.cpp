@@ -21,52 +21,52 @@ DocumentationPanelPlugin::~DocumentationPanelPlugin()
 
 QWidget* DocumentationPanelPlugin::widget()
 {
+    // the widget with the help engine is created when the panel is shown the first time
     if(!m_widget)
     {
         m_widget = new DocumentationPanelWidget(parentWidget());
-        if (m_cantorShell)
-            connect(m_cantorShell, SIGNAL(requestDocumentation(QString)), m_widget, SLOT(contextSensitiveHelp(QString)));
+        applyState();
     }
 
     return m_widget;
 }
 
-bool DocumentationPanelPlugin::showOnStartup()
-{
-    return true;
-}
-
 void DocumentationPanelPlugin::connectToShell(QObject* cantorShell)
 {
     m_cantorShell = cantorShell;
-    connect(cantorShell, SIGNAL(requestDocumentation(QString)), this, SIGNAL(visibilityRequested()));
+    connect(cantorShell, SIGNAL(requestDocumentation(QString)), this, SLOT(showDocumentation(QString)));
+}
 
-    // when using cantor in labplot, connectToShell() is called after widget() so we need to connect here, too
-    if (m_widget)
-        connect(m_cantorShell, SIGNAL(requestDocumentation(QString)), m_widget, SLOT(contextSensitiveHelp(QString)));
+void DocumentationPanelPlugin::showDocumentation(const QString& keyword)
+{
+    emit visibilityRequested();
+    widget();
+    QMetaObject::invokeMethod(m_widget, "contextSensitiveHelp", Q_ARG(QString, keyword));
 }
 
 Cantor::PanelPlugin::State DocumentationPanelPlugin::saveState()
 {
     Cantor::PanelPlugin::State state = PanelPlugin::saveState();
-    state.inners.append(m_widget->url()); //save the currently shown URL in the web view
+    state.inners.append(m_widget ? m_widget->url() : m_url); //save the currently shown URL in the web view
     return state;
 }
 
 void DocumentationPanelPlugin::restoreState(const Cantor::PanelPlugin::State& state)
 {
     PanelPlugin::restoreState(state);
+    m_url = (state.inners.size() == 1) ? state.inners.first().toUrl() : QUrl();
 
-    //TODO: when using this panel in LabPlot this function is being called before widget().
-    //the reason is not completely clear. call widget() here to make sure it's available.
-    if (!m_widget)
-        this->widget();
+    if (m_widget)
+        applyState();
+}
 
-    if(session() && m_widget)
+void DocumentationPanelPlugin::applyState()
+{
+    if(session())
     {
         m_widget->updateBackend(session()->backend()->name());
-        if (state.inners.size() == 1)
-            m_widget->showUrl(state.inners.first().toUrl());
+        if (!m_url.isEmpty())
+            m_widget->showUrl(m_url);
     }
 }
 
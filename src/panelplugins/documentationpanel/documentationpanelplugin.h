@@ -7,6 +7,8 @@
 #ifndef _DOCUMENTATIONPANELPLUGIN_H
 #define _DOCUMENTATIONPANELPLUGIN_H
 
+#include <QUrl>
+
 #include "panelplugin.h"
 
 class DocumentationPanelWidget;
@@ -19,15 +21,20 @@ class DocumentationPanelPlugin : public Cantor::PanelPlugin
     ~DocumentationPanelPlugin() override;
 
     QWidget* widget() override;
-    bool showOnStartup() override;
     void connectToShell(QObject* cantorShell) override;
 
     Cantor::PanelPlugin::State saveState() override;
     void restoreState(const Cantor::PanelPlugin::State&) override;
 
+  private Q_SLOTS:
+    void showDocumentation(const QString&);
+
   private:
+    void applyState();
+
     DocumentationPanelWidget* m_widget = nullptr;
     QObject* m_cantorShell = nullptr;
+    QUrl m_url; // restored URL, shown when the widget is created
 };
 
 #endif /* _DOCUMENTATIONPANELPLUGIN_H */
@@ -67,11 +67,6 @@ void FileBrowserPanelPlugin::connectToShell(QObject* cantorShell)
     connect(this, SIGNAL(requestOpenWorksheet(QUrl)), cantorShell, SLOT(load(QUrl)));
 }
 
-bool FileBrowserPanelPlugin::showOnStartup()
-{
-    return false;
-}
-
 void FileBrowserPanelPlugin::handleDoubleClicked(const QModelIndex& index)
 {
     QVariant data = m_model->data(index, QFileSystemModel::FilePathRole);
@@ -28,8 +28,6 @@ class FileBrowserPanelPlugin : public Cantor::PanelPlugin
 
     QWidget* widget() override;
 
-    bool showOnStartup() override;
-
     void connectToShell(QObject * cantorShell) override;
 
     // No use restore files, because the FileBrowser Panel can be shared between session
@@ -24,7 +24,7 @@ QWidget* HelpPanelPlugin::widget()
     if(!m_edit)
     {
         m_edit = new KTextEdit(parentWidget());
-        setHelpHtml(QString());
+        setHelpHtml(m_html);
         m_edit->setTextInteractionFlags(Qt::TextBrowserInteraction);
     }
 
@@ -33,6 +33,8 @@ QWidget* HelpPanelPlugin::widget()
 
 void HelpPanelPlugin::setHelpHtml(const QString& help)
 {
+    // the text is shown when the widget is created
+    m_html = help;
     if(!m_edit)
         return;
 
@@ -48,11 +50,6 @@ void HelpPanelPlugin::showHelp(const QString& help)
         m_edit->setHtml(help);
 }
 
-bool HelpPanelPlugin::showOnStartup()
-{
-    return false;
-}
-
 void HelpPanelPlugin::connectToShell(QObject* cantorShell)
 {
     //using old-style syntax here, otherwise we'd need to include and link to CantorPart and KParts
@@ -63,7 +60,7 @@ void HelpPanelPlugin::connectToShell(QObject* cantorShell)
 Cantor::PanelPlugin::State HelpPanelPlugin::saveState()
 {
     auto state = PanelPlugin::saveState();
-    state.inners.append(m_edit->toHtml());
+    state.inners.append(m_edit ? m_edit->toHtml() : m_html);
     return state;
 }
 
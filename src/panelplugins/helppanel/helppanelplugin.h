@@ -21,8 +21,6 @@ class HelpPanelPlugin : public Cantor::PanelPlugin
 
     QWidget* widget() override;
 
-    bool showOnStartup() override;
-
     void connectToShell(QObject * cantorShell) override;
 
     Cantor::PanelPlugin::State saveState() override;
@@ -35,6 +33,7 @@ class HelpPanelPlugin : public Cantor::PanelPlugin
 
   private:
     QPointer<KTextEdit> m_edit;
+    QString m_html;
 
 };
 
@@ -41,11 +41,6 @@ void TableOfContentPanelPlugin::connectToShell(QObject* cantorShell)
     connect(cantorShell, SIGNAL(hierarhyEntryNameChange(QString, QString, int)), this, SLOT(handleHierarhyEntryNameChange(QString, QString, int)));
 }
 
-bool TableOfContentPanelPlugin::showOnStartup()
-{
-    return false;
-}
-
 void TableOfContentPanelPlugin::handleDoubleClicked(const QModelIndex& index)
 {
     qDebug() << "TableOfContentPanelPlugin::handleDoubleClicked";
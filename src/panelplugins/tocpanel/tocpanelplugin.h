@@ -27,8 +27,6 @@ class TableOfContentPanelPlugin : public Cantor::PanelPlugin
 
     QWidget* widget() override;
 
-    bool showOnStartup() override;
-
     void connectToShell(QObject * cantorShell) override;
 
     State saveState() override;
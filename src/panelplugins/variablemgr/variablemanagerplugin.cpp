@@ -38,10 +38,5 @@ QWidget* VariableManagerPlugin::widget()
     return m_widget;
 }
 
-Cantor::Backend::Capabilities VariableManagerPlugin::requiredCapabilities()
-{
-    return Cantor::Backend::VariableManagement;
-}
-
 K_PLUGIN_FACTORY_WITH_JSON(variablemanagerplugin, "variablemanagerplugin.json", registerPlugin<VariableManagerPlugin>();)
 #include "variablemanagerplugin.moc"
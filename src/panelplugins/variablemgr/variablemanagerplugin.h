@@ -21,8 +21,6 @@ class VariableManagerPlugin : public Cantor::PanelPlugin
 
     QWidget* widget() override;
 
-    Cantor::Backend::Capabilities requiredCapabilities() override;
-
     void restoreState(const Cantor::PanelPlugin::State & state) override;
 
   private:
@@ -106,16 +106,13 @@ VariableManagerWidget::VariableManagerWidget(Cantor::Session* session, QWidget*
 
 void VariableManagerWidget::setSession(Cantor::Session* session)
 {
+    detachModel();
     m_session = session;
+    m_model = session ? session->variableDataModel() : nullptr;
     if (session)
     {
-        m_model = session->variableDataModel();
-        if (m_treeView)
-            m_treeView->setModel(m_model);
-
-        connect(m_model, &QAbstractItemModel::rowsInserted, this, &VariableManagerWidget::updateButtons);
-        connect(m_model, &QAbstractItemModel::rowsRemoved, this, &VariableManagerWidget::updateButtons);
-        updateButtons();
+        if (isVisible())
+            attachModel();
 
         //check for the methods the backend actually supports, and disable the buttons accordingly
         auto* ext = dynamic_cast<Cantor::VariableManagementExtension*>(
@@ -136,6 +133,42 @@ void VariableManagerWidget::setSession(Cantor::Session* session)
     }
 }
 
+/*!
+ * shows the variable model of the session and follows its changes,
+ * done only while the panel is visible
+ */
+void VariableManagerWidget::attachModel()
+{
+    if (!m_model || m_treeView->model() == m_model)
+        return;
+
+    m_treeView->setModel(m_model);
+    connect(m_model, &QAbstractItemModel::rowsInserted, this, &VariableManagerWidget::updateButtons);
+    connect(m_model, &QAbstractItemModel::rowsRemoved, this, &VariableManagerWidget::updateButtons);
+    filterTextChanged(m_leFilter->text());
+    updateButtons();
+}
+
+void VariableManagerWidget::detachModel()
+{
+    if (m_model)
+        disconnect(m_model, nullptr, this, nullptr);
+    m_treeView->setModel(nullptr);
+}
+
+void VariableManagerWidget::showEvent(QShowEvent* event)
+{
+    attachModel();
+    QWidget::showEvent(event);
+}
+
+void VariableManagerWidget::hideEvent(QHideEvent* event)
+{
+    // hidden panels don't need to process the updates of the variable model
+    detachModel();
+    QWidget::hideEvent(event);
+}
+
 void VariableManagerWidget::clearVariables()
 {
     int btn = KMessageBox::questionYesNo(this,
@@ -251,6 +284,8 @@ void VariableManagerWidget::filterTextChanged(const QString& text) {
     auto sensitivity = m_caseSensitiveAction->isChecked() ? Qt::CaseSensitive : Qt::CaseInsensitive;
     bool matchCompleteWord = m_matchCompleteWordAction->isChecked();
     const auto* model = m_treeView->model();
+    if (!model)
+        return;
 
     for (int i = 0; i < model->rowCount(); i++) {
         const auto& child = model->index(i, 0);
@@ -269,7 +304,7 @@ void VariableManagerWidget::filterTextChanged(const QString& text) {
 
 void VariableManagerWidget::updateButtons()
 {
-    bool enabled = (m_treeView->model()->rowCount() != 0);
+    bool enabled = (m_treeView->model() && m_treeView->model()->rowCount() != 0);
     m_saveBtn->setEnabled(enabled);
     m_clearBtn->setEnabled(enabled);
 }
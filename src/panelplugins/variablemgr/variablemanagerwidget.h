@@ -7,6 +7,7 @@
 #ifndef _VARIABLEMANAGERWIDGET_H
 #define _VARIABLEMANAGERWIDGET_H
 
+#include <QPointer>
 #include <QWidget>
 
 namespace Cantor{
@@ -39,7 +40,7 @@ Q_SIGNALS:
 
 private:
     Cantor::Session* m_session{nullptr};
-    QAbstractItemModel* m_model{nullptr};
+    QPointer<QAbstractItemModel> m_model;
     QTreeView* m_treeView{nullptr};
     QToolButton* m_newBtn{nullptr};
     QToolButton* m_loadBtn{nullptr};
@@ -54,6 +55,10 @@ private:
     QAction* m_copyNameValueAction{nullptr};
 
     void contextMenuEvent(QContextMenuEvent*) override;
+    void showEvent(QShowEvent*) override;
+    void hideEvent(QHideEvent*) override;
+    void attachModel();
+    void detachModel();
 
 private Q_SLOTS:
     void filterTextChanged(const QString&);
@@ -0,0 +1,183 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#include "plotresultitem.h"
+#include "worksheet.h"
+#include "worksheetview.h"
+#include "lib/plotresult.h"
+
+#include <QFileDialog>
+#include <QGraphicsSceneMouseEvent>
+#include <QGraphicsSceneWheelEvent>
+#include <QMenu>
+#include <QPainter>
+
+#include <KLocalizedString>
+
+#include <cmath>
+#include <limits>
+
+static const double DefaultWidth = 640;
+static const double AspectRatio = 0.6;
+
+PlotResultItem::PlotResultItem(QGraphicsObject* parent, Cantor::Result* result)
+    : WorksheetImageItem(parent), ResultItem(result)
+{
+    setAcceptedMouseButtons(Qt::LeftButton);
+    update();
+}
+
+double PlotResultItem::setGeometry(double x, double y, double w)
+{
+    setPos(x, y);
+
+    const double width = w > 0 ? qMin(w, DefaultWidth) : DefaultWidth;
+    if (width != size().width())
+        setSize(QSizeF(width, width * AspectRatio));
+
+    return height();
+}
+
+void PlotResultItem::populateMenu(QMenu* menu, QPointF)
+{
+    menu->addAction(QIcon::fromTheme(QLatin1String("zoom-original")), i18n("Show whole plot"), this, SLOT(resetView()));
+    ResultItem::addCommonActions(this, menu);
+}
+
+void PlotResultItem::update()
+{
+    Q_ASSERT(m_result->type() == Cantor::PlotResult::Type);
+    if (!size().isValid() || size().isEmpty())
+        setSize(QSizeF(DefaultWidth, DefaultWidth * AspectRatio));
+    resetView();
+}
+
+QRectF PlotResultItem::boundingRect() const
+{
+    return QRectF(0, 0, width(), height());
+}
+
+double PlotResultItem::width() const
+{
+    return WorksheetImageItem::width();
+}
+
+double PlotResultItem::height() const
+{
+    return WorksheetImageItem::height();
+}
+
+void PlotResultItem::deleteLater()
+{
+    WorksheetImageItem::deleteLater();
+}
+
+void PlotResultItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    Q_UNUSED(option);
+    Q_UNUSED(widget);
+
+    const QRectF& rect = boundingRect();
+    painter->fillRect(rect, Qt::white);
+    if (plotResult()->isValid())
+        plotResult()->paint(painter, rect, m_xMin, m_xMax);
+    else
+        painter->drawText(rect, Qt::AlignCenter, i18n("The plot data couldn't be loaded."));
+
+    if (hasFocus())
+    {
+        painter->setPen(Qt::DashLine);
+        painter->drawRect(rect);
+    }
+}
+
+void PlotResultItem::setXRange(double xMin, double xMax)
+{
+    if (!(xMax > xMin) || !qIsFinite(xMin) || !qIsFinite(xMax))
+        return;
+
+    // zooming in stops at a range still distinguishable with the precision of its values
+    const double minimumRange = qMax(qMax(qAbs(xMin), qAbs(xMax)) * 1e-12, std::numeric_limits<double>::min());
+    if (xMax - xMin < minimumRange)
+    {
+        if (m_xMax - m_xMin <= minimumRange)
+            return;
+
+        const double center = xMin / 2 + xMax / 2;
+        xMin = center - minimumRange / 2;
+        xMax = center + minimumRange / 2;
+    }
+
+    m_xMin = xMin;
+    m_xMax = xMax;
+    QGraphicsObject::update();
+}
+
+double PlotResultItem::xMinimum() const
+{
+    return m_xMin;
+}
+
+double PlotResultItem::xMaximum() const
+{
+    return m_xMax;
+}
+
+void PlotResultItem::saveResult()
+{
+    const auto& fileName = QFileDialog::getSaveFileName(worksheet()->worksheetView(),
+                                                        i18n("Save plot result"),
+                                                        /*dir*/ QString(),
+                                                        i18n("PNG files (*.png);;Cantor plot data (*.cantorplot)"));
+    if (!fileName.isEmpty())
+        result()->save(fileName);
+}
+
+void PlotResultItem::resetView()
+{
+    setXRange(plotResult()->xMinimum(), plotResult()->xMaximum());
+}
+
+void PlotResultItem::mousePressEvent(QGraphicsSceneMouseEvent* event)
+{
+    setFocus(Qt::MouseFocusReason);
+    event->accept();
+}
+
+void PlotResultItem::mouseMoveEvent(QGraphicsSceneMouseEvent* event)
+{
+    // pan the visible range with the mouse
+    const double dx = event->pos().x() - event->lastPos().x();
+    const double shift = -dx / width() * (m_xMax - m_xMin);
+    setXRange(m_xMin + shift, m_xMax + shift);
+    event->accept();
+}
+
+void PlotResultItem::mouseDoubleClickEvent(QGraphicsSceneMouseEvent* event)
+{
+    resetView();
+    event->accept();
+}
+
+void PlotResultItem::wheelEvent(QGraphicsSceneWheelEvent* event)
+{
+    // the worksheet is scrolled as long as the plot wasn't clicked
+    if (!hasFocus() || event->orientation() != Qt::Vertical)
+    {
+        WorksheetImageItem::wheelEvent(event);
+        return;
+    }
+
+    // zoom around the x value under the mouse
+    const double factor = std::pow(0.85, event->delta() / 120.0);
+    const double anchor = m_xMin + event->pos().x() / width() * (m_xMax - m_xMin);
+    setXRange(anchor - (anchor - m_xMin) * factor, anchor + (m_xMax - anchor) * factor);
+    event->accept();
+}
+
+Cantor::PlotResult* PlotResultItem::plotResult() const
+{
+    return static_cast<Cantor::PlotResult*>(m_result);
+}
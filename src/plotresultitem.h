@@ -0,0 +1,64 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#ifndef PLOTRESULTITEM_H
+#define PLOTRESULTITEM_H
+
+#include "resultitem.h"
+#include "worksheetimageitem.h"
+
+namespace Cantor {
+    class PlotResult;
+}
+
+/*
+ * Result item for the numeric plots rendered by Cantor, @see Cantor::PlotResult.
+ * The x range of the plot is zoomed with the mouse wheel when the item has the focus
+ * and panned by dragging, a double click shows the whole plot again.
+ */
+class PlotResultItem : public WorksheetImageItem, public ResultItem
+{
+  Q_OBJECT
+  public:
+    explicit PlotResultItem(QGraphicsObject* parent, Cantor::Result* result);
+    ~PlotResultItem() override = default;
+
+    using WorksheetImageItem::setGeometry;
+    double setGeometry(double x, double y, double w) override;
+    void populateMenu(QMenu* menu, QPointF pos) override;
+
+    void update() override;
+
+    QRectF boundingRect() const override;
+    double width() const override;
+    double height() const override;
+
+    void deleteLater() override;
+
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
+
+    void setXRange(double xMin, double xMax);
+    double xMinimum() const;
+    double xMaximum() const;
+
+  protected Q_SLOTS:
+    void saveResult();
+    void resetView();
+
+  protected:
+    void mousePressEvent(QGraphicsSceneMouseEvent*) override;
+    void mouseMoveEvent(QGraphicsSceneMouseEvent*) override;
+    void mouseDoubleClickEvent(QGraphicsSceneMouseEvent*) override;
+    void wheelEvent(QGraphicsSceneWheelEvent*) override;
+
+  private:
+    Cantor::PlotResult* plotResult() const;
+
+  private:
+    double m_xMin{0.};
+    double m_xMax{1.};
+};
+
+#endif // PLOTRESULTITEM_H
@@ -5,8 +5,10 @@
 
 #include "resultitem.h"
 #include "textresultitem.h"
+#include "largetextresultitem.h"
 #include "imageresultitem.h"
 #include "animationresultitem.h"
+#include "plotresultitem.h"
 #include "commandentry.h"
 
 #include "lib/result.h"
@@ -15,6 +17,7 @@
 #include "lib/imageresult.h"
 #include "lib/epsresult.h"
 #include "lib/animationresult.h"
+#include "lib/plotresult.h"
 #include "lib/mimeresult.h"
 #include "lib/htmlresult.h"
 
@@ -29,6 +32,9 @@ ResultItem* ResultItem::create(WorksheetEntry* parent, Cantor::Result* result)
 {
     switch(result->type()) {
     case Cantor::TextResult::Type:
+        if (LargeTextResultItem::isLargeResult(result))
+            return new LargeTextResultItem(parent, result);
+        return new TextResultItem(parent, result);
     case Cantor::LatexResult::Type:
     case Cantor::MimeResult::Type:
     case Cantor::HtmlResult::Type:
@@ -38,6 +44,8 @@ ResultItem* ResultItem::create(WorksheetEntry* parent, Cantor::Result* result)
         return new ImageResultItem(parent, result);
     case Cantor::AnimationResult::Type:
         return new AnimationResultItem(parent, result);
+    case Cantor::PlotResult::Type:
+        return new PlotResultItem(parent, result);
     default:
         return nullptr;
     }
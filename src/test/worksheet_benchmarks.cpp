@@ -0,0 +1,287 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#include <QtTest>
+#include <QDebug>
+#include <QDomDocument>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPainter>
+#include <KActionCollection>
+#include <KLocalizedString>
+#include <KZip>
+
+#include "worksheet_benchmarks.h"
+#include "../worksheet.h"
+#include "../worksheetentry.h"
+#include "../worksheetcursor.h"
+#include "../worksheetview.h"
+#include "../mathrender.h"
+#include "../lib/backend.h"
+
+#include "config-cantor-test.h"
+
+static const QString dataPath = QString::fromLocal8Bit(PATH_TO_TEST_NOTEBOOKS)+QLatin1String("/");
+static const int SyntheticCells = 10000;
+static const QSize ViewSize(1024, 768);
+
+void WorksheetBenchmarks::initTestCase()
+{
+    const QStringList& backends = Cantor::Backend::listAvailableBackends();
+    if (backends.isEmpty())
+    {
+        QString reason = i18n("Testing of worksheets requires a functioning backends");
+        QSKIP( reason.toStdString().c_str(), SkipAll );
+    }
+
+    const QStringList& notebooks = QDir(dataPath).entryList({QLatin1String("*.ipynb"), QLatin1String("*.cws")}, QDir::Files, QDir::Name);
+    for (const QString& notebook : notebooks)
+        m_files << dataPath + notebook;
+
+    QVERIFY(m_dir.isValid());
+    m_files << m_dir.filePath(QLatin1String("Synthetic.ipynb"));
+    writeSyntheticNotebook(m_files.last(), SyntheticCells);
+    m_files << m_dir.filePath(QLatin1String("Synthetic.cws"));
+    writeSyntheticWorksheet(m_files.last(), SyntheticCells);
+}
+
+void WorksheetBenchmarks::addFiles()
+{
+    QTest::addColumn<QString>("path");
+    for (const QString& path : m_files)
+        QTest::newRow(QFileInfo(path).fileName().toUtf8().constData()) << path;
+}
+
+Worksheet* WorksheetBenchmarks::loadWorksheet(const QString& path)
+{
+    Worksheet* w = new Worksheet(Cantor::Backend::getBackend(QLatin1String("maxima")), nullptr, false);
+    new WorksheetView(w, nullptr);
+    w->load(path);
+    KActionCollection* collection = new KActionCollection(w, QString());
+    w->setActionCollection(collection);
+    w->setViewSize(ViewSize.width(), ViewSize.height(), 1.0);
+    return w;
+}
+
+void WorksheetBenchmarks::closeWorksheet(Worksheet* w)
+{
+    // the entries access the view while the scene is deleted
+    WorksheetView* view = w->worksheetView();
+    delete w;
+    delete view;
+}
+
+/*!
+ * writes a Jupyter notebook with @p cells cells, alternating code cells with output and markdown cells
+ */
+void WorksheetBenchmarks::writeSyntheticNotebook(const QString& path, int cells)
+{
+    QJsonArray cellArray;
+    for (int i = 0; i < cells; ++i)
+    {
+        QJsonObject cell;
+        cell.insert(QLatin1String("metadata"), QJsonObject());
+        if (i % 2 == 0)
+        {
+            QJsonObject output;
+            output.insert(QLatin1String("name"), QLatin1String("stdout"));
+            output.insert(QLatin1String("output_type"), QLatin1String("stream"));
+            output.insert(QLatin1String("text"), QJsonArray{QStringLiteral("%1\n").arg(i * 2)});
+
+            cell.insert(QLatin1String("cell_type"), QLatin1String("code"));
+            cell.insert(QLatin1String("execution_count"), i / 2 + 1);
+            cell.insert(QLatin1String("outputs"), QJsonArray{output});
+            cell.insert(QLatin1String("source"), QJsonArray{QStringLiteral("x%1 = %1 * 2\n").arg(i), QStringLiteral("print(x%1)").arg(i)});
+        }
+        else
+        {
+            cell.insert(QLatin1String("cell_type"), QLatin1String("markdown"));
+            cell.insert(QLatin1String("source"), QJsonArray{QStringLiteral("## Section %1\n").arg(i),
+                                                            QLatin1String("The value of *x* is doubled and printed, see the `print` call above.")});
+        }
+        cellArray.append(cell);
+    }
+
+    QJsonObject kernelspec;
+    kernelspec.insert(QLatin1String("display_name"), QLatin1String("Python 3"));
+    kernelspec.insert(QLatin1String("language"), QLatin1String("python"));
+    kernelspec.insert(QLatin1String("name"), QLatin1String("python3"));
+
+    QJsonObject metadata;
+    metadata.insert(QLatin1String("kernelspec"), kernelspec);
+    metadata.insert(QLatin1String("language_info"), QJsonObject{{QLatin1String("name"), QLatin1String("python")}});
+
+    QJsonObject notebook;
+    notebook.insert(QLatin1String("cells"), cellArray);
+    notebook.insert(QLatin1String("metadata"), metadata);
+    notebook.insert(QLatin1String("nbformat"), 4);
+    notebook.insert(QLatin1String("nbformat_minor"), 4);
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(QJsonDocument(notebook).toJson());
+}
+
+/*!
+ * writes a Cantor worksheet with @p cells command entries with text results
+ */
+void WorksheetBenchmarks::writeSyntheticWorksheet(const QString& path, int cells)
+{
+    QDomDocument doc(QLatin1String("CantorWorksheet"));
+    QDomElement root = doc.createElement(QLatin1String("Worksheet"));
+    root.setAttribute(QLatin1String("backend"), QLatin1String("Python"));
+    doc.appendChild(root);
+
+    for (int i = 0; i < cells; ++i)
+    {
+        QDomElement expression = doc.createElement(QLatin1String("Expression"));
+        QDomElement command = doc.createElement(QLatin1String("Command"));
+        command.appendChild(doc.createTextNode(QStringLiteral("x%1 = %1 * 2\nprint(x%1)").arg(i)));
+        expression.appendChild(command);
+
+        QDomElement result = doc.createElement(QLatin1String("Result"));
+        result.setAttribute(QLatin1String("type"), QLatin1String("text"));
+        result.setAttribute(QLatin1String("stderr"), QLatin1String("0"));
+        result.appendChild(doc.createTextNode(QString::number(i * 2)));
+        expression.appendChild(result);
+
+        root.appendChild(expression);
+    }
+
+    KZip zip(path);
+    QVERIFY(zip.open(QIODevice::WriteOnly));
+    zip.writeFile(QLatin1String("content.xml"), doc.toByteArray());
+    zip.close();
+}
+
+void WorksheetBenchmarks::benchmarkLoad_data()
+{
+    addFiles();
+}
+
+void WorksheetBenchmarks::benchmarkLoad()
+{
+    QFETCH(QString, path);
+
+    QBENCHMARK {
+        Worksheet* w = loadWorksheet(path);
+        QVERIFY(w->firstEntry());
+        closeWorksheet(w);
+    }
+}
+
+void WorksheetBenchmarks::benchmarkSave_data()
+{
+    addFiles();
+}
+
+void WorksheetBenchmarks::benchmarkSave()
+{
+    QFETCH(QString, path);
+    Worksheet* w = loadWorksheet(path);
+
+    // Cantor worksheets are saved as zipped XML, Jupyter notebooks as JSON
+    QBENCHMARK {
+        QVERIFY(!w->saveToByteArray().isEmpty());
+    }
+
+    closeWorksheet(w);
+}
+
+void WorksheetBenchmarks::benchmarkLayout_data()
+{
+    addFiles();
+}
+
+void WorksheetBenchmarks::benchmarkLayout()
+{
+    QFETCH(QString, path);
+    Worksheet* w = loadWorksheet(path);
+
+    QBENCHMARK {
+        w->updateLayout();
+    }
+
+    closeWorksheet(w);
+}
+
+void WorksheetBenchmarks::benchmarkRehighlight_data()
+{
+    addFiles();
+}
+
+void WorksheetBenchmarks::benchmarkRehighlight()
+{
+    QFETCH(QString, path);
+    Worksheet* w = loadWorksheet(path);
+    w->enableHighlighting(true);
+
+    QBENCHMARK {
+        w->rehighlight();
+    }
+
+    closeWorksheet(w);
+}
+
+void WorksheetBenchmarks::benchmarkSearch_data()
+{
+    addFiles();
+}
+
+void WorksheetBenchmarks::benchmarkSearch()
+{
+    QFETCH(QString, path);
+    Worksheet* w = loadWorksheet(path);
+
+    // find all occurrences like "Replace All" of the search bar
+    int count = 0;
+    QBENCHMARK {
+        count = 0;
+        for (WorksheetEntry* entry = w->firstEntry(); entry; entry = entry->next())
+        {
+            WorksheetCursor cursor = entry->search(QLatin1String("x"), WorksheetEntry::SearchAll, QTextDocument::FindFlags());
+            while (cursor.isValid())
+            {
+                ++count;
+                cursor = entry->search(QLatin1String("x"), WorksheetEntry::SearchAll, QTextDocument::FindFlags(), cursor);
+            }
+        }
+    }
+    qDebug() << count << "matches";
+
+    closeWorksheet(w);
+}
+
+void WorksheetBenchmarks::benchmarkZoom_data()
+{
+    addFiles();
+}
+
+void WorksheetBenchmarks::benchmarkZoom()
+{
+    QFETCH(QString, path);
+    Worksheet* w = loadWorksheet(path);
+    QImage image(ViewSize, QImage::Format_ARGB32_Premultiplied);
+
+    // alternate between two zoom levels and paint the visible area of the scene,
+    // the math images are rasterized again in the thread pool, the time includes them
+    qreal scale = 1.0;
+    QBENCHMARK {
+        scale = scale == 1.0 ? 1.5 : 1.0;
+        w->setViewSize(ViewSize.width() / scale, ViewSize.height() / scale, scale);
+        w->updateLayout();
+
+        QPainter painter(&image);
+        w->render(&painter, QRectF(QPointF(), ViewSize), QRectF(0, 0, ViewSize.width() / scale, ViewSize.height() / scale));
+        painter.end();
+
+        QTRY_COMPARE_WITH_TIMEOUT(w->mathRenderer()->pendingRerenders(), 0, 60000);
+    }
+
+    closeWorksheet(w);
+}
+
+QTEST_MAIN( WorksheetBenchmarks )
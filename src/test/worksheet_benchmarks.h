@@ -0,0 +1,51 @@
+/*
+    SPDX-License-Identifier: GPL-2.0-or-later
+    SPDX-FileCopyrightText: 2026 Cantor authors
+*/
+
+#ifndef WORKSHEET_BENCHMARKS_H
+#define WORKSHEET_BENCHMARKS_H
+
+#include <QObject>
+#include <QStringList>
+#include <QTemporaryDir>
+
+class Worksheet;
+class WorksheetView;
+
+/**
+ * Benchmarks of loading, saving, laying out, highlighting, searching and zooming worksheets,
+ * for the notebooks of the test data and for synthetic worksheets with 10000 cells.
+ */
+class WorksheetBenchmarks: public QObject
+{
+    Q_OBJECT
+
+  private Q_SLOTS:
+    void initTestCase();
+
+    void benchmarkLoad_data();
+    void benchmarkLoad();
+    void benchmarkSave_data();
+    void benchmarkSave();
+    void benchmarkLayout_data();
+    void benchmarkLayout();
+    void benchmarkRehighlight_data();
+    void benchmarkRehighlight();
+    void benchmarkSearch_data();
+    void benchmarkSearch();
+    void benchmarkZoom_data();
+    void benchmarkZoom();
+
+  private:
+    void addFiles();
+    Worksheet* loadWorksheet(const QString& path);
+    void closeWorksheet(Worksheet*);
+    void writeSyntheticNotebook(const QString& path, int cells);
+    void writeSyntheticWorksheet(const QString& path, int cells);
+
+    QTemporaryDir m_dir;
+    QStringList m_files;
+};
+
+#endif /* WORKSHEET_BENCHMARKS_H */
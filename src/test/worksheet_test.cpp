@@ -19,13 +19,19 @@
 #include "../markdownentry.h"
 #include "../commandentry.h"
 #include "../latexentry.h"
+#include "../largetextresultitem.h"
+#include "../resultitem.h"
+#include "../entrydependencies.h"
 #include "../lib/backend.h"
 #include "../lib/expression.h"
 #include "../lib/result.h"
 #include "../lib/textresult.h"
+#include "../lib/largetextbuffer.h"
+#include "../lib/imagecache.h"
 #include "../lib/imageresult.h"
 #include "../lib/latexresult.h"
 #include "../lib/animationresult.h"
+#include "../lib/plotresult.h"
 #include "../lib/mimeresult.h"
 #include "../lib/htmlresult.h"
 
@@ -7049,4 +7055,359 @@ void WorksheetTest::testMathRender2()
     QCOMPARE(mathNode.text(), QLatin1String("$12$"));
 }
 
+void WorksheetTest::testMathRenderSuperseded()
+{
+    Cantor::Backend* backend = Cantor::Backend::getBackend(QLatin1String("python"));
+    if (backend && backend->isEnabled() == false)
+        QSKIP("Skip, because python backend don't available", SkipSingle);
+
+    Worksheet* w = new Worksheet(Cantor::Backend::getBackend(QLatin1String("python")), nullptr);
+    WorksheetView v(w, nullptr);
+    v.setEnabled(false);
+    w->enableEmbeddedMath(true);
+
+    if (!w->mathRenderer()->mathRenderAvailable())
+        QSKIP("This test needs workable embedded math (pdflatex)", SkipSingle);
+
+    // the second evaluation supersedes the pending rendering of the first one
+    MarkdownEntry* entry = static_cast<MarkdownEntry*>(WorksheetEntry::create(MarkdownEntry::Type, w));
+    entry->setContent(QLatin1String("$$12$$"));
+    entry->evaluate(WorksheetEntry::InternalEvaluation);
+    entry->setContent(QLatin1String("$$13$$"));
+    entry->evaluate(WorksheetEntry::InternalEvaluation);
+
+    // Give 1 second to math renderer
+    QTest::qWait(1000);
+
+    QDomDocument doc;
+    QBuffer buffer;
+    KZip archive(&buffer);
+    QDomElement elem = entry->toXml(doc, &archive);
+
+    QDomNodeList list = elem.elementsByTagName(QLatin1String("EmbeddedMath"));
+    QCOMPARE(list.count(), 1);
+    QDomElement mathNode = list.at(0).toElement();
+    bool rendered = mathNode.attribute(QStringLiteral("rendered")).toInt();
+    QCOMPARE(rendered, true);
+    QCOMPARE(mathNode.text(), QLatin1String("$$13$$"));
+}
+
+void WorksheetTest::testAnimationCacheBudget()
+{
+    Worksheet w(nullptr, nullptr);
+
+    // the decoded frames of all animations in the worksheet share one budget
+    const qint64 size = 100 * 1024 * 1024;
+    QVERIFY(w.reserveAnimationCache(size));
+    QVERIFY(!w.reserveAnimationCache(size));
+    w.releaseAnimationCache(size);
+    QVERIFY(w.reserveAnimationCache(size));
+}
+
+void WorksheetTest::testLargeTextBuffer()
+{
+    using Cantor::LargeTextBuffer;
+
+    QString text;
+    for (int i = 0; i < 1000; ++i)
+        text += QString::number(i) + QLatin1Char('\n');
+    const QString& longLine = QLatin1Char('x') + QString(LargeTextBuffer::MaxLineLength / 2 + 10, QChar(0x00E4)); // two bytes per umlaut in UTF-8
+    text += longLine;
+
+    LargeTextBuffer buffer(text);
+    QCOMPARE(buffer.isFileBacked(), false);
+
+    // the last line is split at a character boundary
+    QCOMPARE(buffer.lineCount(), 1002);
+    QCOMPARE(buffer.line(0), QLatin1String("0"));
+    QCOMPARE(buffer.line(999), QLatin1String("999"));
+    QCOMPARE(buffer.lines(998, 2), QLatin1String("998\n999"));
+    QCOMPARE(buffer.line(1000).size(), LargeTextBuffer::MaxLineLength / 2);
+    QCOMPARE(buffer.line(1000) + buffer.line(1001), longLine);
+    QCOMPARE(buffer.line(1002), QString());
+
+    // the appended text continues the last line
+    buffer.append(QLatin1String("y\nz"));
+    QCOMPARE(buffer.lineCount(), 1003);
+    QCOMPARE(buffer.line(1001), longLine.mid(LargeTextBuffer::MaxLineLength / 2) + QLatin1Char('y'));
+    QCOMPARE(buffer.line(1002), QLatin1String("z"));
+    QCOMPARE(buffer.text(), text + QLatin1String("y\nz"));
+
+    buffer.append(QLatin1String("\n"));
+    buffer.append(QLatin1String("last"));
+    QCOMPARE(buffer.lineCount(), 1004);
+    QCOMPARE(buffer.line(1003), QLatin1String("last"));
+}
+
+void WorksheetTest::testLargeTextResult()
+{
+    const qint64 threshold = Cantor::TextResult::largeTextThreshold();
+    Cantor::TextResult::setLargeTextThreshold(100);
+
+    Cantor::TextResult small(QLatin1String("text"));
+    QVERIFY(!small.isLarge());
+
+    // the large text is only kept in the buffer of the result
+    QString text;
+    for (int i = 0; i < 50; ++i)
+        text += QString::number(i) + QLatin1Char('\n');
+    Cantor::TextResult result(text);
+    QVERIFY(result.isLarge());
+    QCOMPARE(result.textBuffer()->lineCount(), 50);
+    QCOMPARE(result.plain(), text.trimmed());
+
+    // a small result growing above the threshold is moved into a buffer
+    small.append(text);
+    QVERIFY(small.isLarge());
+    QCOMPARE(small.plain(), QLatin1String("text") + text);
+
+    // the large LaTeX results are exported with their whole text
+    Cantor::TextResult latex(text);
+    latex.setFormat(Cantor::TextResult::LatexFormat);
+    const QJsonObject& data = latex.toJupyterJson().toObject().value(QLatin1String("data")).toObject();
+    QCOMPARE(data.value(QLatin1String("text/latex")).toArray().size(), 50);
+    QCOMPARE(data.value(QLatin1String("text/plain")).toArray().size(), 50);
+
+    Worksheet w(nullptr, nullptr);
+    Cantor::TextResult::setLargeTextThreshold(100);
+    auto* entry = WorksheetEntry::create(CommandEntry::Type, &w);
+    auto* item = dynamic_cast<LargeTextResultItem*>(ResultItem::create(entry, &result));
+    QVERIFY(item);
+
+    // only the visible lines are in the document
+    const int visibleLines = item->visibleLineCount();
+    QVERIFY(visibleLines > 0 && visibleLines <= 50);
+    QCOMPARE(item->toPlainText(), result.textBuffer()->lines(0, visibleLines));
+
+    item->scrollToLine(50);
+    QCOMPARE(item->firstVisibleLine(), 50 - visibleLines);
+    QCOMPARE(item->toPlainText().section(QLatin1Char('\n'), -1), QLatin1String("49"));
+
+    // the appended lines are shown after the update of the item
+    result.append(QLatin1String("\n50\n51"));
+    item->update();
+    QCOMPARE(result.textBuffer()->lineCount(), 52);
+    item->scrollToLine(52);
+    QCOMPARE(item->firstVisibleLine(), 52 - visibleLines);
+    QCOMPARE(item->toPlainText().section(QLatin1Char('\n'), -1), QLatin1String("51"));
+
+    Cantor::TextResult::setLargeTextThreshold(threshold);
+}
+
+void WorksheetTest::testImageCache()
+{
+    QTemporaryFile file(QDir::tempPath() + QLatin1String("/cantor_test_XXXXXX.png"));
+    QVERIFY(file.open());
+    QImage original(800, 600, QImage::Format_RGB32);
+    original.fill(Qt::red);
+    QVERIFY(original.save(file.fileName(), "PNG"));
+
+    Cantor::ImageCache cache;
+    QCOMPARE(cache.imageSize(file.fileName()), QSize(800, 600));
+
+    // the image is decoded in the thread pool in the smallest level still covering the requested size
+    QSignalSpy spy(&cache, &Cantor::ImageCache::imageReady);
+    QVERIFY(cache.image(file.fileName(), QSize(150, 100)).isNull());
+    QVERIFY(spy.wait(5000));
+    QCOMPARE(spy.first().first().toString(), file.fileName());
+
+    const QImage& image = cache.image(file.fileName(), QSize(150, 100));
+    QCOMPARE(image.size(), QSize(200, 150));
+    QCOMPARE(image.pixelColor(10, 10), QColor(Qt::red));
+
+    // other zoom levels show the decoded level until their one is available
+    QCOMPARE(cache.image(file.fileName(), QSize(400, 300)).size(), QSize(200, 150));
+    QVERIFY(spy.wait(5000));
+    QCOMPARE(cache.image(file.fileName(), QSize(400, 300)).size(), QSize(400, 300));
+
+    QCOMPARE(cache.decodedImage(file.fileName(), QSize(80, 60)).size(), QSize(80, 60));
+}
+
+void WorksheetTest::testVectorImageCache()
+{
+    QTemporaryFile file(QDir::tempPath() + QLatin1String("/cantor_test_XXXXXX.svg"));
+    QVERIFY(file.open());
+    file.write("<svg xmlns='http://www.w3.org/2000/svg' width='100' height='50' viewBox='0 0 100 50'>"
+               "<rect width='100' height='50' fill='blue'/></svg>");
+    file.close();
+
+    Cantor::ImageCache cache;
+    const QSize& size = cache.imageSize(file.fileName());
+    QCOMPARE(size, Cantor::ImageResult::vectorImageSize(file.fileName()));
+    QVERIFY(size.isValid());
+
+    // vector images are rasterized in the zoomed size rounded up to the next zoom bucket
+    QSignalSpy spy(&cache, &Cantor::ImageCache::imageReady);
+    QVERIFY(cache.image(file.fileName(), size * 2).isNull());
+    QVERIFY(spy.wait(5000));
+    const QImage& image = cache.image(file.fileName(), size * 2);
+    QCOMPARE(image.size(), size * 2);
+    QCOMPARE(image.pixelColor(image.width() / 2, image.height() / 2), QColor(Qt::blue));
+
+    // the sizes in the same bucket share the rasterized image
+    QCOMPARE(cache.image(file.fileName(), size * 1.9).size(), size * 2);
+}
+
+void WorksheetTest::testPlotResultDecimation()
+{
+    QTemporaryFile file(QDir::tempPath() + QLatin1String("/cantor_test_XXXXXX.cantorplot"));
+    QVERIFY(file.open());
+
+    const int count = 100000;
+    QVector<double> x(count);
+    QVector<double> y(count);
+    for (int i = 0; i < count; ++i)
+    {
+        x[i] = i;
+        y[i] = (i % 2) ? 1.0 : -1.0;
+    }
+    y[50000] = 10.0;
+    QVERIFY(Cantor::PlotResult::writeData(file.fileName(), QLatin1String("series"), x, y));
+
+    Cantor::PlotResult result(QUrl::fromLocalFile(file.fileName()));
+    QVERIFY(result.isValid());
+    QCOMPARE(result.seriesCount(), 1);
+    QCOMPARE(result.series(0).name, QLatin1String("series"));
+    QCOMPARE(result.series(0).count, qint64(count));
+    QVERIFY(result.series(0).sorted);
+    QCOMPARE(result.xMinimum(), 0.0);
+    QCOMPARE(result.xMaximum(), double(count - 1));
+
+    // at most four points per column are kept and the extremes are not lost
+    const QPolygonF& points = result.decimate(0, 0, count - 1, 500);
+    QVERIFY(points.size() <= 4 * 500 + 2);
+    double maximum = 0;
+    for (const QPointF& p : points)
+        maximum = qMax(maximum, p.y());
+    QCOMPARE(maximum, 10.0);
+
+    // zoomed in far enough, all points of the range are returned
+    const QPolygonF& zoomed = result.decimate(0, 100, 199, 500);
+    QCOMPARE(zoomed.size(), 102);
+    QCOMPARE(zoomed.first().x(), 99.0);
+    QCOMPARE(zoomed.last().x(), 200.0);
+
+    // the plot files are announced in the output of the backends
+    QString output = QLatin1String("text\n") + Cantor::Expression::PlotFileMarker + file.fileName()
+        + QLatin1String("\tapplication/x-cantor-plot\t") + QString::number(QFileInfo(file.fileName()).size()) + QLatin1String("\n");
+    const auto& plotFiles = Cantor::Expression::takePlotFiles(output);
+    QCOMPARE(plotFiles.size(), 1);
+    QCOMPARE(plotFiles.first().path, file.fileName());
+    QCOMPARE(plotFiles.first().mimeType, QLatin1String("application/x-cantor-plot"));
+    QCOMPARE(plotFiles.first().size, QFileInfo(file.fileName()).size());
+    QCOMPARE(output, QLatin1String("text\n"));
+}
+
+void WorksheetTest::testEntryDependencies()
+{
+    using Names = QSet<QString>;
+
+    // the variables read and written by single commands
+    auto access = EntryDependencies::analyze(QLatin1String("x = a + f(b) # c"));
+    QCOMPARE(access.writes, Names({QLatin1String("x")}));
+    QCOMPARE(access.reads, Names({QLatin1String("a"), QLatin1String("f"), QLatin1String("b")}));
+
+    access = EntryDependencies::analyze(QLatin1String("y[i] += 1"));
+    QCOMPARE(access.writes, Names({QLatin1String("y")}));
+    QCOMPARE(access.reads, Names({QLatin1String("y"), QLatin1String("i")}));
+
+    access = EntryDependencies::analyze(QLatin1String("import numpy as np\nfrom os import path"));
+    QCOMPARE(access.writes, Names({QLatin1String("np"), QLatin1String("path")}));
+
+    access = EntryDependencies::analyze(QLatin1String("def g(t):\n    return t * k"));
+    QCOMPARE(access.writes, Names({QLatin1String("g")}));
+    QCOMPARE(access.reads, Names({QLatin1String("t"), QLatin1String("k")}));
+
+    access = EntryDependencies::analyze(QLatin1String("if x == 1: z = 'a = b'"));
+    QCOMPARE(access.writes, Names({QLatin1String("z")}));
+    QCOMPARE(access.reads, Names({QLatin1String("x")}));
+
+    // the modifications in place
+    access = EntryDependencies::analyze(QLatin1String("lst.append(x)\ndf.drop(c, inplace=True)"));
+    QCOMPARE(access.writes, Names({QLatin1String("lst"), QLatin1String("df")}));
+
+    access = EntryDependencies::analyze(QLatin1String("with open(p) as f: data = f.read()\ndel old"));
+    QCOMPARE(access.writes, Names({QLatin1String("f"), QLatin1String("data"), QLatin1String("old")}));
+
+    access = EntryDependencies::analyze(QLatin1String("assign(\"v\", 5)\npush!(w, 1)"));
+    QCOMPARE(access.writes, Names({QLatin1String("v"), QLatin1String("w")}));
+    QVERIFY(!access.unknownWrites);
+
+    access = EntryDependencies::analyze(QLatin1String("exec(code)"));
+    QVERIFY(access.unknownWrites);
+
+    // the dependencies between the entries
+    QVector<EntryDependencies::Node> nodes(4);
+    const QStringList commands({QLatin1String("a = 1"), QLatin1String("b = a + 1"), QLatin1String("c = 5"), QLatin1String("d = b * c")});
+    for (int i = 0; i < nodes.size(); ++i)
+    {
+        nodes[i].command = commands.at(i);
+        nodes[i].evaluatedCommand = commands.at(i);
+        nodes[i].evaluated = true;
+    }
+
+    EntryDependencies::update(nodes);
+    QCOMPARE(nodes.at(1).dependencies, QVector<int>({0}));
+    QCOMPARE(nodes.at(3).dependencies, QVector<int>({1, 2}));
+    for (const auto& node : nodes)
+        QVERIFY(!node.stale);
+
+    // only the changed entry and the entries depending on it are stale
+    nodes[0].command = QLatin1String("a = 2");
+    EntryDependencies::update(nodes);
+    QVERIFY(nodes.at(0).changed);
+    QVERIFY(nodes.at(0).stale);
+    QVERIFY(nodes.at(1).stale);
+    QVERIFY(!nodes.at(2).stale);
+    QVERIFY(nodes.at(3).stale);
+
+    // the entries reading variables after an entry with unknown writes depend on it
+    nodes[0].evaluatedCommand = nodes.at(0).command;
+    nodes[2].command = QLatin1String("exec(code)");
+    EntryDependencies::update(nodes);
+    QVERIFY(!nodes.at(1).stale);
+    QVERIFY(nodes.at(2).stale);
+    QCOMPARE(nodes.at(3).dependencies, QVector<int>({1, 2}));
+    QVERIFY(nodes.at(3).stale);
+
+    // calling a function reads the variables of its body, also if they are written after the definition
+    nodes.resize(3);
+    const QStringList calls({QLatin1String("def g(t):\n    return t * k"), QLatin1String("k = 2"), QLatin1String("g(3)")});
+    for (int i = 0; i < nodes.size(); ++i)
+    {
+        nodes[i].command = calls.at(i);
+        nodes[i].evaluatedCommand = calls.at(i);
+        nodes[i].evaluated = true;
+    }
+
+    EntryDependencies::update(nodes);
+    QCOMPARE(nodes.at(2).dependencies, QVector<int>({0, 1}));
+
+    nodes[1].command = QLatin1String("k = 3");
+    EntryDependencies::update(nodes);
+    QVERIFY(!nodes.at(0).stale);
+    QVERIFY(nodes.at(1).stale);
+    QVERIFY(nodes.at(2).stale);
+
+    // the comments of the language of the backend
+    EntryDependencies::Syntax maxima;
+    maxima.lineComments.clear();
+    access = EntryDependencies::analyze(QLatin1String("x : if a # b then c else d /* e */"), maxima);
+    QCOMPARE(access.reads, Names({QLatin1String("a"), QLatin1String("b"), QLatin1String("c"), QLatin1String("d")}));
+
+    EntryDependencies::Syntax octave;
+    octave.lineComments = QStringList({QLatin1String("%"), QLatin1String("#")});
+    octave.blockCommentStart.clear();
+    octave.blockCommentEnd.clear();
+    access = EntryDependencies::analyze(QLatin1String("x = a % b\ny = c # d"), octave);
+    QCOMPARE(access.reads, Names({QLatin1String("a"), QLatin1String("c")}));
+
+    EntryDependencies::Syntax scilab;
+    scilab.lineComments = QStringList(QLatin1String("//"));
+    scilab.blockCommentStart.clear();
+    scilab.blockCommentEnd.clear();
+    access = EntryDependencies::analyze(QLatin1String("x = a / b // c"), scilab);
+    QCOMPARE(access.reads, Names({QLatin1String("a"), QLatin1String("b")}));
+}
+
 QTEST_MAIN( WorksheetTest )
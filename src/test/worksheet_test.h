@@ -41,6 +41,15 @@ class WorksheetTest: public QObject
     /* common features tests */
     void testMathRender();
     void testMathRender2();
+    void testMathRenderSuperseded();
+
+    void testAnimationCacheBudget();
+    void testLargeTextBuffer();
+    void testLargeTextResult();
+    void testImageCache();
+    void testVectorImageCache();
+    void testPlotResultDecimation();
+    void testEntryDependencies();
 
   private:
     void waitForSignal( QObject* sender, const char* signal);
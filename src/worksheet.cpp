@@ -21,7 +21,9 @@
 #include "lib/backend.h"
 #include "lib/extension.h"
 #include "lib/helpresult.h"
+#include "lib/textresult.h"
 #include "lib/session.h"
+#include "lib/sessionpool.h"
 #include "lib/defaulthighlighter.h"
 
 #include <config-cantor.h>
@@ -37,7 +39,9 @@
 #include <QRegularExpression>
 #include <QTimer>
 #include <QActionGroup>
+#include <QDateTime>
 #include <QFile>
+#include <QFileInfo>
 #include <QXmlQuery>
 
 #include <kcoreaddons_version.h>
@@ -58,6 +62,7 @@ const double Worksheet::EntryCursorWidth = 2;
 Worksheet::Worksheet(Cantor::Backend* backend, QWidget* parent, bool useDefaultWorksheetParameters)
     : QGraphicsScene(parent),
     m_cursorItemTimer(new QTimer(this)),
+    m_rerenderTimer(new QTimer(this)),
     m_useDefaultWorksheetParameters(useDefaultWorksheetParameters)
 {
     m_entryCursorItem = addLine(0,0,0,0);
@@ -70,6 +75,14 @@ Worksheet::Worksheet(Cantor::Backend* backend, QWidget* parent, bool useDefaultW
     connect(m_cursorItemTimer, &QTimer::timeout, this, &Worksheet::animateEntryCursor);
     m_cursorItemTimer->start(500);
 
+    // coalesce the many scale changes of the zoom animation into one re-rendering
+    m_rerenderTimer->setSingleShot(true);
+    m_rerenderTimer->setInterval(100);
+    connect(m_rerenderTimer, &QTimer::timeout, this, &Worksheet::rerenderVisibleEntries);
+
+    // the text results above the threshold keep their text only in a buffer, see LargeTextResultItem
+    Cantor::TextResult::setLargeTextThreshold(static_cast<qint64>(Settings::largeTextResultThreshold()) * 1024);
+
     if (backend)
         initSession(backend);
 }
@@ -88,6 +101,26 @@ void Worksheet::resumeAnimations()
     m_cursorItemTimer->start(500);
 }
 
+/*!
+ * reserves \c bytes for caching all decoded frames of an animation.
+ * Returns \c false if the worksheet-wide limit would be exceeded, the animation
+ * has to decode its frames on the fly then.
+ */
+bool Worksheet::reserveAnimationCache(qint64 bytes)
+{
+    static const qint64 MaxAnimationCacheSize = 128 * 1024 * 1024;
+    if (m_animationCacheSize + bytes > MaxAnimationCacheSize)
+        return false;
+
+    m_animationCacheSize += bytes;
+    return true;
+}
+
+void Worksheet::releaseAnimationCache(qint64 bytes)
+{
+    m_animationCacheSize = qMax(qint64(0), m_animationCacheSize - bytes);
+}
+
 Worksheet::~Worksheet()
 {
     m_isClosing = true;
@@ -175,12 +208,56 @@ void Worksheet::setViewSize(qreal w, qreal h, qreal s, bool forceUpdate)
     if (s != m_epsRenderer.scale() || forceUpdate) {
         m_epsRenderer.setScale(s);
         m_mathRenderer.setScale(s);
-        for (WorksheetEntry *entry = firstEntry(); entry; entry = entry->next())
-            entry->updateEntry();
+
+        if (m_isPrinting)
+        {
+            // the printed pages need all the images in the final resolution right now
+            for (WorksheetEntry *entry = firstEntry(); entry; entry = entry->next())
+                entry->updateEntry();
+        }
+        else
+        {
+            // the view shows the old images scaled until they are rasterized again,
+            // the visible entries are updated first, the other ones when they are scrolled into view
+            m_rerenderEntries.clear();
+            for (WorksheetEntry *entry = firstEntry(); entry; entry = entry->next())
+                m_rerenderEntries << entry;
+
+            connect(worksheetView(), &WorksheetView::viewRectChanged, this, &Worksheet::rerenderVisibleEntries, Qt::UniqueConnection);
+            m_rerenderTimer->start();
+        }
     }
     updateLayout();
 }
 
+void Worksheet::rerenderVisibleEntries()
+{
+    if (m_rerenderEntries.isEmpty() || m_rerenderTimer->isActive())
+        return;
+
+    // update the entries close to the visible area too, they are likely to be shown next
+    QRectF rect = worksheetView()->viewRect();
+    rect.adjust(0, -rect.height() / 2, 0, rect.height() / 2);
+
+    QList<WorksheetEntry*> visibleEntries;
+    for (auto it = m_rerenderEntries.begin(); it != m_rerenderEntries.end();)
+    {
+        WorksheetEntry* entry = *it;
+        if (!entry)
+            it = m_rerenderEntries.erase(it);
+        else if (QRectF(entry->pos(), entry->size()).intersects(rect))
+        {
+            visibleEntries << entry;
+            it = m_rerenderEntries.erase(it);
+        }
+        else
+            ++it;
+    }
+
+    for (auto* entry : visibleEntries)
+        entry->updateEntry();
+}
+
 void Worksheet::updateLayout()
 {
     bool cursorRectVisible = false;
@@ -696,11 +773,101 @@ void Worksheet::evaluate()
     if (!m_readOnly && m_session && m_session->status() == Cantor::Session::Disable)
         loginToSession();
 
-    firstEntry()->evaluate(WorksheetEntry::EvaluateNext);
+    if (m_session && m_session->supportsPipelining())
+        evaluatePipelined();
+    else
+        firstEntry()->evaluate(WorksheetEntry::EvaluateNext);
 
     setModified();
 }
 
+/*!
+ * evaluates all entries at once instead of evaluating the next entry when the previous one is done.
+ * The commands are sent to the backend without waiting for the results of the previous ones,
+ * if one of them fails the following ones are not evaluated.
+ */
+void Worksheet::evaluatePipelined()
+{
+    WorksheetEntry* last = nullptr;
+
+    m_session->beginPipeline();
+    for (auto* entry = firstEntry(); entry; entry = entry->next())
+    {
+        if (entry != firstEntry() && !entry->wantFocus())
+            continue;
+
+        entry->evaluate(WorksheetEntry::InternalEvaluation);
+        last = entry;
+    }
+    m_session->endPipeline();
+
+    // like at the end of the evaluation of the entries one after another
+    if (last && !isLoadingFromFile() && (!last->isEmpty() || last->type() != CommandEntry::Type))
+        appendCommandEntry();
+}
+
+/*!
+ * evaluates only the command entries changed since their last evaluation and
+ * the entries depending on them, returns the number of the skipped entries
+ */
+int Worksheet::evaluateChangedEntries()
+{
+    if (!m_session)
+        return 0;
+
+    if (!m_readOnly && m_session && m_session->status() == Cantor::Session::Disable)
+        loginToSession();
+
+    QVector<CommandEntry*> entries;
+    const auto& nodes = entryDependencies(entries);
+
+    // the entries following a failed one are not evaluated, like for the whole worksheet,
+    // the pipeline takes care of this also for the backends not supporting pipelined evaluation
+    int skipped = 0;
+    m_session->beginPipeline();
+    for (int i = 0; i < nodes.size(); ++i)
+    {
+        if (nodes.at(i).stale)
+            entries.at(i)->evaluate(WorksheetEntry::InternalEvaluation);
+        else
+            ++skipped;
+    }
+    m_session->endPipeline();
+
+    if (skipped != nodes.size())
+        setModified();
+
+    return skipped;
+}
+
+/*!
+ * returns the dependencies between the command entries to be evaluated, @p entries
+ * is filled with the entries in the order of the returned nodes
+ */
+QVector<EntryDependencies::Node> Worksheet::entryDependencies(QVector<CommandEntry*>& entries)
+{
+    QVector<EntryDependencies::Node> nodes;
+    for (auto* entry = firstEntry(); entry; entry = entry->next())
+    {
+        if (entry->type() != CommandEntry::Type)
+            continue;
+
+        auto* commandEntry = static_cast<CommandEntry*>(entry);
+        if (commandEntry->isExcludedFromExecution() || commandEntry->isEmpty())
+            continue;
+
+        EntryDependencies::Node node;
+        node.command = commandEntry->command();
+        node.evaluatedCommand = commandEntry->evaluatedCommand();
+        node.evaluated = commandEntry->isEvaluated();
+        nodes << node;
+        entries << commandEntry;
+    }
+
+    EntryDependencies::update(nodes, EntryDependencies::syntax(m_session ? m_session->backend() : nullptr));
+    return nodes;
+}
+
 void Worksheet::evaluateCurrentEntry()
 {
     if (!m_readOnly && m_session && m_session->status() == Cantor::Session::Disable)
@@ -1106,6 +1273,11 @@ bool Worksheet::showExpressionIds()
     return m_showExpressionIds;
 }
 
+bool Worksheet::showExpressionDurations()
+{
+    return m_showExpressionDurations;
+}
+
 bool Worksheet::animationsEnabled()
 {
     return m_animationsEnabled;
@@ -1134,6 +1306,14 @@ void Worksheet::enableExpressionNumbering(bool enable)
         updateLayout();
 }
 
+void Worksheet::enableExpressionDurations(bool enable)
+{
+    m_showExpressionDurations = enable;
+    emit updatePrompt();
+    if (views().size() != 0)
+        updateLayout();
+}
+
 QDomDocument Worksheet::toXML(KZip* archive)
 {
     QDomDocument doc( QLatin1String("CantorWorksheet") );
@@ -1195,6 +1375,7 @@ void Worksheet::save( const QString& filename )
     }
 
     save(&file);
+    saveSessionState(filename);
 }
 
 QByteArray Worksheet::saveToByteArray()
@@ -1286,6 +1467,33 @@ void Worksheet::savePlain(const QString& filename)
     file.close();
 }
 
+/*!
+ * saves the timestamps of the lifecycle of the evaluated expressions as a Chrome trace event file
+ */
+void Worksheet::saveTimingTrace(const QString& filename)
+{
+    QVector<Cantor::Expression*> expressions;
+    for (auto* entry = firstEntry(); entry; entry = entry->next())
+    {
+        if (entry->type() != CommandEntry::Type)
+            continue;
+
+        auto* expression = static_cast<CommandEntry*>(entry)->expression();
+        if (expression)
+            expressions << expression;
+    }
+
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        KMessageBox::error(worksheetView(), i18n("Error saving file %1", filename), i18n("Error - Cantor"));
+        return;
+    }
+
+    file.write(Cantor::Expression::chromeTrace(expressions));
+    file.close();
+}
+
 void Worksheet::saveLatex(const QString& filename)
 {
     qDebug()<<"exporting to Latex: " <<filename;
@@ -1330,7 +1538,10 @@ bool Worksheet::load(const QString& filename )
 
     bool rc = load(&file);
     if (rc && !m_readOnly)
+    {
         m_session->setWorksheetPath(filename);
+        prepareSessionStateRestore(filename);
+    }
 
     return rc;
 }
@@ -1507,7 +1718,19 @@ int Worksheet::typeForTagName(const QString& tag)
 
 void Worksheet::initSession(Cantor::Backend* backend)
 {
-    m_session = backend->createSession();
+    // take a session prepared in the background, if available
+    m_session = Cantor::SessionPool::instance()->takeSession(backend);
+    if (!m_session)
+        m_session = backend->createSession();
+
+    // the state of the previous session is lost, all entries have to be evaluated again
+    connect(m_session, &Cantor::Session::loginStarted, this, [this]() {
+        for (auto* entry = firstEntry(); entry; entry = entry->next())
+            if (entry->type() == CommandEntry::Type)
+                static_cast<CommandEntry*>(entry)->resetEvaluation();
+        setSessionStateModified();
+    });
+    connect(m_session, &Cantor::Session::loginDone, this, &Worksheet::restoreSessionState);
     if (m_useDefaultWorksheetParameters)
     {
         enableHighlighting(Settings::self()->highlightDefault());
@@ -1780,6 +2003,12 @@ MathRenderer* Worksheet::mathRenderer()
     return &m_mathRenderer;
 }
 
+Cantor::ImageCache* Worksheet::imageCache()
+{
+    // shared by all worksheets and the image results, so the memory budget is a global one
+    return Cantor::ImageCache::instance();
+}
+
 QMenu* Worksheet::createContextMenu()
 {
     auto* menu = new QMenu(worksheetView());
@@ -2982,6 +3211,98 @@ void Worksheet::insertSubentriesForHierarchy(HierarchyEntry* hierarchyEntry, Wor
 
 void Worksheet::handleSettingsChanges()
 {
+    Cantor::TextResult::setLargeTextThreshold(static_cast<qint64>(Settings::largeTextResultThreshold()) * 1024);
+
     for (auto* entry = firstEntry(); entry; entry = entry->next())
         entry->updateAfterSettingsChanges();
 }
+
+QString Worksheet::sessionStateFileName(const QString& filename)
+{
+    return filename + QLatin1String(".state");
+}
+
+void Worksheet::setSessionStateModified()
+{
+    m_sessionStateModified = true;
+}
+
+/*!
+ * saves the state of the logged in session in a snapshot next to the worksheet file @p filename.
+ * The command is queued like any other expression, the snapshot is written after the running expressions.
+ * The snapshot is only written again if expressions were evaluated since the last one was saved or restored,
+ * otherwise the existing snapshot is kept and only marked as not older than the worksheet file.
+ */
+void Worksheet::saveSessionState(const QString& filename)
+{
+    if (!Settings::self()->saveSessionState() || m_readOnly || !m_session || m_session->status() == Cantor::Session::Disable)
+        return;
+
+    const QString& stateFile = QFileInfo(sessionStateFileName(filename)).absoluteFilePath();
+    if (!m_sessionStateModified && stateFile == m_savedSessionStateFile && QFile::exists(stateFile))
+    {
+        QFile state(stateFile);
+        if (state.open(QIODevice::ReadWrite) && state.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime))
+            return;
+    }
+
+    auto* extension = dynamic_cast<Cantor::VariableManagementExtension*>(m_session->backend()->extension(QLatin1String("VariableManagementExtension")));
+    if (!extension)
+        return;
+
+    const QString& command = extension->saveSessionState(stateFile);
+    if (command.isNull())
+        return;
+
+    m_session->evaluateExpression(command, Cantor::Expression::DeleteOnFinish, true);
+    m_savedSessionStateFile = stateFile;
+    m_sessionStateModified = false;
+}
+
+/*!
+ * remembers the snapshot of the session state saved with the worksheet file @p filename,
+ * it's restored after the login or right now, if the session is logged in already.
+ * The snapshots of Python are pickles and unpickling runs code, so opening a worksheet
+ * with a snapshot runs code without evaluating any entry. Only snapshots written by Cantor
+ * for trusted worksheets should be restored, the setting is off by default for this reason.
+ */
+void Worksheet::prepareSessionStateRestore(const QString& filename)
+{
+    m_sessionStateFile.clear();
+    if (!Settings::self()->saveSessionState())
+        return;
+
+    // the snapshot is written after the worksheet, an older one doesn't belong to the saved results
+    const QFileInfo state(sessionStateFileName(filename));
+    if (!state.exists() || state.lastModified() < QFileInfo(filename).lastModified())
+        return;
+
+    m_sessionStateFile = state.absoluteFilePath();
+    if (m_session->status() != Cantor::Session::Disable)
+        restoreSessionState();
+}
+
+void Worksheet::restoreSessionState()
+{
+    if (m_sessionStateFile.isEmpty())
+        return;
+
+    // the snapshot is restored only once, a restarted session starts from scratch
+    const QString stateFile = m_sessionStateFile;
+    m_sessionStateFile.clear();
+
+    auto* extension = dynamic_cast<Cantor::VariableManagementExtension*>(m_session->backend()->extension(QLatin1String("VariableManagementExtension")));
+    if (!extension)
+        return;
+
+    const QString& command = extension->restoreSessionState(stateFile);
+    if (command.isNull())
+        return;
+
+    qDebug() << "restoring the session state from" << stateFile;
+    m_session->evaluateExpression(command, Cantor::Expression::DeleteOnFinish, true);
+    m_savedSessionStateFile = stateFile;
+    m_sessionStateModified = false;
+    if (m_session->variableModel())
+        m_session->variableModel()->update();
+}
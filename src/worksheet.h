@@ -10,9 +10,12 @@
 
 #include <QDomDocument>
 #include <QGraphicsScene>
+#include <QPointer>
 #include <QQueue>
 
+#include "lib/imagecache.h"
 #include "lib/renderer.h"
+#include "entrydependencies.h"
 #include "mathrender.h"
 #include "worksheetcursor.h"
 
@@ -22,6 +25,7 @@ namespace Cantor {
     class Expression;
 }
 
+class CommandEntry;
 class WorksheetEntry;
 class WorksheetView;
 class HierarchyEntry;
@@ -59,6 +63,7 @@ class Worksheet : public QGraphicsScene
     bool isRunning();
     bool isReadOnly();
     bool showExpressionIds();
+    bool showExpressionDurations();
     bool animationsEnabled();
     bool embeddedMathEnabled();
 
@@ -69,10 +74,16 @@ class Worksheet : public QGraphicsScene
     void stopAnimations();
     void resumeAnimations();
 
+    // budget for the decoded frames of the animation results
+    bool reserveAnimationCache(qint64 bytes);
+    void releaseAnimationCache(qint64 bytes);
+
     void makeVisible(WorksheetEntry*);
     void makeVisible(const WorksheetCursor&);
 
     void setModified();
+    // an expression was evaluated, the session state differs from its snapshot
+    void setSessionStateModified();
 
     void startDrag(WorksheetEntry*, QDrag*);
     void startDragWithHierarchy(HierarchyEntry*, QDrag*, QSizeF responsibleZoneSize);
@@ -82,9 +93,12 @@ class Worksheet : public QGraphicsScene
     void populateMenu(QMenu*, QPointF);
     Cantor::Renderer* renderer();
     MathRenderer* mathRenderer();
+    Cantor::ImageCache* imageCache();
     bool isEmpty();
     bool isLoadingFromFile();
 
+    QVector<EntryDependencies::Node> entryDependencies(QVector<CommandEntry*>& entries);
+
     WorksheetEntry* currentEntry();
     WorksheetEntry* firstEntry();
     WorksheetEntry* lastEntry();
@@ -175,6 +189,7 @@ class Worksheet : public QGraphicsScene
     void focusEntry(WorksheetEntry*);
 
     void evaluate();
+    int evaluateChangedEntries();
     void evaluateCurrentEntry();
     void interrupt();
     void interruptCurrentEntryEvaluation();
@@ -188,6 +203,7 @@ class Worksheet : public QGraphicsScene
     void enableHighlighting(bool);
     void enableCompletion(bool);
     void enableExpressionNumbering(bool);
+    void enableExpressionDurations(bool);
     void enableAnimations(bool);
     void enableEmbeddedMath(bool);
 
@@ -198,6 +214,7 @@ class Worksheet : public QGraphicsScene
     QByteArray saveToByteArray();
     void savePlain(const QString&);
     void saveLatex(const QString&);
+    void saveTimingTrace(const QString&);
     bool load(QIODevice*);
     void load(QByteArray*);
     bool load(const QString&);
@@ -296,6 +313,7 @@ class Worksheet : public QGraphicsScene
     void selectionMoveDown();
 
     void animateEntryCursor();
+    void rerenderVisibleEntries();
 
   private:
     WorksheetEntry* entryAt(qreal x, qreal y);
@@ -309,6 +327,11 @@ class Worksheet : public QGraphicsScene
     bool loadJupyterNotebook(const QJsonDocument& doc);
     void showInvalidNotebookSchemeError(QString additionalInfo = QString());
     void initSession(Cantor::Backend*);
+    static QString sessionStateFileName(const QString& filename);
+    void saveSessionState(const QString& filename);
+    void prepareSessionStateRestore(const QString& filename);
+    void restoreSessionState();
+    void evaluatePipelined();
     void initActions();
     std::vector<WorksheetEntry*> hierarchySubelements(HierarchyEntry*) const;
 
@@ -334,6 +357,9 @@ class Worksheet : public QGraphicsScene
     PlaceHolderEntry* m_placeholderEntry{nullptr};
     WorksheetTextItem* m_lastFocusedTextItem{nullptr};
     QTimer* m_dragScrollTimer{nullptr};
+    QTimer* m_rerenderTimer;
+    QList<QPointer<WorksheetEntry>> m_rerenderEntries;
+    qint64 m_animationCacheSize{0};
 
     qreal m_viewWidth{0};
     QMap<QGraphicsObject*, qreal> m_itemWidths;
@@ -360,6 +386,7 @@ class Worksheet : public QGraphicsScene
     bool m_completionEnabled{false};
     bool m_embeddedMathEnabled{false};
     bool m_showExpressionIds{false};
+    bool m_showExpressionDurations{false};
     bool m_animationsEnabled{false};
 
     bool m_isPrinting{false};
@@ -371,6 +398,9 @@ class Worksheet : public QGraphicsScene
 
     QString m_backendName;
     QJsonObject* m_jupyterMetadata{nullptr};
+    QString m_sessionStateFile; // snapshot of the session state restored after the login
+    QString m_savedSessionStateFile; // snapshot matching the current session state
+    bool m_sessionStateModified{true};
 
     QVector<WorksheetEntry*> m_selectedEntries;
     QQueue<WorksheetEntry*> m_circularFocusBuffer;
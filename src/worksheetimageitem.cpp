@@ -32,6 +32,9 @@ int WorksheetImageItem::type() const
 
 bool WorksheetImageItem::imageIsValid()
 {
+    if (!m_imagePath.isEmpty())
+        return worksheet()->imageCache()->imageSize(m_imagePath).isValid();
+
     return !m_pixmap.isNull();
 }
 
@@ -72,6 +75,9 @@ void WorksheetImageItem::setSize(QSizeF size)
 
 QSize WorksheetImageItem::imageSize()
 {
+    if (!m_imagePath.isEmpty())
+        return worksheet()->imageCache()->imageSize(m_imagePath);
+
     return m_pixmap.size();
 }
 
@@ -86,6 +92,18 @@ void WorksheetImageItem::paint(QPainter *painter,
 {
     Q_UNUSED(option);
     Q_UNUSED(widget);
+    // images from files are only decoded when they are painted, in the resolution they are painted in
+    if (!m_imagePath.isEmpty())
+    {
+        const qreal scale = qAbs(painter->deviceTransform().m11()) * painter->device()->devicePixelRatioF();
+        const QSize& pixelSize = (m_size * scale).toSize();
+        if (pixelSize != m_requestedSize)
+        {
+            m_requestedSize = pixelSize;
+            requestImage();
+        }
+    }
+
     painter->drawPixmap(QRectF(QPointF(0,0), m_size), m_pixmap,
                         m_pixmap.rect());
     if (hasFocus())
@@ -97,24 +115,59 @@ void WorksheetImageItem::paint(QPainter *painter,
 
 void WorksheetImageItem::setEps(const QUrl& url)
 {
-    const QImage img = worksheet()->renderer()->renderToImage(url, Cantor::Renderer::EPS, &m_size);
+    m_imagePath.clear();
+    const QImage img = worksheet()->renderer()->renderToImage(url, Cantor::Renderer::methodForUrl(url), &m_size);
     m_pixmap = QPixmap::fromImage(img.convertToFormat(QImage::Format_ARGB32));
 }
 
 void WorksheetImageItem::setImage(QImage img)
 {
+    m_imagePath.clear();
     m_pixmap = QPixmap::fromImage(img);
     setSize(m_pixmap.size());
 }
 
 void WorksheetImageItem::setImage(QImage img, QSize displaySize)
 {
+    m_imagePath.clear();
     m_pixmap = QPixmap::fromImage(img);
     setSize(displaySize);
 }
 
+/*!
+ * shows the image in the file @p path. The image is not decoded in its full resolution
+ * but in the resolution it is displayed in, in the thread pool via the image cache of the worksheet.
+ * If @p displaySize is not valid, the image is displayed in its original size.
+ */
+void WorksheetImageItem::setImageFile(const QString& path, QSizeF displaySize)
+{
+    auto* cache = worksheet()->imageCache();
+    const QSize& size = cache->imageSize(path);
+    if (!size.isValid())
+    {
+        // the size is not known without decoding the image, load it completely
+        const QImage img(path);
+        if (displaySize.isValid())
+            setImage(img, displaySize.toSize());
+        else
+            setImage(img);
+        return;
+    }
+
+    if (path != m_imagePath)
+    {
+        m_pixmap = QPixmap();
+        m_imageKey = 0;
+        m_requestedSize = QSize();
+    }
+    m_imagePath = path;
+    connect(cache, &Cantor::ImageCache::imageReady, this, &WorksheetImageItem::imageReady, Qt::UniqueConnection);
+    setSize(displaySize.isValid() ? displaySize : QSizeF(size));
+}
+
 void WorksheetImageItem::setPixmap(QPixmap pixmap)
 {
+    m_imagePath.clear();
     m_pixmap = pixmap;
 }
 
@@ -123,6 +176,40 @@ QPixmap WorksheetImageItem::pixmap() const
     return m_pixmap;
 }
 
+/*!
+ * returns the image in its original resolution, the displayed pixmap might be scaled down
+ */
+QImage WorksheetImageItem::image() const
+{
+    if (!m_imagePath.isEmpty())
+        return Cantor::ImageCache::instance()->cachedImage(m_imagePath, QSize());
+
+    return m_pixmap.toImage();
+}
+
+void WorksheetImageItem::requestImage()
+{
+    auto* cache = worksheet()->imageCache();
+    QImage img;
+    if (worksheet()->isPrinting())
+        img = cache->decodedImage(m_imagePath, m_requestedSize);
+    else
+        img = cache->image(m_imagePath, m_requestedSize);
+
+    if (img.isNull() || img.cacheKey() == m_imageKey)
+        return;
+
+    m_imageKey = img.cacheKey();
+    m_pixmap = QPixmap::fromImage(img);
+    update();
+}
+
+void WorksheetImageItem::imageReady(const QString& path)
+{
+    if (path == m_imagePath)
+        requestImage();
+}
+
 void WorksheetImageItem::populateMenu(QMenu* menu, QPointF pos)
 {
     emit menuCreated(menu, mapToParent(pos));
@@ -43,8 +43,10 @@ class WorksheetImageItem : public QGraphicsObject
     void setEps(const QUrl &url);
     void setImage(QImage img);
     void setImage(QImage img, QSize displaySize);
+    void setImageFile(const QString& path, QSizeF displaySize = QSizeF());
     void setPixmap(QPixmap pixmap);
     QPixmap pixmap() const;
+    QImage image() const;
 
     virtual void populateMenu(QMenu* menu, QPointF pos);
     Worksheet* worksheet();
@@ -56,9 +58,18 @@ class WorksheetImageItem : public QGraphicsObject
   protected:
     void contextMenuEvent(QGraphicsSceneContextMenuEvent*) override;
 
+  private Q_SLOTS:
+    void imageReady(const QString& path);
+
+  private:
+    void requestImage();
+
   private:
     QPixmap m_pixmap;
     QSizeF m_size;
+    QString m_imagePath; // set if the image is decoded from the file by the image cache of the worksheet
+    QSize m_requestedSize;
+    qint64 m_imageKey{0};
 };
 
 #endif //WORKSHEETIMAGEITEM_H
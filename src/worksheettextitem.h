@@ -88,9 +88,9 @@ class WorksheetTextItem : public QGraphicsTextItem
     void setFontFamily(const QString&);
     void setFontSize(int);
 
-    QTextCursor search(QString pattern,
-                       QTextDocument::FindFlags qt_flags,
-                       const WorksheetCursor& pos);
+    virtual QTextCursor search(QString pattern,
+                               QTextDocument::FindFlags qt_flags,
+                               const WorksheetCursor& pos);
 
     DoubleClickEventBehaviour doubleClickBehaviour();
     void setDoubleClickBehaviour(DoubleClickEventBehaviour);